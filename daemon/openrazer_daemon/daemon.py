@@ -7,12 +7,15 @@ This class is the main core of the daemon, this serves a basic dbus module to co
 """
 __version__ = '3.6.1'
 
+import concurrent.futures
 import configparser
 import logging
 import logging.handlers
 import os
 import sys
 import signal
+import tempfile
+import threading
 import time
 import setproctitle
 import dbus.mainloop.glib
@@ -22,13 +25,35 @@ from pyudev import Context, Monitor, MonitorObserver
 import grp
 import getpass
 import json
-import threading
 
 import openrazer_daemon.hardware
 from openrazer_daemon.dbus_services.service import DBusService
 from openrazer_daemon.device import DeviceCollection
 from openrazer_daemon.misc.screensaver_monitor import ScreensaverMonitor
 from openrazer_daemon.misc.autosave_persistence import PersistenceAutoSave
+from openrazer_daemon.misc.batch import Batch
+from openrazer_daemon.misc.reactor import stop_reactor
+
+# Devices built at once at startup
+MAX_PARALLEL_DEVICE_LOADS = 8
+
+# Seconds to wait for every device to suspend or resume
+SUSPEND_TIMEOUT = 10
+
+# Batches run at once, each waits on the workers of its devices
+MAX_PARALLEL_BATCHES = 4
+
+# Seconds to wait for the operations of a batch
+BATCH_TIMEOUT = 10
+
+# Seconds to wait for the devices to describe themselves
+DESCRIPTOR_TIMEOUT = 5
+
+# Seconds to wait for calls in progress on a removed device before closing it anyway
+REMOVE_TIMEOUT = 2
+
+# Seconds from the first change of device state to writing the persistence file
+PERSISTENCE_SAVE_DELAY = 5
 
 
 class RazerDaemon(DBusService):
@@ -87,7 +112,11 @@ class RazerDaemon(DBusService):
 
         self._persistence_file = persistence_file
         self._persistence = configparser.ConfigParser()
-        self._persistence.status = {"changed": False}
+        # Held while the persistence config is updated and written, writes come from the
+        # autosave thread, hotplug and shutdown
+        self._persistence_lock = threading.Lock()
+        self._autosave_persistence = PersistenceAutoSave(persistence_file, self.logger, PERSISTENCE_SAVE_DELAY, self.write_persistence)
+        self._persistence.autosave = self._autosave_persistence
         self.read_persistence(persistence_file)
 
         # Check for plugdev group
@@ -107,8 +136,8 @@ class RazerDaemon(DBusService):
         # Listen for input events from udev
         self._init_udev_monitor()
 
-        # Load Classes
-        self._device_classes = openrazer_daemon.hardware.get_device_classes()
+        # Index the device classes, their modules are imported when a device shows up
+        self._device_registry = openrazer_daemon.hardware.DeviceRegistry()
 
         self.logger.info("Initialising Daemon (v%s). Pid: %d", __version__, os.getpid())
         self._init_screensaver_monitor()
@@ -116,10 +145,17 @@ class RazerDaemon(DBusService):
         self._razer_devices = DeviceCollection()
         self._load_devices(first_run=True)
 
+        # Hotplug events are handled one at a time, off the udev monitor thread
+        self._hotplug_executor = concurrent.futures.ThreadPoolExecutor(max_workers=1, thread_name_prefix='razer-hotplug')
+
+        # Batches and descriptor requests wait for their devices here rather than on the main loop
+        self._batch_executor = concurrent.futures.ThreadPoolExecutor(max_workers=MAX_PARALLEL_BATCHES, thread_name_prefix='razer-batch')
+
         # Add DBus methods
         methods = {
             # interface, method, callback, in-args, out-args
             ('razer.devices', 'getDevices', self.get_serial_list, None, 'as'),
+            ('razer.devices', 'getDeviceDescriptors', self.get_device_descriptors, None, 'a{sa{sv}}'),
             ('razer.devices', 'supportedDevices', self.supported_devices, None, 's'),
             ('razer.devices', 'enableTurnOffOnScreensaver', self.enable_turn_off_on_screensaver, 'b', None),
             ('razer.devices', 'getOffOnScreensaver', self.get_off_on_screensaver, None, 'b'),
@@ -133,10 +169,8 @@ class RazerDaemon(DBusService):
             self.logger.debug("Adding {}.{} method to DBus".format(m[0], m[1]))
             self.add_dbus_method(m[0], m[1], m[2], in_signature=m[3], out_signature=m[4])
 
-        self._collecting_udev = False
-        self._collecting_udev_devices = []
-
-        self._init_autosave_persistence()
+        # Byte arrays in the operations stay bytes, like setKeyRow takes them
+        self.add_dbus_method('razer.devices', 'applyBatch', self.apply_batch, in_signature='a(sssav)', out_signature='a(bsav)', byte_arrays=True)
 
         # TODO remove
         self.sync_effects(self._config.getboolean('Startup', 'sync_effects_enabled'))
@@ -212,16 +246,6 @@ class RazerDaemon(DBusService):
         except dbus.exceptions.DBusException as e:
             self.logger.error("Failed to init ScreensaverMonitor: {}".format(e))
 
-    def _init_autosave_persistence(self):
-        if not self._persistence:
-            self.logger.debug("Persistence unspecified. Will not create auto save thread")
-            return
-
-        self._autosave_persistence = PersistenceAutoSave(self._persistence, self._persistence_file, self._persistence.status, self.logger, 10, self.write_persistence)
-        self._autosave_persistence.thread = threading.Thread(target=self._autosave_persistence.watch)
-        self._autosave_persistence.thread.daemon = True
-        self._autosave_persistence.thread.start()
-
     def _init_signals(self):
         """
         Heinous hack to properly handle signals on the mainloop. Necessary
@@ -309,42 +333,92 @@ class RazerDaemon(DBusService):
                 with open(persistence_file, "w") as f:
                     f.writelines("")
 
-    def write_persistence(self, persistence_file):
+    def write_persistence(self, persistence_file, changed=None):
         """
         Write in the persistence file
 
+        The file is written to a temporary file next to it which then replaces it, so a crash
+        mid-write leaves the previous file intact. Writes are serialised, and as this blocks
+        on the disk it's never called on the reactor.
+
         :param persistence_file: Persistence file
         :type persistence_file: str or None
+
+        :param changed: Storage names of the devices to update, with their changed zones. None
+                        changes a device's DPI and poll rate. Every device is updated if not given
+        :type changed: dict or None
+
+        :raises OSError: If the file couldn't be written
         """
         if not persistence_file:
             return
 
+        with self._persistence_lock:
+            self._write_persistence(persistence_file, changed)
+
+    def _write_persistence(self, persistence_file, changed):
         self.logger.debug('Writing persistence config')
 
-        for device in self._razer_devices:
-            self._persistence[device.dbus.storage_name] = {}
-            if 'set_dpi_xy' in device.dbus.METHODS or 'set_dpi_xy_byte' in device.dbus.METHODS:
-                dpi_x = int(device.dbus.dpi[0])
-                dpi_y = int(device.dbus.dpi[1])
-                # When Y is not greater than 0 check for a DPI X only device, a device with 'available_dpi' and a Y value of 0
-                if dpi_x > 0 and (dpi_y > 0 or ('available_dpi' in device.dbus.METHODS and dpi_y == 0)):
-                    self._persistence[device.dbus.storage_name]['dpi_x'] = str(dpi_x)
-                    self._persistence[device.dbus.storage_name]['dpi_y'] = str(dpi_y)
-
-            if 'set_poll_rate' in device.dbus.METHODS:
-                self._persistence[device.dbus.storage_name]['poll_rate'] = str(device.dbus.poll_rate)
+        for device in self._razer_devices.devices:
+            storage_name = device.dbus.storage_name
+            if changed is not None and storage_name not in changed:
+                continue
+            zones = changed[storage_name] if changed is not None else None
+
+            # A device new to the file is written whole
+            if zones is None or not self._persistence.has_section(storage_name):
+                zones = None
+                self._persistence[storage_name] = {}
+            section = self._persistence[storage_name]
+
+            if zones is None or None in zones:
+                if 'set_dpi_xy' in device.dbus.METHODS or 'set_dpi_xy_byte' in device.dbus.METHODS:
+                    dpi_x = int(device.dbus.dpi[0])
+                    dpi_y = int(device.dbus.dpi[1])
+                    # When Y is not greater than 0 check for a DPI X only device, a device with 'available_dpi' and a Y value of 0
+                    if dpi_x > 0 and (dpi_y > 0 or ('available_dpi' in device.dbus.METHODS and dpi_y == 0)):
+                        section['dpi_x'] = str(dpi_x)
+                        section['dpi_y'] = str(dpi_y)
+
+                if 'set_poll_rate' in device.dbus.METHODS:
+                    section['poll_rate'] = str(device.dbus.poll_rate)
 
             for i in device.dbus.ZONES:
-                if device.dbus.zone[i]["present"]:
-                    self._persistence[device.dbus.storage_name][i + '_active'] = str(device.dbus.zone[i]["active"])
-                    self._persistence[device.dbus.storage_name][i + '_brightness'] = str(device.dbus.zone[i]["brightness"])
-                    self._persistence[device.dbus.storage_name][i + '_effect'] = device.dbus.zone[i]["effect"]
-                    self._persistence[device.dbus.storage_name][i + '_colors'] = ' '.join(str(i) for i in device.dbus.zone[i]["colors"])
-                    self._persistence[device.dbus.storage_name][i + '_speed'] = str(device.dbus.zone[i]["speed"])
-                    self._persistence[device.dbus.storage_name][i + '_wave_dir'] = str(device.dbus.zone[i]["wave_dir"])
+                if device.dbus.zone[i]["present"] and (zones is None or i in zones):
+                    section[i + '_active'] = str(device.dbus.zone[i]["active"])
+                    section[i + '_brightness'] = str(device.dbus.zone[i]["brightness"])
+                    section[i + '_effect'] = device.dbus.zone[i]["effect"]
+                    section[i + '_colors'] = ' '.join(str(i) for i in device.dbus.zone[i]["colors"])
+                    section[i + '_speed'] = str(device.dbus.zone[i]["speed"])
+                    section[i + '_wave_dir'] = str(device.dbus.zone[i]["wave_dir"])
+
+        persistence_dir, persistence_name = os.path.split(os.path.abspath(persistence_file))
+        temp_fd, temp_file = tempfile.mkstemp(prefix=persistence_name + '.', suffix='.tmp', dir=persistence_dir)
+        try:
+            with open(temp_fd, 'w') as cf:
+                # mkstemp makes the file private, keep the mode the file had
+                try:
+                    os.fchmod(cf.fileno(), os.stat(persistence_file).st_mode & 0o777)
+                except FileNotFoundError:
+                    pass
+
+                self._persistence.write(cf)
+                cf.flush()
+                os.fsync(cf.fileno())
+            os.replace(temp_file, persistence_file)
+        except BaseException:
+            try:
+                os.unlink(temp_file)
+            except FileNotFoundError:
+                pass
+            raise
 
-        with open(persistence_file, 'w') as cf:
-            self._persistence.write(cf)
+        # Make the rename itself durable
+        dir_fd = os.open(persistence_dir, os.O_RDONLY | os.O_DIRECTORY)
+        try:
+            os.fsync(dir_fd)
+        finally:
+            os.close(dir_fd)
 
     def get_off_on_screensaver(self):
         """
@@ -362,7 +436,7 @@ class RazerDaemon(DBusService):
         self._screensaver_monitor.monitoring = enable
 
     def supported_devices(self):
-        result = {cls.__name__: (cls.USB_VID, cls.USB_PID) for cls in self._device_classes}
+        result = self._device_registry.class_names()
 
         return json.dumps(result)
 
@@ -379,15 +453,16 @@ class RazerDaemon(DBusService):
         """
         Suspend all devices
         """
-        for device in self._razer_devices:
-            device.dbus.suspend_device()
+        self._razer_devices.run_all('Suspend', lambda device: device.dbus.suspend_device(), SUSPEND_TIMEOUT)
+
+        # The session might not come back, don't leave changes waiting on the timer
+        self._autosave_persistence.flush()
 
     def resume_devices(self):
         """
         Resume all devices
         """
-        for device in self._razer_devices:
-            device.dbus.resume_device()
+        self._razer_devices.run_all('Resume', lambda device: device.dbus.resume_device(), SUSPEND_TIMEOUT)
 
     def get_serial_list(self):
         """
@@ -397,6 +472,26 @@ class RazerDaemon(DBusService):
         self.logger.debug('DBus called get_serial_list')
         return serial_list
 
+    def get_device_descriptors(self):
+        """
+        Describe every device, so clients can list them in one call
+
+        Devices describe themselves at the same time. A device that fails to gets an empty
+        descriptor, and clients ask it directly.
+
+        :return: Serial to descriptor
+        :rtype: dict
+        """
+        descriptors = {serial: {} for serial in self._razer_devices.serials()}
+
+        def describe(device):
+            descriptors[device.serial] = device.dbus.get_descriptor()
+
+        self._razer_devices.run('Describe', self._razer_devices.devices, describe, DESCRIPTOR_TIMEOUT)
+        self.logger.debug('DBus called get_device_descriptors')
+
+        return descriptors
+
     def sync_effects(self, enabled):
         """
         Sync the effects across the devices
@@ -422,135 +517,241 @@ class RazerDaemon(DBusService):
 
         return result
 
+    def apply_batch(self, operations):
+        """
+        Run calls to several devices at once
+
+        The operations of a device run in order, different devices run at the same time.
+
+        :param operations: (serial, interface, method, arguments) tuples
+        :type operations: list of tuple
+
+        :return: (success, error, return values) for each operation, in the same order
+        :rtype: list of tuple
+        """
+        batch = Batch(self._razer_devices, operations, self.logger)
+        self.logger.debug("DBus call apply_batch with %d operations", len(operations))
+
+        return batch.run(BATCH_TIMEOUT)
+
+    def dispatch_call(self, function_name, call):
+        """
+        Run a DBus call to the daemon
+
+        Methods that wait on the device workers run off the main loop.
+
+        :param function_name: DBus function name
+        :type function_name: str
+
+        :param call: Runs the method and replies
+        :type call: callable
+        """
+        if function_name in ('applyBatch', 'getDeviceDescriptors'):
+            self._batch_executor.submit(call)
+        else:
+            call()
+
     def _load_devices(self, first_run=False):
         """
         Go through supported devices and load them
 
         Loops through the available hardware classes, loops through
         each device in the system and adds it if needs be.
+
+        Devices are found first, then built concurrently as every device spends most of its
+        setup waiting on USB. They're registered on DBus in the order they were found.
         """
+        start = time.monotonic()
+
         if first_run:
             # Just some pretty output
-            max_name_len = max([len(cls.__name__) for cls in self._device_classes]) + 2
-            for cls in self._device_classes:
+            class_names = sorted(self._device_registry.class_names().items())
+            max_name_len = max([len(class_name) for class_name, _ in class_names]) + 2
+            for class_name, (usb_vid, usb_pid) in class_names:
                 format_str = 'Loaded device specification: {0:-<' + str(max_name_len) + '} ({1:04x}:{2:04X})'
 
-                self.logger.debug(format_str.format(cls.__name__ + ' ', cls.USB_VID, cls.USB_PID))
+                self.logger.debug(format_str.format(class_name + ' ', usb_vid, usb_pid))
 
         if self._test_dir is not None:
-            device_list = os.listdir(self._test_dir)
+            device_list = [(sys_name, os.path.join(self._test_dir, sys_name)) for sys_name in os.listdir(self._test_dir)]
             test_mode = True
         else:
-            device_list = list(self._udev_context.list_devices(subsystem='hid'))
+            device_list = [(device.sys_name, device.sys_path) for device in self._udev_context.list_devices(subsystem='hid')]
             test_mode = False
 
-        device_number = 0
-        for device in device_list:
+        # Only nodes of supported devices are looked at any further, grouped by USB device
+        candidates = []
+        interfaces = {}
+        for sys_name, sys_path in device_list:
+            device_class = self._device_registry.get(openrazer_daemon.hardware.parse_hid_sys_name(sys_name))
+            if device_class is not None:
+                candidates.append((device_class, sys_name, sys_path))
+                interfaces.setdefault(sys_name.split('.')[0], []).append((sys_name, sys_path))
 
-            for device_class in self._device_classes:
-                # Interoperability between generic list of 0000:0000:0000.0000 and pyudev
-                if test_mode:
-                    sys_name = device
-                    sys_path = os.path.join(self._test_dir, device)
-                else:
-                    sys_name = device.sys_name
-                    sys_path = device.sys_path
+        found = []
+        device_number = len(self._razer_devices)
+        for device_class, sys_name, sys_path in candidates:
+            if sys_name in self._razer_devices:
+                continue
 
-                if sys_name in self._razer_devices:
-                    continue
+            if device_class.match(sys_name, sys_path):  # Check it matches sys/ ID format and has device_type file
+                self.logger.info('Found device.%d: %s', device_number, sys_name)
 
-                if device_class.match(sys_name, sys_path):  # Check it matches sys/ ID format and has device_type file
-                    self.logger.info('Found device.%d: %s', device_number, sys_name)
-
-                    # TODO add testdir support
-                    # Basically find the other usb interfaces
-                    device_match = sys_name.split('.')[0]
-                    additional_interfaces = []
-                    if not test_mode:
-                        double_device = False
-                        for alt_device in self._razer_devices:
-                            if device_match in alt_device.device_id and alt_device.device_id != sys_name and sys_path in alt_device.dbus.additional_interfaces:
-                                self.logger.warning('BUG: Device %s has already been found with interface %s. Skipping', sys_name, alt_device.device_id)
-                                double_device = True
-                        if double_device:
-                            continue
-
-                        for alt_device in device_list:
-                            if device_match in alt_device.sys_name and alt_device.sys_name != sys_name:
-                                additional_interfaces.append(alt_device.sys_path)
-
-                    # Checking permissions
-                    test_file = os.path.join(sys_path, 'device_type')
-                    file_group_id = os.stat(test_file).st_gid
-                    file_group_name = grp.getgrgid(file_group_id)[0]
-
-                    if os.getgid() != file_group_id and file_group_name != 'plugdev':
-                        self.logger.critical("Could not access {0}/device_type, file is not owned by plugdev".format(sys_path))
-                        break
-
-                    razer_device = device_class(device_path=sys_path, device_number=device_number, config=self._config,
-                                                persistence=self._persistence, testing=self._test_dir is not None,
-                                                additional_interfaces=sorted(additional_interfaces),
-                                                additional_methods=[])
-
-                    # Wireless devices sometimes don't listen
-                    count = 0
-                    while count < 3:
-                        # Loop to get serial, exit early if it gets one
-                        device_serial = razer_device.get_serial()
-                        if len(device_serial) > 0:
-                            break
-                        time.sleep(0.1)
-                        count += 1
-                    else:
-                        logging.warning("Could not get serial for device {0}. Skipping".format(sys_name))
+                # TODO add testdir support
+                # Basically find the other usb interfaces
+                device_match = sys_name.split('.')[0]
+                additional_interfaces = []
+                if not test_mode:
+                    double_device = False
+                    for alt_device in self._razer_devices:
+                        if device_match in alt_device.device_id and alt_device.device_id != sys_name and sys_path in alt_device.dbus.additional_interfaces:
+                            self.logger.warning('BUG: Device %s has already been found with interface %s. Skipping', sys_name, alt_device.device_id)
+                            double_device = True
+                    if double_device:
                         continue
 
-                    self._razer_devices.add(sys_name, device_serial, razer_device)
+                    additional_interfaces = [alt_path for alt_name, alt_path in interfaces[device_match] if alt_name != sys_name]
+
+                if not self._check_device_access(sys_path):
+                    continue
+
+                found.append((device_class, sys_name, sys_path, device_number, sorted(additional_interfaces)))
+                device_number += 1
 
-                    device_number += 1
+        if not found:
+            return
+
+        with concurrent.futures.ThreadPoolExecutor(max_workers=min(MAX_PARALLEL_DEVICE_LOADS, len(found)), thread_name_prefix='razer-load') as executor:
+            futures = [executor.submit(self._create_device, *args) for args in found]
+
+            # Register in the order the devices were found, whatever order they finish in
+            for future in futures:
+                self._register_device(future.result(), start)
+
+    def _check_device_access(self, sys_path):
+        """
+        Check the driver files are owned by plugdev
+
+        :param sys_path: Device's sysfs path
+        :type sys_path: str
+
+        :return: True if the daemon can use them
+        :rtype: bool
+        """
+        test_file = os.path.join(sys_path, 'device_type')
+        file_group_id = os.stat(test_file).st_gid
+        file_group_name = grp.getgrgid(file_group_id)[0]
+
+        if os.getgid() != file_group_id and file_group_name != 'plugdev':
+            self.logger.critical("Could not access {0}/device_type, file is not owned by plugdev".format(sys_path))
+            return False
+
+        return True
+
+    def _create_device(self, device_class, sys_name, sys_path, device_number, additional_interfaces):
+        """
+        Build a device and get its serial, without registering it on DBus
+
+        Safe to run on several devices at once.
 
-    def _add_device(self, device):
+        :return: Device class, sys name, DBus object and serial, or None if the device failed
+        :rtype: tuple or None
+        """
+        try:
+            razer_device = device_class(device_path=sys_path, device_number=device_number, config=self._config,
+                                        persistence=self._persistence, testing=self._test_dir is not None,
+                                        additional_interfaces=additional_interfaces,
+                                        additional_methods=[], register=False)
+        except Exception:
+            self.logger.exception("Failed to set up device %s", sys_name)
+            return None
+
+        # Wireless devices sometimes don't listen
+        count = 0
+        while count < 3:
+            # Loop to get serial, exit early if it gets one
+            device_serial = razer_device.get_serial()
+            if len(device_serial) > 0:
+                break
+            time.sleep(0.1)
+            count += 1
+        else:
+            logging.warning("Could not get serial for device {0}. Skipping".format(sys_name))
+            razer_device.close()
+            return None
+
+        return sys_name, razer_device, device_serial
+
+    def _register_device(self, created, start):
+        """
+        Register a device built by _create_device() on DBus and add it
+
+        :param created: Return value of _create_device()
+        :type created: tuple or None
+
+        :param start: time.monotonic() when the device was first noticed
+        :type start: float
+
+        :return: True if a device was added
+        :rtype: bool
+        """
+        if created is None:
+            return False
+
+        sys_name, razer_device, device_serial = created
+
+        razer_device.register_object()
+        self._razer_devices.add(sys_name, device_serial, razer_device)
+
+        self.logger.info("Device %s ready in %.0fms", sys_name, (time.monotonic() - start) * 1000)
+        return True
+
+    def _add_device(self, device, start):
         """
         Add device event from udev
 
         :param device: Udev Device
         :type device: pyudev.device._device.Device
+
+        :param start: time.monotonic() when the event arrived
+        :type start: float
         """
-        device_number = len(self._razer_devices)
-        for device_class in self._device_classes:
-            sys_name = device.sys_name
-            sys_path = device.sys_path
+        sys_name = device.sys_name
+        sys_path = device.sys_path
 
-            if sys_name in self._razer_devices:
-                continue
+        if sys_name in self._razer_devices:
+            return
 
-            if device_class.match(sys_name, sys_path):  # Check it matches sys/ ID format and has device_type file
-                self.logger.info('Found valid device.%d: %s', device_number, sys_name)
-                razer_device = device_class(device_path=sys_path, device_number=device_number, config=self._config,
-                                            persistence=self._persistence, testing=self._test_dir is not None,
-                                            additional_interfaces=None, additional_methods=[])
-
-                # Its a udev event so currently the device hasn't been chmodded yet
-                time.sleep(0.2)
-
-                # Wireless devices sometimes don't listen
-                device_serial = razer_device.get_serial()
-
-                if len(device_serial) > 0:
-                    # Add Device
-                    self._razer_devices.add(sys_name, device_serial, razer_device)
-                    self.device_added()
-                else:
-                    logging.warning("Could not get serial for device {0}. Skipping".format(sys_name))
-            else:
-                # Basically find the other usb interfaces
-                device_match = sys_name.split('.')[0]
-                for d in self._razer_devices:
-                    if device_match in d.device_id and d.device_id != sys_name:
-                        if not sys_path in d.dbus.additional_interfaces:
-                            d.dbus.additional_interfaces.append(sys_path)
-                            return
+        device_class = self._device_registry.get(openrazer_daemon.hardware.parse_hid_sys_name(sys_name))
+        if device_class is None:
+            return
+
+        if device_class.match(sys_name, sys_path):  # Check it matches sys/ ID format and has device_type file
+            # The add event can come before the driver is bound and razer_mount has handed the files
+            # to plugdev, the udev rule runs it again for the bind event so that one finds them readable
+            if not os.access(os.path.join(sys_path, 'device_type'), os.R_OK):
+                self.logger.debug("Device %s isn't accessible yet", sys_name)
+                return
+
+            # Basically find the other usb interfaces, whichever order their events came in
+            device_match = sys_name.split('.')[0]
+            additional_interfaces = sorted(alt_device.sys_path for alt_device in self._udev_context.list_devices(subsystem='hid')
+                                           if alt_device.sys_name.startswith(device_match + '.') and alt_device.sys_name != sys_name)
+
+            device_number = len(self._razer_devices)
+            self.logger.info('Found valid device.%d: %s', device_number, sys_name)
+
+            if self._register_device(self._create_device(device_class, sys_name, sys_path, device_number, additional_interfaces), start):
+                self.device_added()
+            return
+
+        # Basically find the other usb interfaces
+        device_match = sys_name.split('.')[0]
+        for d in self._razer_devices:
+            if device_match in d.device_id and d.device_id != sys_name:
+                if not sys_path in d.dbus.additional_interfaces:
+                    d.dbus.additional_interfaces.append(sys_path)
+                    return
 
     def _remove_device(self, device):
         """
@@ -564,9 +765,13 @@ class RazerDaemon(DBusService):
         try:
             device = self._razer_devices[device_id]
 
-            device.dbus.close()
+            # Behind the calls already queued for it, rather than in the middle of one
+            self._razer_devices.run('Close', [device], lambda dev: dev.dbus.close(), REMOVE_TIMEOUT)
             device.dbus.remove_from_connection()
-            self.write_persistence(self._persistence_file)
+            try:
+                self.write_persistence(self._persistence_file)
+            except (OSError, RuntimeError) as err:
+                self.logger.warning("Failed to write persistence config: %s", err)
             self.logger.warning("Removing %s", device_id)
 
             # Delete device
@@ -585,25 +790,27 @@ class RazerDaemon(DBusService):
         :type device: pyudev.device._device.Device
         """
         self.logger.debug('Device event [%s]: %s', device.action, device.device_path)
-        if device.action == 'add':
-            if self._collecting_udev:
-                self._collecting_udev_devices.append(device)
-                return
-            else:
-                self._collecting_udev_devices = [device]
-                self._collecting_udev = True
-                t = threading.Thread(target=self._collecting_udev_method, args=(device,))
-                t.start()
-        elif device.action == 'remove':
-            self._remove_device(device)
-
-    def _collecting_udev_method(self, device):
-        time.sleep(2)  # delay to let udev add all devices that we want
-        # Sort the devices
-        self._collecting_udev_devices.sort(key=lambda x: x.sys_path, reverse=True)
-        for d in self._collecting_udev_devices:
-            self._add_device(d)
-        self._collecting_udev = False
+        self._hotplug_executor.submit(self._handle_udev_event, device, time.monotonic())
+
+    def _handle_udev_event(self, device, start):
+        """
+        Add or remove a device, on the hotplug thread
+
+        :param device: Udev device
+        :type device: pyudev.device._device.Device
+
+        :param start: time.monotonic() when the event arrived
+        :type start: float
+        """
+        try:
+            # The driver files exist once our driver is bound, which is either
+            # the add event or a bind event when the device is rebound to it
+            if device.action in ('add', 'bind'):
+                self._add_device(device, start)
+            elif device.action == 'remove':
+                self._remove_device(device)
+        except Exception:
+            self.logger.exception("Failed to handle %s event for %s", device.action, device.sys_name)
 
     def run(self):
         """
@@ -640,9 +847,19 @@ class RazerDaemon(DBusService):
 
         # Stop udev monitor
         self._udev_observer.send_stop()
+        self._hotplug_executor.shutdown(wait=False)
+        self._batch_executor.shutdown(wait=False)
 
         for device in self._razer_devices:
             device.dbus.close()
+        self._razer_devices.close()
 
-        # Write config
-        self.write_persistence(self._persistence_file)
+        # Devices are closed so nothing is left on the reactor
+        stop_reactor()
+
+        # Write config, this covers changes still waiting on the autosave timer
+        self._autosave_persistence.close()
+        try:
+            self.write_persistence(self._persistence_file)
+        except (OSError, RuntimeError) as err:
+            self.logger.warning("Failed to write persistence config: %s", err)
@@ -40,9 +40,9 @@ def version(self):
 
     driver_path = self.get_driver_path('version')
 
-    driver_version = '0.0.0'
+    driver_version = self.get_driver_state('version') or '0.0.0'
 
-    if os.path.exists(driver_path):
+    if driver_version == '0.0.0' and os.path.exists(driver_path):
         # Check it exists, as people might not have reloaded driver
         with open(driver_path, 'r') as driver_file:
             driver_version = driver_file.read().strip()
@@ -79,6 +79,10 @@ def get_device_name(self):
 
     driver_path = self.get_driver_path('device_type')
 
+    cached = self.get_driver_state('device_type')
+    if cached is not None:
+        return cached
+
     with open(driver_path, 'r') as driver_file:
         return driver_file.read().strip()
 
@@ -4,6 +4,7 @@
 BlackWidow Chroma Effects
 """
 import os
+import dbus
 from openrazer_daemon.dbus_services import endpoint
 
 
@@ -30,8 +31,6 @@ def set_brightness(self, brightness):
     """
     self.logger.debug("DBus call set_brightness")
 
-    driver_path = self.get_driver_path('matrix_brightness')
-
     self.method_args['brightness'] = brightness
 
     if brightness > 100:
@@ -43,8 +42,7 @@ def set_brightness(self, brightness):
 
     brightness = int(round(brightness * (255.0 / 100.0)))
 
-    with open(driver_path, 'w') as driver_file:
-        driver_file.write(str(brightness))
+    self.write_driver_file('matrix_brightness', str(brightness))
 
     # Notify others
     self.send_effect_event('setBrightness', brightness)
@@ -85,7 +83,7 @@ def set_game_mode(self, enable):
     alt_tab = self.get_driver_path('key_alt_tab')
     alt_f4 = self.get_driver_path('key_alt_f4')
 
-    if os.path.exists(super_file):
+    if self.has_driver_file('key_super'):
         if enable:
             open(super_file, 'wb').write(b'\x01')
             open(alt_tab, 'wb').write(b'\x01')
@@ -548,12 +546,7 @@ def set_custom_effect(self):
     # TODO uncomment
     # self.logger.debug("DBus call set_custom_effect")
 
-    driver_path = self.get_driver_path('matrix_effect_custom')
-
-    payload = b'1'
-
-    with open(driver_path, 'wb') as driver_file:
-        driver_file.write(payload)
+    self.commit_custom_frame()
 
 
 @endpoint('razer.device.lighting.chroma', 'setKeyRow', in_sig='ay', byte_arrays=True)
@@ -574,10 +567,30 @@ def set_key_row(self, payload):
     # TODO uncomment
     # self.logger.debug("DBus call set_key_row")
 
-    driver_path = self.get_driver_path('matrix_custom_frame')
+    self.write_custom_frame(payload)
 
-    with open(driver_path, 'wb') as driver_file:
-        driver_file.write(payload)
+
+@endpoint('razer.device.lighting.chroma', 'getFrameChannel', out_sig='hh')
+def get_frame_channel(self):
+    """
+    Get a shared memory channel to send custom frames through
+
+    Returns a memfd with a header and two frame buffers, and the write end of a pipe to write a
+    byte to once a frame is in place. The layout is described in misc/frame_channel.py. Asking
+    again replaces the previous channel.
+
+    :return: Frame memfd and signal fd
+    :rtype: tuple
+    """
+    self.logger.debug("DBus call get_frame_channel")
+
+    channel = self.open_frame_channel()
+
+    # UnixFd duplicates the fds, the daemon only keeps the mapping and the read end
+    result = (dbus.types.UnixFd(channel.memfd), dbus.types.UnixFd(channel.signal_fd))
+    channel.release_client_fds()
+
+    return result
 
 
 @endpoint('razer.device.lighting.custom', 'setRipple', in_sig='yyyd')
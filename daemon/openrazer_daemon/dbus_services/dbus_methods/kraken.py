@@ -16,8 +16,6 @@ def set_custom_kraken(self, rgbi):
     """
     self.logger.debug("DBus call set custom")
 
-    driver_path = self.get_driver_path('matrix_effect_custom')
-
     if len(rgbi) not in (3, 4):
         raise ValueError("List must be of 3 or 4 bytes")
 
@@ -33,5 +31,4 @@ def set_custom_kraken(self, rgbi):
         else:
             rgbi_list[index] = item
 
-    with open(driver_path, 'wb') as driver_file:
-        driver_file.write(bytes(rgbi_list))
+    self.write_driver_file('matrix_effect_custom', bytes(rgbi_list))
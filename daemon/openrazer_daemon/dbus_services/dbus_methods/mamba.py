@@ -199,8 +199,7 @@ def set_dpi_xy(self, dpi_x, dpi_y):
         if self.dpi[1] > self.DPI_MAX:
             self.dpi[1] = self.DPI_MAX
 
-    with open(driver_path, 'wb') as driver_file:
-        driver_file.write(dpi_bytes)
+    self.write_driver_file('dpi', dpi_bytes)
 
 
 @endpoint('razer.device.dpi', 'getDPI', out_sig='ai')
@@ -319,6 +318,8 @@ def set_poll_rate(self, rate):
 
     # remember poll rate
     self.poll_rate = rate
+    if not self._disable_persistence:
+        self.persistence.autosave.mark_changed(self.storage_name)
 
     with open(driver_path, 'w') as driver_file:
         driver_file.write(str(rate))
@@ -46,8 +46,7 @@ def set_dpi_xy_byte(self, dpi_x, dpi_y):
 
     dpi_bytes = struct.pack('>BB', dpi_x_scaled, dpi_y_scaled)
 
-    with open(driver_path, 'wb') as driver_file:
-        driver_file.write(dpi_bytes)
+    self.write_driver_file('dpi', dpi_bytes)
 
 
 @endpoint('razer.device.dpi', 'getDPI', out_sig='ai')
@@ -7,9 +7,39 @@ Service Object for DBus
 # Disable some pylint stuff
 # pylint: disable=no-member
 
+import inspect
+import threading
 import types
 import dbus
 import dbus.service
+from _dbus_bindings import DBUS_INTROSPECT_1_0_XML_DOCTYPE_DECL_NODE
+
+# Methods each class has had added, with what they were added from, so other instances of the
+# class don't copy and decorate them again
+_CLASS_METHODS = {}
+
+# Held while methods are added to or removed from a class, devices can be created on several
+# threads at once and the methods live on the class they share
+CLASS_METHODS_LOCK = threading.RLock()
+
+# Interfaces part of the introspection data of each class
+_INTROSPECTION_CACHE = {}
+
+# DBus types of the basic signatures, so values go into variants as the type a method returns
+DBUS_TYPES = {
+    'y': dbus.Byte,
+    'b': dbus.Boolean,
+    'n': dbus.Int16,
+    'q': dbus.UInt16,
+    'i': dbus.Int32,
+    'u': dbus.UInt32,
+    'x': dbus.Int64,
+    't': dbus.UInt64,
+    'd': dbus.Double,
+    's': dbus.String,
+    'o': dbus.ObjectPath,
+    'g': dbus.Signature,
+}
 
 
 def copy_func(function_reference, name=None):
@@ -31,6 +61,113 @@ def copy_func(function_reference, name=None):
         return types.FunctionType(function_reference.__code__, function_reference.__globals__, name or function_reference.func_name, function_reference.__defaults__, function_reference.__closure__)
 
 
+def reply_values(out_signature, result):
+    """
+    Turn what a method returned into the values of its reply, the same way dbus-python does
+
+    :param out_signature: DBus return signature
+    :type out_signature: str or None
+
+    :param result: Returned value
+    :type result: object
+
+    :return: Reply values
+    :rtype: tuple
+
+    :raises TypeError: If a method without return values returned something
+    """
+    if out_signature is not None:
+        signature = tuple(dbus.Signature(out_signature))
+        if not signature:
+            if result is not None:
+                raise TypeError("Method with empty output signature returned a value: " + repr(result))
+            return ()
+        if len(signature) == 1:
+            return (result,)
+        return tuple(result)
+
+    if result is None:
+        return ()
+    if isinstance(result, tuple) and not isinstance(result, dbus.Struct):
+        return result
+    return (result,)
+
+
+def typed_value(signature, value):
+    """
+    Give a value the DBus type of a signature
+
+    Variants otherwise guess the type, which can't be done for empty arrays.
+
+    :param signature: Single complete type
+    :type signature: str
+
+    :param value: Value
+    :type value: object
+
+    :return: Typed value
+    :rtype: object
+    """
+    if signature == 'ay' and isinstance(value, (bytes, bytearray)):
+        return dbus.ByteArray(value)
+    if signature.startswith('a{'):
+        return dbus.Dictionary(value, signature=signature[2:-1])
+    if signature.startswith('a'):
+        return dbus.Array(value, signature=signature[1:])
+    if signature.startswith('('):
+        return dbus.Struct(value, signature=signature[1:-1])
+    if signature in DBUS_TYPES:
+        return DBUS_TYPES[signature](value)
+
+    return value
+
+
+def dispatched_method(function, function_name, out_signature):
+    """
+    Wrap a method so DBus calls to it go through dispatch_call() and get replied to once it's done
+
+    Called directly, like the daemon does when restoring state, it runs straight away.
+
+    :param function: Function
+    :type function: func
+
+    :param function_name: DBus function name
+    :type function_name: str
+
+    :param out_signature: DBus return signature
+    :type out_signature: str or None
+
+    :return: Function taking the reply and error callbacks of dbus-python
+    :rtype: func
+    """
+    def method(self, *args, reply_handler=None, error_handler=None, **kwargs):
+        if reply_handler is None:
+            return function(self, *args, **kwargs)
+
+        def call():
+            try:
+                values = reply_values(out_signature, function(self, *args, **kwargs))
+            except Exception as err:  # pylint: disable=broad-except
+                error_handler(err)
+            else:
+                reply_handler(*values)
+
+        self.dispatch_call(function_name, call)
+
+    # dbus-python reads the argument names for introspection and to find the callbacks
+    signature = inspect.signature(function)
+    parameters = list(signature.parameters.values())
+    for name in ('reply_handler', 'error_handler'):
+        parameters.append(inspect.Parameter(name, inspect.Parameter.POSITIONAL_OR_KEYWORD, default=None))
+
+    method.__signature__ = signature.replace(parameters=parameters)
+    # What the method takes when called directly, see EffectSync.get_num_arguments()
+    method.__wrapped__ = function
+    method.__name__ = function_name
+    method.__doc__ = function.__doc__
+    return method
+
+
 class DBusService(dbus.service.Object):
     """
     DBus Service object
@@ -39,22 +176,33 @@ class DBusService(dbus.service.Object):
     """
     BUS_NAME = 'org.razer'
 
-    def __init__(self, object_path):
+    def __init__(self, object_path, register=True):
         """
         Init the object
 
         :param object_path: DBus Object name
         :type object_path: str
+
+        :param register: Export the object now, otherwise register_object() must be called
+        :type register: bool
         """
         # We could pass (bus, object_path) here, but we rather register the object manually.
         super().__init__()
 
+        self._service_object_path = object_path
+        if register:
+            self.register_object()
+
+    def register_object(self):
+        """
+        Export the object on the session bus
+        """
         bus = dbus.SessionBus()
 
         # the constructor of BusName registers the bus, the returned object is not used but must be kept
         self.bus_name_obj = dbus.service.BusName(self.BUS_NAME, bus)
 
-        self.add_to_connection(bus, object_path)
+        self.add_to_connection(bus, self._service_object_path)
 
     def add_dbus_method(self, interface_name, function_name, function, in_signature=None, out_signature=None, byte_arrays=False):
         """
@@ -79,12 +227,26 @@ class DBusService(dbus.service.Object):
         :type byte_arrays: bool
         """
 
+        with CLASS_METHODS_LOCK:
+            self._add_dbus_method(interface_name, function_name, function, in_signature, out_signature, byte_arrays)
+
+    def _add_dbus_method(self, interface_name, function_name, function, in_signature, out_signature, byte_arrays):
         # Get class key for use in the DBus introspection table
-        class_key = [key for key in self._dbus_class_table.keys() if key.endswith(self.__class__.__name__)][0]
+        class_key = self._class_key()
+
+        # All instances of a class share the methods, only the first one adds them
+        registered = _CLASS_METHODS.setdefault(self.__class__, {})
+        # Endpoints all share the decorator's wrapper, what they wrap is kept in .code
+        code = function.code if hasattr(function, 'code') else function.__code__
+        source = (code, in_signature, out_signature, byte_arrays)
+        if registered.get((interface_name, function_name)) == source:
+            return
 
         # Create a copy of the function so that if its used multiple times it won't affect other instances if the names changed
         function_deepcopy = copy_func(function, function_name)
-        func = dbus.service.method(interface_name, in_signature=in_signature, out_signature=out_signature, byte_arrays=byte_arrays)(function_deepcopy)
+        function_dispatched = dispatched_method(function_deepcopy, function_name, out_signature)
+        func = dbus.service.method(interface_name, in_signature=in_signature, out_signature=out_signature, byte_arrays=byte_arrays,
+                                   async_callbacks=('reply_handler', 'error_handler'))(function_dispatched)
 
         # Add method to DBus tables
         try:
@@ -95,6 +257,9 @@ class DBusService(dbus.service.Object):
         # Add method to class as DBus expects it to be there.
         setattr(self.__class__, function_name, func)
 
+        registered[(interface_name, function_name)] = source
+        _INTROSPECTION_CACHE.pop(self.__class__, None)
+
     def del_dbus_method(self, interface_name, function_name):
         """
         Remove method from DBus Object
@@ -107,13 +272,87 @@ class DBusService(dbus.service.Object):
         """
 
         # Get class key for use in the DBus introspection table
-        class_key = [key for key in self._dbus_class_table.keys() if key.endswith(self.__class__.__name__)][0]
+        class_key = self._class_key()
 
-        # Remove method from DBus tables
-        # Remove method from class
-        try:
-            del self._dbus_class_table[class_key][interface_name][function_name]
-            delattr(DBusService, function_name)
+        with CLASS_METHODS_LOCK:
+            _CLASS_METHODS.get(self.__class__, {}).pop((interface_name, function_name), None)
+            _INTROSPECTION_CACHE.pop(self.__class__, None)
+
+            # Remove method from DBus tables
+            # Remove method from class
+            try:
+                del self._dbus_class_table[class_key][interface_name][function_name]
+                delattr(DBusService, function_name)
+
+            except (KeyError, AttributeError):
+                pass
+
+    def get_dbus_methods(self):
+        """
+        Methods the object has, as its introspection data lists them
+
+        :return: Interface name to method names
+        :rtype: dict
+        """
+        methods = {}
+        with CLASS_METHODS_LOCK:
+            for interface_name, funcs in self._dbus_class_table[self._class_key()].items():
+                if interface_name != dbus.service.INTROSPECTABLE_IFACE:
+                    methods[interface_name] = sorted(name for name, func in funcs.items() if getattr(func, '_dbus_is_method', False))
+
+        return methods
+
+    def dispatch_call(self, function_name, call):
+        """
+        Run a DBus call to one of the added methods
 
-        except (KeyError, AttributeError):
-            pass
+        The reply is sent by call itself, so it can run anywhere. Here it runs straight away on the
+        main loop, objects that talk to hardware run it elsewhere so they don't hold up the bus.
+
+        :param function_name: DBus function name
+        :type function_name: str
+
+        :param call: Runs the method and replies
+        :type call: callable
+        """
+        call()
+
+    def _class_key(self):
+        """
+        Key of the class in the DBus tables, the same one dbus-python uses
+
+        :return: Class key
+        :rtype: str
+        """
+        return self.__class__.__module__ + '.' + self.__class__.__name__
+
+    @dbus.service.method(dbus.service.INTROSPECTABLE_IFACE, in_signature='', out_signature='s', path_keyword='object_path', connection_keyword='connection')
+    def Introspect(self, object_path, connection):
+        """
+        Return the introspection data of the object
+
+        Same as dbus-python's, except the interfaces are only reflected on once per class rather
+        than on every call.
+        """
+        interfaces = _INTROSPECTION_CACHE.get(self.__class__)
+        if interfaces is None:
+            with CLASS_METHODS_LOCK:
+                interfaces = ''
+                for name, funcs in self._dbus_class_table[self._class_key()].items():
+                    interfaces += '  <interface name="%s">\n' % name
+                    for func in funcs.values():
+                        if getattr(func, '_dbus_is_method', False):
+                            interfaces += self.__class__._reflect_on_method(func)
+                        elif getattr(func, '_dbus_is_signal', False):
+                            interfaces += self.__class__._reflect_on_signal(func)
+                    interfaces += '  </interface>\n'
+                _INTROSPECTION_CACHE[self.__class__] = interfaces
+
+        reflection_data = DBUS_INTROSPECT_1_0_XML_DOCTYPE_DECL_NODE
+        reflection_data += '<node name="%s">\n' % object_path
+        reflection_data += interfaces
+        for name in connection.list_exported_child_objects(object_path):
+            reflection_data += '  <node name="%s"/>\n' % name
+        reflection_data += '</node>\n'
+
+        return reflection_data
@@ -3,6 +3,10 @@
 """
 Class to hold a device and collections of them
 """
+from openrazer_daemon.misc.device_executor import DeviceExecutor
+
+# Seconds to wait for the other devices to take a synced effect
+EFFECT_SYNC_TIMEOUT = 2
 
 
 class Device(object):
@@ -77,6 +81,21 @@ class Device(object):
         # Message from DBus object
         self._dbus.notify(msg)
 
+    def submit(self, name, func):
+        """
+        Queue work on the device's worker, after the work already queued for it
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param func: Called without arguments
+        :type func: callable
+        """
+        if self._parent is None:
+            func()
+        else:
+            self._parent.submit(self, name, func)
+
 
 class DeviceCollection(object):
     """
@@ -88,6 +107,7 @@ class DeviceCollection(object):
     def __init__(self):
         self._id_map = {}
         self._serial_map = {}
+        self._executor = DeviceExecutor()
 
     def add(self, device_id, device_serial, device_dbus):
         """
@@ -195,12 +215,16 @@ class DeviceCollection(object):
         """
         if key in self._id_map:
             serial = self._id_map[key].serial
-            self._id_map.pop(key, None)
+            device = self._id_map.pop(key, None)
             self._serial_map.pop(serial, None)
         elif key in self._serial_map:
             device_id = self._serial_map[key].device_id
             self._id_map.pop(device_id, None)
-            self._serial_map.pop(key, None)
+            device = self._serial_map.pop(key, None)
+        else:
+            return
+
+        self._executor.remove(device)
 
     def __contains__(self, item):
         """
@@ -243,6 +267,60 @@ class DeviceCollection(object):
         :param msg: Messgae
         :type msg: tuple
         """
-        for child in self._id_map.values():
-            if child is not active_child:
-                child.notify_child(msg)
+        children = [child for child in self._id_map.values() if child is not active_child]
+
+        self._executor.run('Effect sync', children, lambda child: child.notify_child(msg), EFFECT_SYNC_TIMEOUT)
+
+    def submit(self, device, name, func):
+        """
+        Queue work on a device's worker without waiting for it
+
+        :param device: Device
+        :type device: Device
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param func: Called without arguments
+        :type func: callable
+        """
+        self._executor.submit(name, device, lambda _: func())
+
+    def run(self, name, devices, func, timeout):
+        """
+        Call func for some of the devices concurrently and wait for them to finish
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param devices: Devices
+        :type devices: list of Device
+
+        :param func: Called with the Device
+        :type func: callable
+
+        :param timeout: Seconds to wait
+        :type timeout: float
+        """
+        self._executor.run(name, devices, func, timeout)
+
+    def run_all(self, name, func, timeout):
+        """
+        Call func for every device concurrently and wait for them to finish
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param func: Called with the Device
+        :type func: callable
+
+        :param timeout: Seconds to wait
+        :type timeout: float
+        """
+        self.run(name, self.devices, func, timeout)
+
+    def close(self):
+        """
+        Stop the device workers
+        """
+        self._executor.shutdown()
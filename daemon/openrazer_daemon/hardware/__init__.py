@@ -4,6 +4,7 @@
 Hardware collection
 """
 import os
+import re
 from openrazer_daemon.hardware.device_base import RazerDevice
 
 # Hack to get a list of hardware modules to import
@@ -12,23 +13,94 @@ HARDWARE_MODULES = ['openrazer_daemon.hardware.' + os.path.splitext(hw_file)[0]
 # List of classes to exclude from the class finding
 EXCLUDED_CLASSES = ('RazerDevice', 'RazerDeviceBrightnessSuspend')
 
+# Class definitions and their USB IDs in the hardware module sources
+CLASS_REGEX = re.compile(r'^class (\w+)\((\w+)')
+USB_ID_REGEX = re.compile(r'^    USB_(VID|PID) = (0x[0-9A-Fa-f]+)')
 
-def get_device_classes():
+# HID sys names look like 0003:1532:0084.0001, bus, VID, PID and instance
+HID_SYS_NAME_REGEX = re.compile(r'^[0-9A-F]{4}:([0-9A-F]{4}):([0-9A-F]{4})\.[0-9A-F]{4}$')
+
+
+def parse_hid_sys_name(sys_name):
+    """
+    Get the USB ID out of a HID sys name
+
+    :param sys_name: Device ID like 0003:1532:0084.0001
+    :type sys_name: str
+
+    :return: (VID, PID) or None if it's not a HID sys name
+    :rtype: tuple of int or None
+    """
+    match = HID_SYS_NAME_REGEX.match(sys_name)
+    if match is None:
+        return None
+
+    return int(match.group(1), 16), int(match.group(2), 16)
+
+
+class DeviceRegistry(object):
     """
-    Get a list of hardware classes
+    Finds the class of a device by its USB ID
 
-    :return: List of RazerDevice subclasses
-    :rtype: list of callable
+    The hardware modules define hundreds of classes. Their USB IDs are read from the module
+    sources, and a module is only imported once a device of one of its classes shows up.
     """
-    classes = []
 
-    for hw_module in HARDWARE_MODULES:
-        imported_module = __import__(hw_module, globals=globals(), locals=locals(), fromlist=['*'], level=0)
+    def __init__(self):
+        # (VID, PID) to (module, class name)
+        self.index = {}
+        self._classes = {}
+
+        hardware_dir = os.path.dirname(__file__)
+        for hw_module in HARDWARE_MODULES:
+            with open(os.path.join(hardware_dir, hw_module.rsplit('.', 1)[1] + '.py')) as module_file:
+                class_name = usb_vid = None
+                # Subclasses of other devices inherit their VID
+                class_vids = {}
+
+                for line in module_file:
+                    class_match = CLASS_REGEX.match(line)
+                    if class_match is not None:
+                        class_name = class_match.group(1)
+                        usb_vid = class_vids[class_name] = class_vids.get(class_match.group(2))
+                        continue
+
+                    id_match = USB_ID_REGEX.match(line)
+                    if id_match is None or class_name is None or class_name in EXCLUDED_CLASSES or class_name.startswith('_'):
+                        continue
+
+                    if id_match.group(1) == 'VID':
+                        usb_vid = class_vids[class_name] = int(id_match.group(2), 16)
+                    elif usb_vid is not None:
+                        self.index.setdefault((usb_vid, int(id_match.group(2), 16)), (hw_module, class_name))
+
+    def get(self, usb_id):
+        """
+        Get the class of a device, importing its module if needed
+
+        :param usb_id: (VID, PID), None is allowed
+        :type usb_id: tuple of int or None
+
+        :return: Device class or None if the device isn't supported
+        :rtype: callable or None
+        """
+        device_class = self._classes.get(usb_id)
+        if device_class is not None:
+            return device_class
+
+        entry = self.index.get(usb_id)
+        if entry is None:
+            return None
 
-        for class_name, class_instance in imported_module.__dict__.items():
-            if class_name in EXCLUDED_CLASSES or class_name.startswith('_') or not isinstance(class_instance, type):
-                continue
+        imported_module = __import__(entry[0], globals=globals(), locals=locals(), fromlist=['*'], level=0)
+        device_class = self._classes[usb_id] = getattr(imported_module, entry[1])
+        return device_class
 
-            classes.append(class_instance)
+    def class_names(self):
+        """
+        Get the supported devices without importing their modules
 
-    return sorted(classes, key=lambda cls: cls.__name__)
+        :return: Dict of class name to (VID, PID)
+        :rtype: dict
+        """
+        return {class_name: usb_id for usb_id, (_, class_name) in self.index.items()}
@@ -34,6 +34,7 @@ class RazerChromaARGB(_RazerDeviceBrightnessSuspend):
     USB_PID = 0x0F1F
     HAS_MATRIX = True
     MATRIX_DIMS = [6, 80]
+    CUSTOM_FRAME_WHOLE_ROWS = True
     NUM_CHANNELS = 6
     WAVE_DIRS = (1, 2)
     METHODS = ['get_device_type_accessory',
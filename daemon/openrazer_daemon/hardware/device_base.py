@@ -3,19 +3,24 @@
 """
 Hardware base class
 """
-import configparser
 import re
 import os
 import types
-import inspect
 import logging
 import time
 import json
 import random
+import struct
+import threading
 
-from openrazer_daemon.dbus_services.service import DBusService
+import numpy as np
+
+from openrazer_daemon.dbus_services.service import DBusService, typed_value, CLASS_METHODS_LOCK
 import openrazer_daemon.dbus_services.dbus_methods
 from openrazer_daemon.misc import effect_sync
+from openrazer_daemon.misc.restore_plan import RestorePlan, driver_state_holds
+from openrazer_daemon.misc.frame_channel import FrameChannel
+from openrazer_daemon.misc.custom_frame import diff_custom_frame, span_payload, apply_spans
 
 
 # pylint: disable=too-many-instance-attributes
@@ -45,7 +50,27 @@ class RazerDevice(DBusService):
 
     DEVICE_IMAGE = None
 
-    def __init__(self, device_path, device_number, config, persistence, testing, additional_interfaces, additional_methods):
+    # Descriptor entries clients get from getDeviceDescriptors, and the methods they come from
+    DESCRIPTOR_METHODS = (
+        ('name', 'razer.device.misc', 'getDeviceName'),
+        ('type', 'razer.device.misc', 'getDeviceType'),
+        ('firmware', 'razer.device.misc', 'getFirmware'),
+        ('driver_version', 'razer.device.misc', 'getDriverVersion'),
+        ('vid_pid', 'razer.device.misc', 'getVidPid'),
+        ('has_matrix', 'razer.device.misc', 'hasMatrix'),
+        ('matrix_dimensions', 'razer.device.misc', 'getMatrixDimensions'),
+        ('keyboard_layout', 'razer.device.misc', 'getKeyboardLayout'),
+        ('dedicated_macro_keys', 'razer.device.misc', 'hasDedicatedMacroKeys'),
+        ('device_image', 'razer.device.misc', 'getDeviceImage'),
+    )
+
+    # Driver takes one row per write of matrix_custom_frame and ignores its start column
+    CUSTOM_FRAME_WHOLE_ROWS = False
+
+    # Driver files written often enough to keep open, see write_driver_file()
+    CACHED_DRIVER_FILES = frozenset(('matrix_custom_frame', 'matrix_effect_custom', 'matrix_brightness', 'dpi'))
+
+    def __init__(self, device_path, device_number, config, persistence, testing, additional_interfaces, additional_methods, register=True):
 
         self.logger = logging.getLogger('razer.device{0}'.format(device_number))
         self.logger.info("Initialising device.%d %s", device_number, self.__class__.__name__)
@@ -69,6 +94,20 @@ class RazerDevice(DBusService):
         self._testing = testing
         self._parent = None
         self._device_path = device_path
+        self._driver_capabilities = None
+        self._driver_fds = {}
+        self._driver_fds_lock = threading.Lock()
+        self._driver_syscalls_saved = 0
+        self._frame_channel = None
+
+        # Last custom frame sent to the driver, see write_custom_frame()
+        self._custom_frame_lock = threading.Lock()
+        self._custom_frame = None
+        self._custom_frame_known = None
+        self._custom_frame_changed = False
+        self._custom_effect_active = False
+
+        self._driver_state = self.read_state_snapshot()
         self._device_number = device_number
         self.serial = self.get_serial()
 
@@ -116,6 +155,11 @@ class RazerDevice(DBusService):
         self.methods_internal = ['get_firmware', 'get_matrix_dims', 'has_matrix', 'get_device_name']
         self.methods_internal.extend(additional_methods)
 
+        # Devices taking custom frames can also take them through shared memory. Not for the fake
+        # driver, tests expect a frame to be in the driver file as soon as the draw call returns.
+        if 'set_key_row' in self.METHODS and not self._testing:
+            self.methods_internal.append('get_frame_channel')
+
         # Find event files in /dev/input/by-id/ by matching against regex
         self.event_files = []
 
@@ -130,7 +174,7 @@ class RazerDevice(DBusService):
                     self.event_files.append(os.path.join(search_dir, event_file))
 
         object_path = os.path.join(self.OBJECT_PATH, self.serial)
-        super().__init__(object_path)
+        super().__init__(object_path, register=register)
 
         # Set up methods to suspend and restore device operation
         self.suspend_args = {}
@@ -147,6 +191,7 @@ class RazerDevice(DBusService):
             ('razer.device.misc', 'getVidPid', self.get_vid_pid, None, 'ai'),
             ('razer.device.misc', 'getDriverVersion', openrazer_daemon.dbus_services.dbus_methods.version, None, 's'),
             ('razer.device.misc', 'hasDedicatedMacroKeys', self.dedicated_macro_keys, None, 'b'),
+            ('razer.device.misc', 'getDriverFileStats', self.get_driver_file_stats, None, 'a{st}'),
             # Deprecated API, but kept for backwards compatibility
             ('razer.device.misc', 'getRazerUrls', self.get_image_json, None, 's'),
 
@@ -241,77 +286,13 @@ class RazerDevice(DBusService):
         # Load additional DBus methods
         self.load_methods()
 
-        # load last DPI/poll rate state
-        if self.persistence.has_section(self.storage_name):
-            if 'set_dpi_xy' in self.METHODS or 'set_dpi_xy_byte' in self.METHODS:
-                try:
-                    self.dpi[0] = int(self.persistence[self.storage_name]['dpi_x'])
-                    self.dpi[1] = int(self.persistence[self.storage_name]['dpi_y'])
-                except (KeyError, configparser.NoOptionError):
-                    self.logger.info("Failed to get DPI from persistence storage, using default.")
-
-            if 'set_poll_rate' in self.METHODS:
-                try:
-                    self.poll_rate = int(self.persistence[self.storage_name]['poll_rate'])
-                except (KeyError, configparser.NoOptionError):
-                    self.logger.info("Failed to get poll rate from persistence storage, using default.")
+        # load last DPI/poll rate state and effects
+        present_zones = [i for i in self.ZONES if self.zone[i]["present"]]
+        RestorePlan.from_persistence(self.persistence, self.storage_name, present_zones, self.logger).apply(self)
 
-        # load last effects
-        for i in self.ZONES:
-            if self.zone[i]["present"]:
-                # check if we have the device in the persistence file
-                if self.persistence.has_section(self.storage_name):
-                    # try reading the effect name from the persistence
-                    try:
-                        self.zone[i]["effect"] = self.persistence[self.storage_name][i + '_effect']
-                    except (KeyError, configparser.NoOptionError):
-                        self.logger.info("Failed to get " + i + " effect from persistence storage, using default.")
-
-                    # zone active status
-                    try:
-                        self.zone[i]["active"] = self.persistence.getboolean(self.storage_name, i + '_active')
-                    except (KeyError, configparser.NoOptionError):
-                        self.logger.info("Failed to get " + i + " active from persistence storage, using default.")
-
-                    # brightness
-                    try:
-                        self.zone[i]["brightness"] = float(self.persistence[self.storage_name][i + '_brightness'])
-                    except (KeyError, configparser.NoOptionError):
-                        self.logger.info("Failed to get " + i + " brightness from persistence storage, using default.")
-
-                    # colors.
-                    # these are stored as a string that must contain 9 numbers, separated with spaces.
-                    try:
-                        for index, item in enumerate(self.persistence[self.storage_name][i + '_colors'].split(" ")):
-                            self.zone[i]["colors"][index] = int(item)
-                            # check if the color is in range
-                            if not 0 <= self.zone[i]["colors"][index] <= 255:
-                                raise ValueError('Color out of range')
-
-                        # check if we have exactly 9 colors
-                        if len(self.zone[i]["colors"]) != 9:
-                            raise ValueError('There must be exactly 9 colors')
-                    except ValueError:
-                        # invalid colors. reinitialize
-                        self.zone[i]["colors"] = [0, 255, 0, 0, 255, 255, 0, 0, 255]
-                        self.logger.info("%s: Invalid colors; restoring to defaults.", self.__class__.__name__)
-                    except (KeyError, configparser.NoOptionError):
-                        self.logger.info("Failed to get " + i + " colors from persistence storage, using default.")
-
-                    # speed
-                    try:
-                        self.zone[i]["speed"] = int(self.persistence[self.storage_name][i + '_speed'])
-                    except (KeyError, configparser.NoOptionError):
-                        self.logger.info("Failed to get " + i + " speed from persistence storage, using default.")
-
-                    # wave direction
-                    try:
-                        self.zone[i]["wave_dir"] = int(self.persistence[self.storage_name][i + '_wave_dir'])
-                    except (KeyError, configparser.NoOptionError):
-                        self.logger.info("Failed to get " + i + " wave direction from persistence storage, using default.")
-
-        self.restore_dpi_poll_rate()
-        self.restore_brightness()
+        # Settings the driver has seen set to the same value since it was loaded aren't written again
+        self.restore_dpi_poll_rate(self._driver_state)
+        self.restore_brightness(self._driver_state)
 
         if self.config.getboolean('Startup', "restore_persistence") is True:
             self.restore_effect()
@@ -329,6 +310,10 @@ class RazerDevice(DBusService):
         payload = ['effect', self, effect_name]
         payload.extend(args)
 
+        # Any effect but a brightness change replaces what's on the LEDs
+        if effect_name != 'setBrightness':
+            self.invalidate_custom_frame()
+
         self.notify_observers(tuple(payload))
 
     def dedicated_macro_keys(self):
@@ -340,41 +325,64 @@ class RazerDevice(DBusService):
         """
         return self.DEDICATED_MACRO_KEYS
 
-    def restore_dpi_poll_rate(self):
+    def restore_dpi_poll_rate(self, current_state=None):
         """
         Set the device DPI & poll rate to the saved value
+
+        :param current_state: State snapshot of the device, settings the driver has cached with the same value are skipped
+        :type current_state: dict or None
         """
+        current_state = current_state or {}
+
         dpi_func = getattr(self, "setDPI", None)
         if dpi_func is not None:
-            dpi_func(self.dpi[0], self.dpi[1])
+            # Only set_dpi_xy devices show the DPI the way it's stored
+            if 'set_dpi_xy' in self.METHODS and (driver_state_holds(current_state, 'dpi', self.dpi[0], self.dpi[1]) or
+                                                 (self.dpi[1] <= 0 and driver_state_holds(current_state, 'dpi', self.dpi[0]))):
+                self.logger.debug("Device already has DPI %d:%d", self.dpi[0], self.dpi[1])
+            else:
+                dpi_func(self.dpi[0], self.dpi[1])
 
         poll_rate_func = getattr(self, "setPollRate", None)
         if poll_rate_func is not None:
-            poll_rate_func(self.poll_rate)
+            if driver_state_holds(current_state, 'poll_rate', self.poll_rate):
+                self.logger.debug("Device already has poll rate %d", self.poll_rate)
+            else:
+                poll_rate_func(self.poll_rate)
 
-    def restore_brightness(self):
+    def restore_brightness(self, current_state=None):
         """
         Set the device to the current brightness/active state.
 
         This is used at launch time.
+
+        :param current_state: State snapshot of the device, settings the driver has cached with the same value are skipped
+        :type current_state: dict or None
         """
+        current_state = current_state or {}
+
         for i in self.ZONES:
             if self.zone[i]["present"]:
                 # load active state
                 if 'set_' + i + '_active' in self.METHODS:
                     active_func = getattr(self, "set" + self.capitalize_first_char(i) + "Active", None)
-                    if active_func is not None:
+                    if active_func is not None and not driver_state_holds(current_state, i + '_led_state', int(bool(self.zone[i]["active"]))):
                         active_func(self.zone[i]["active"])
 
                 # load brightness level
                 bright_func = None
                 if i == "backlight":
                     bright_func = getattr(self, "setBrightness", None)
+                    driver_filename = 'matrix_brightness'
                 elif 'set_' + i + '_brightness' in self.METHODS:
                     bright_func = getattr(self, "set" + self.capitalize_first_char(i) + "Brightness", None)
+                    driver_filename = i + '_led_brightness'
 
                 if bright_func is not None:
-                    bright_func(self.zone[i]["brightness"])
+                    # The driver shows brightness as 0-255, like the setters write it
+                    raw_brightness = int(round(min(max(self.zone[i]["brightness"], 0), 100) * (255.0 / 100.0)))
+                    if not driver_state_holds(current_state, driver_filename, raw_brightness):
+                        bright_func(self.zone[i]["brightness"])
 
     def disable_brightness(self):
         """
@@ -405,6 +413,8 @@ class RazerDevice(DBusService):
         This is used at launch time and can be called by applications
         that use custom matrix frames after they exit
         """
+        effect_methods = effect_sync.get_dispatch_table(self.__class__).methods
+
         for i in self.ZONES:
             if self.zone[i]["present"]:
                 # prepare the effect method name
@@ -416,7 +426,7 @@ class RazerDevice(DBusService):
                     effect_func_name = 'set' + self.handle_underscores(self.capitalize_first_char(i)) + self.capitalize_first_char(self.zone[i]["effect"])
 
                 # find the effect method
-                effect_func = getattr(self, effect_func_name, None)
+                effect_func, num_args = effect_methods.get(effect_func_name, (None, None))
 
                 # check if the effect method exists only if we didn't look for spectrum (because resetting to Spectrum when the effect is Spectrum is in vain)
                 if effect_func == None and not self.zone[i]["effect"] == "spectrum":
@@ -427,7 +437,7 @@ class RazerDevice(DBusService):
                         effect_func_name = 'setSpectrum'
                     else:
                         effect_func_name = 'set' + self.capitalize_first_char(i) + 'Spectrum'
-                    effect_func = getattr(self, effect_func_name, None)
+                    effect_func, num_args = effect_methods.get(effect_func_name, (None, None))
 
                 # we check again here because there is a possibility the device may not even have Spectrum
                 if effect_func is not None:
@@ -435,37 +445,37 @@ class RazerDevice(DBusService):
                     colors = self.zone[i]["colors"]
                     speed = self.zone[i]["speed"]
                     wave_dir = self.zone[i]["wave_dir"]
-                    if self.get_num_arguments(effect_func) == 0:
-                        effect_func()
-                    elif self.get_num_arguments(effect_func) == 1:
+                    if num_args == 0:
+                        effect_func(self)
+                    elif num_args == 1:
                         # there are 2 effects which require 1 argument.
                         # these are: Starlight (Random) and Wave.
                         if effect == 'starlightRandom':
-                            effect_func(speed)
+                            effect_func(self, speed)
                         elif effect == 'wave':
-                            effect_func(wave_dir)
+                            effect_func(self, wave_dir)
                         elif effect == 'rippleRandomColour':
                             # do nothing. this is handled in the ripple manager.
                             pass
                         else:
                             self.logger.error("%s: Effect requires 1 argument but don't know how to handle it!", self.__class__.__name__)
-                    elif self.get_num_arguments(effect_func) == 3:
-                        effect_func(colors[0], colors[1], colors[2])
-                    elif self.get_num_arguments(effect_func) == 4:
+                    elif num_args == 3:
+                        effect_func(self, colors[0], colors[1], colors[2])
+                    elif num_args == 4:
                         # starlight/reactive have different arguments.
                         if effect == 'starlightSingle' or effect == 'reactive':
-                            effect_func(colors[0], colors[1], colors[2], speed)
+                            effect_func(self, colors[0], colors[1], colors[2], speed)
                         elif effect == 'ripple':
                             # do nothing. this is handled in the ripple manager.
                             pass
                         else:
                             self.logger.error("%s: Effect requires 4 arguments but don't know how to handle it!", self.__class__.__name__)
-                    elif self.get_num_arguments(effect_func) == 6:
-                        effect_func(colors[0], colors[1], colors[2], colors[3], colors[4], colors[5])
-                    elif self.get_num_arguments(effect_func) == 7:
-                        effect_func(colors[0], colors[1], colors[2], colors[3], colors[4], colors[5], speed)
-                    elif self.get_num_arguments(effect_func) == 9:
-                        effect_func(colors[0], colors[1], colors[2], colors[3], colors[4], colors[5], colors[6], colors[7], colors[8])
+                    elif num_args == 6:
+                        effect_func(self, colors[0], colors[1], colors[2], colors[3], colors[4], colors[5])
+                    elif num_args == 7:
+                        effect_func(self, colors[0], colors[1], colors[2], colors[3], colors[4], colors[5], speed)
+                    elif num_args == 9:
+                        effect_func(self, colors[0], colors[1], colors[2], colors[3], colors[4], colors[5], colors[6], colors[7], colors[8])
                     else:
                         self.logger.error("%s: Couldn't detect effect argument count!", self.__class__.__name__)
 
@@ -486,13 +496,13 @@ class RazerDevice(DBusService):
             return
         self.logger.debug("Set persistence (%s, %s, %s)", zone, key, value)
 
-        self.persistence.status["changed"] = True
-
         if zone:
             self.zone[zone][key] = value
         else:
             self.zone[key] = value
 
+        self.persistence.autosave.mark_changed(self.storage_name, zone or None)
+
     def get_current_effect(self):
         """
         Get the device's current effect
@@ -917,6 +927,247 @@ class RazerDevice(DBusService):
         """
         return os.path.join(self._device_path, driver_filename)
 
+    def has_driver_file(self, driver_filename):
+        """
+        Check if the driver exposes a file for this device
+
+        Drivers list the files a device supports in "capabilities", so this is one read
+        per device instead of a stat per file. Older drivers don't have it, in which case
+        the file is checked for directly.
+
+        :param driver_filename: Name of driver file
+        :type driver_filename: str
+
+        :return: True if the file exists
+        :rtype: bool
+        """
+        if self._driver_capabilities is None:
+            try:
+                with open(self.get_driver_path('capabilities'), 'r') as capabilities_file:
+                    self._driver_capabilities = frozenset(capabilities_file.read().split())
+            except OSError:
+                return os.path.exists(self.get_driver_path(driver_filename))
+
+        return driver_filename in self._driver_capabilities
+
+    def read_state_snapshot(self):
+        """
+        Read the state the driver knows with one read
+
+        The driver packs its version, the device type, the capabilities and the settings it has
+        cached (the last DPI, poll rate or brightness written or read) into "state_snapshot",
+        reading those from the device on the first read after probe or resume: a version byte, a reserved byte and a little endian record count,
+        followed by records of a byte length prefixed name and a 16bit length prefixed value.
+        Returns an empty dict if the driver has no snapshot.
+
+        :return: Driver file contents by file name
+        :rtype: dict
+        """
+        state = {}
+
+        try:
+            with open(self.get_driver_path('state_snapshot'), 'rb', buffering=0) as snapshot_file:
+                data = snapshot_file.read(65536)
+        except OSError:
+            return state
+
+        try:
+            version, _, count = struct.unpack_from('<BBH', data)
+            if version != 1:
+                self.logger.warning("Unknown state snapshot version %d", version)
+                return state
+
+            offset = 4
+            for _ in range(count):
+                name_len = data[offset]
+                name = data[offset + 1:offset + 1 + name_len].decode('ascii')
+                offset += 1 + name_len
+                value_len, = struct.unpack_from('<H', data, offset)
+                state[name] = data[offset + 2:offset + 2 + value_len]
+                offset += 2 + value_len
+        except (struct.error, IndexError, UnicodeDecodeError):
+            self.logger.warning("Malformed state snapshot")
+            return {}
+
+        if 'capabilities' in state:
+            self._driver_capabilities = frozenset(state['capabilities'].decode('ascii', 'replace').split())
+
+        return state
+
+    def write_driver_file(self, driver_filename, payload):
+        """
+        Write to a driver file
+
+        Files in CACHED_DRIVER_FILES are kept open and written with pwrite, which saves the path
+        lookup, open and close on every effect frame. Everything else is opened for each write.
+
+        :param driver_filename: Name of driver file
+        :type driver_filename: str
+
+        :param payload: Data to write
+        :type payload: bytes or str
+        """
+        if isinstance(payload, str):
+            payload = payload.encode('ascii')
+
+        # The fake driver uses regular files which need truncating on each write
+        if self._testing or driver_filename not in self.CACHED_DRIVER_FILES:
+            with open(self.get_driver_path(driver_filename), 'wb') as driver_file:
+                driver_file.write(payload)
+            return
+
+        with self._driver_fds_lock:
+            driver_fd = self._driver_fds.get(driver_filename)
+
+            if driver_fd is None:
+                driver_fd = os.open(self.get_driver_path(driver_filename), os.O_WRONLY | os.O_CLOEXEC)
+                self._driver_fds[driver_filename] = driver_fd
+            else:
+                # open() and close()
+                self._driver_syscalls_saved += 2
+
+            try:
+                os.pwrite(driver_fd, payload, 0)
+            except OSError:
+                # Most likely the device went away, open the file again next time
+                del self._driver_fds[driver_filename]
+                os.close(driver_fd)
+                raise
+
+    def open_frame_channel(self):
+        """
+        Open a shared memory channel for custom frames, replacing any previous one
+
+        :return: Frame channel
+        :rtype: FrameChannel
+        """
+        if self._frame_channel is not None:
+            self._frame_channel.close()
+
+        rows, columns = self.MATRIX_DIMS
+        self._frame_channel = FrameChannel(self._device_number, rows, columns, self._write_custom_frame, self.submit)
+
+        return self._frame_channel
+
+    def _write_custom_frame(self, payload):
+        """
+        Show a frame from the frame channel, what setKeyRow then setCustom do
+
+        :param payload: Binary payload for the whole matrix
+        :type payload: bytes
+        """
+        self.write_custom_frame(payload)
+        self.commit_custom_frame()
+
+    def write_custom_frame(self, payload):
+        """
+        Write rows of a custom frame, skipping the keys that haven't changed
+
+        The last colour sent for every key is kept. Each row in the payload is cut down to the
+        span between the first and last key that changed, rows without changes are left out and
+        when nothing changed nothing is written. The driver sends a report per row, so unchanged
+        rows no longer cost a USB round trip. See CUSTOM_FRAME_WHOLE_ROWS for drivers that can't
+        take spans.
+
+        Payloads that don't fit the matrix are written as they are for the driver to judge. So
+        are all payloads for the fake driver, its files only hold the last write.
+
+        :param payload: Rows of row ID, start column, stop column then RGB bytes
+        :type payload: bytes
+        """
+        with self._custom_frame_lock:
+            if self._testing or not self.HAS_MATRIX or self.MATRIX_DIMS is None:
+                self.write_driver_file('matrix_custom_frame', payload)
+                self._custom_frame_changed = True
+                return
+
+            if self._custom_frame is None:
+                rows, columns = self.MATRIX_DIMS
+                self._custom_frame = np.zeros((rows, columns, 3), dtype=np.uint8)
+                self._custom_frame_known = np.zeros((rows, columns), dtype=bool)
+
+            spans = diff_custom_frame(self._custom_frame, self._custom_frame_known, payload, self.CUSTOM_FRAME_WHOLE_ROWS)
+
+            if spans is None:
+                # Malformed payload, let the driver reject it and forget what the keys show
+                self._custom_frame_known.fill(False)
+                self.write_driver_file('matrix_custom_frame', payload)
+                self._custom_frame_changed = True
+                return
+
+            if len(spans) == 0:
+                return
+
+            if self.CUSTOM_FRAME_WHOLE_ROWS:
+                for span in spans:
+                    self.write_driver_file('matrix_custom_frame', span_payload(*span))
+            else:
+                self.write_driver_file('matrix_custom_frame', b''.join(span_payload(*span) for span in spans))
+
+            apply_spans(self._custom_frame, self._custom_frame_known, spans)
+            self._custom_frame_changed = True
+
+    def commit_custom_frame(self):
+        """
+        Switch the device to the custom frame, unless it's already showing it unchanged
+        """
+        with self._custom_frame_lock:
+            if self._custom_effect_active and not self._custom_frame_changed:
+                return
+
+            self.write_driver_file('matrix_effect_custom', b'1')
+            self._custom_frame_changed = False
+            self._custom_effect_active = True
+
+    def invalidate_custom_frame(self):
+        """
+        Forget the last custom frame, the next one is sent in full
+
+        Called whenever something other than a custom frame could have changed the LEDs.
+        """
+        with self._custom_frame_lock:
+            if self._custom_frame_known is not None:
+                self._custom_frame_known.fill(False)
+            self._custom_effect_active = False
+
+    def close_driver_files(self):
+        """
+        Close the driver files kept open by write_driver_file
+        """
+        with self._driver_fds_lock:
+            for driver_fd in self._driver_fds.values():
+                os.close(driver_fd)
+            self._driver_fds.clear()
+
+    def get_driver_file_stats(self):
+        """
+        Get statistics about the driver file cache
+
+        :return: Dict of open_files and syscalls_saved
+        :rtype: dict
+        """
+        return {
+            'open_files': len(self._driver_fds),
+            'syscalls_saved': self._driver_syscalls_saved,
+        }
+
+    def get_driver_state(self, driver_filename):
+        """
+        Get the contents of a driver file as read at startup
+
+        Only meant for values that don't change while the device is plugged in.
+
+        :param driver_filename: Name of driver file
+        :type driver_filename: str
+
+        :return: File contents or None if it wasn't in the snapshot
+        :rtype: str or None
+        """
+        value = self._driver_state.get(driver_filename)
+        if value is None:
+            return None
+        return value.decode('utf-8', 'replace').strip()
+
     def get_serial(self):
         """
         Get serial number for device
@@ -928,7 +1179,7 @@ class RazerDevice(DBusService):
         if self._serial is None:
             serial_path = os.path.join(self._device_path, 'device_serial')
             count = 0
-            serial = ''
+            serial = self.get_driver_state('device_serial') or ''
             while len(serial) == 0:
                 if count >= 5:
                     break
@@ -1019,6 +1270,32 @@ class RazerDevice(DBusService):
     def get_device_image(self):
         return self.DEVICE_IMAGE
 
+    def get_descriptor(self):
+        """
+        Describe the device with what clients otherwise ask for one call at a time
+
+        Entries whose method the device doesn't have, or which fail, are left out and clients ask
+        for them. 'features' holds the methods of every interface, as introspection lists them.
+
+        :return: Descriptor, with values typed for variants
+        :rtype: dict
+        """
+        descriptor = {}
+
+        for key, interface_name, function_name in self.DESCRIPTOR_METHODS:
+            func = getattr(self.__class__, function_name, None)
+            if getattr(func, '_dbus_interface', None) != interface_name:
+                continue
+
+            try:
+                descriptor[key] = typed_value(func._dbus_out_signature, func(self))
+            except (OSError, TypeError, ValueError) as err:
+                self.logger.debug("Leaving %s out of the descriptor: %s", key, err)
+
+        descriptor['features'] = typed_value('a{sas}', self.get_dbus_methods())
+
+        return descriptor
+
     def load_methods(self):
         """
         Load DBus methods
@@ -1033,13 +1310,19 @@ class RazerDevice(DBusService):
                 available_functions[potential_function.__name__] = potential_function
 
         self.methods_internal.extend(self.METHODS)
-        for method_name in self.methods_internal:
-            try:
-                new_function = available_functions[method_name]
-                self.logger.debug("Adding %s.%s method to DBus", new_function.interface, new_function.name)
-                self.add_dbus_method(new_function.interface, new_function.name, new_function, new_function.in_sig, new_function.out_sig, new_function.byte_arrays)
-            except KeyError as e:
-                raise RuntimeError("Couldn't add method to DBus: " + str(e)) from None
+
+        # Devices of the same class created at the same time load them onto the class together
+        with CLASS_METHODS_LOCK:
+            for method_name in self.methods_internal:
+                try:
+                    new_function = available_functions[method_name]
+                    self.logger.debug("Adding %s.%s method to DBus", new_function.interface, new_function.name)
+                    self.add_dbus_method(new_function.interface, new_function.name, new_function, new_function.in_sig, new_function.out_sig, new_function.byte_arrays)
+                except KeyError as e:
+                    raise RuntimeError("Couldn't add method to DBus: " + str(e)) from None
+
+            # All the effect methods are on the class now
+            effect_sync.build_dispatch_table(self.__class__)
 
     def suspend_device(self):
         """
@@ -1052,6 +1335,10 @@ class RazerDevice(DBusService):
         self.disable_brightness()
         self._suspend_device()
 
+        # Nothing is written while suspended, don't hold the files open
+        self.close_driver_files()
+        self.invalidate_custom_frame()
+
         self.disable_notify = False
         self.disable_persistence = False
 
@@ -1100,6 +1387,9 @@ class RazerDevice(DBusService):
                     self.dpi = dpi_func()
 
             self._close()
+            if self._frame_channel is not None:
+                self._frame_channel.close()
+            self.close_driver_files()
 
             self._is_closed = True
 
@@ -1122,6 +1412,38 @@ class RazerDevice(DBusService):
         """
         self._parent = parent
 
+    def dispatch_call(self, function_name, call):
+        """
+        Run a DBus call on the device's worker
+
+        Calls to one device run in order, while a slow device only holds up calls to itself.
+
+        :param function_name: DBus function name
+        :type function_name: str
+
+        :param call: Runs the method and replies
+        :type call: callable
+        """
+        self.submit(function_name, call)
+
+    def submit(self, name, func):
+        """
+        Queue blocking work, like driver I/O, on the device's worker
+
+        Work started from the reactor goes through here, so a slow device doesn't hold up the
+        timers and readers of every other device.
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param func: Called without arguments
+        :type func: callable
+        """
+        if self._parent is None:
+            func()
+        else:
+            self._parent.submit(name, func)
+
     def remove_observer(self, observer):
         """
         Obsever design pattern, remove
@@ -1184,20 +1506,6 @@ class RazerDevice(DBusService):
 
         return False
 
-    @staticmethod
-    def get_num_arguments(func):
-        """
-        Get number of arguments in a function
-
-        :param func: Function
-        :type func: callable
-
-        :return: Number of arguments
-        :rtype: int
-        """
-        func_sig = inspect.signature(func)
-        return len(func_sig.parameters)
-
     @staticmethod
     def handle_underscores(string):
         return re.sub(r'[_]+(?P<first>[a-z])', lambda m: m.group('first').upper(), string)
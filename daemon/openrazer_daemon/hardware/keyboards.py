@@ -26,7 +26,7 @@ class _MacroKeyboard(_RazerDeviceBrightnessSuspend):
         super().__init__(*args, **kwargs)
         # Methods are loaded into DBus by this point
 
-        self.key_manager = _KeyboardKeyManager(self._device_number, self.event_files, self, use_epoll=True, testing=self._testing)
+        self.key_manager = _KeyboardKeyManager(self._device_number, self.event_files, self, testing=self._testing)
 
         self.logger.info('Putting device into driver mode. Daemon will handle special functionality')
         self.set_device_mode(0x03, 0x00)  # Driver mode
@@ -60,6 +60,7 @@ class _RippleKeyboard(_MacroKeyboard):
             raise RuntimeError("Cannot use RippleKeyboard without matrix capabilities")
 
         self.ripple_manager = _RippleManager(self, self._device_number)
+        self.add_dbus_method('razer.device.lighting.custom', 'getFrameStats', self.get_frame_stats, out_signature='a{sd}')
 
         # we need to set the effect to ripple (if needed) after the ripple manager has started
         # otherwise it doesn't work
@@ -69,9 +70,18 @@ class _RippleKeyboard(_MacroKeyboard):
 
             if effect_func is not None:
                 if effect_func_name == 'setRipple':
-                    effect_func(self.zone["backlight"]["colors"][0], self.zone["backlight"]["colors"][1], self.zone["backlight"]["colors"][2], self.ripple_manager._ripple_thread._refresh_rate)
+                    effect_func(self.zone["backlight"]["colors"][0], self.zone["backlight"]["colors"][1], self.zone["backlight"]["colors"][2], self.ripple_manager._ripple_effect._refresh_rate)
                 elif effect_func_name == 'setRippleRandomColour':
-                    effect_func(self.ripple_manager._ripple_thread._refresh_rate)
+                    effect_func(self.ripple_manager._ripple_effect._refresh_rate)
+
+    def get_frame_stats(self):
+        """
+        Get the frame pacing statistics of the ripple effect
+
+        :return: Dict of fps, target_fps, render_ms, submit_ms, frames and dropped
+        :rtype: dict
+        """
+        return self.ripple_manager.frame_stats
 
     def _close(self):
         super()._close()
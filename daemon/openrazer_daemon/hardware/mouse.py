@@ -459,7 +459,7 @@ class RazerNagaHexV2(__RazerDeviceBrightnessSuspend):
     def __init__(self, *args, **kwargs):
         super().__init__(*args, **kwargs)
 
-        # self.key_manager = _NagaHexV2KeyManager(self._device_number, self.event_files, self, use_epoll=True, testing=self._testing, should_grab_event_files=True)
+        # self.key_manager = _NagaHexV2KeyManager(self._device_number, self.event_files, self, testing=self._testing, should_grab_event_files=True)
 
     def _close(self):
         """
@@ -521,7 +521,7 @@ class RazerNagaChroma(__RazerDevice):
     def __init__(self, *args, **kwargs):
         super().__init__(*args, **kwargs)
 
-        # self.key_manager = _NagaHexV2KeyManager(self._device_number, self.event_files, self, use_epoll=True, testing=self._testing, should_grab_event_files=True)
+        # self.key_manager = _NagaHexV2KeyManager(self._device_number, self.event_files, self, testing=self._testing, should_grab_event_files=True)
 
     def _close(self):
         """
@@ -553,7 +553,7 @@ class RazerNagaTrinity(__RazerDevice):
     def __init__(self, *args, **kwargs):
         super().__init__(*args, **kwargs)
 
-        # self.key_manager = _NagaHexV2KeyManager(self._device_number, self.event_files, self, use_epoll=True, testing=self._testing, should_grab_event_files=True)
+        # self.key_manager = _NagaHexV2KeyManager(self._device_number, self.event_files, self, testing=self._testing, should_grab_event_files=True)
 
     def _close(self):
         """
@@ -4,7 +4,6 @@
 Module to handle custom colours
 """
 
-import struct
 import subprocess
 
 
@@ -401,27 +400,54 @@ class RGB(object):
 class KeyboardColour(object):
     """
     Keyboard class which represents the colour state of the keyboard.
+
+    The colours are kept in one bytearray laid out exactly as the driver's matrix_custom_frame
+    file takes them. Each row is the row ID, the start column and the end column followed by the
+    RGB bytes of every column, so the payloads are views of it rather than copies.
     """
+    ROW_HEADER_SIZE = 3
 
     def __init__(self, rows, columns):
         self.rows = rows
         self.columns = columns
 
-        # Two-dimensional array to hold color data
-        self.colors = []
+        self._row_size = self.ROW_HEADER_SIZE + columns * 3
+        self._buffer = bytearray(rows * self._row_size)
+        self._view = memoryview(self._buffer)
+
+        # Row headers never change
+        for row_id in range(0, self.rows):
+            offset = row_id * self._row_size
+            self._buffer[offset:offset + self.ROW_HEADER_SIZE] = bytes((row_id, 0x00, columns - 1))
 
         # Backup object (currently not used)
         self.backup = None
 
-        # Initialize array with empty values
-        self.reset_rows()
+    def _key_offset(self, row, col):
+        """
+        Get where a key's colour is in the buffer
+
+        :param row: Row ID
+        :type row: int
+
+        :param col: Column ID
+        :type col: int
+
+        :return: Offset of the red byte
+        :rtype: int
+
+        :raises KeyDoesNotExistError: If given key does not exist
+        """
+        if not (0 <= row < self.rows and 0 <= col < self.columns):
+            raise KeyDoesNotExistError("The key at row {0} column {1} does not exist".format(row, col))
+
+        return row * self._row_size + self.ROW_HEADER_SIZE + col * 3
 
     def backup_configuration(self):
         """
         Backs up the current configuration
         """
-        self.backup = KeyboardColour(self.rows, self.columns)
-        self.backup.get_from_total_binary(self.get_total_binary())
+        self.backup = bytes(self._buffer)
 
     def restore_configuration(self):
         """
@@ -430,27 +456,27 @@ class KeyboardColour(object):
         if self.backup is None:
             raise NoBackupError()
 
-        self.colors = self.backup.colors
+        self._buffer[:] = self.backup
         self.backup = None
 
     def get_rows_raw(self):
         """
         Gets the raw representation of the rows
 
-        :return: Rows
+        :return: Rows of RGB tuples
         :rtype: list
         """
-        return self.colors
+        return [[self.get_key_colour_at(row, col) for col in range(0, self.columns)] for row in range(0, self.rows)]
 
     def reset_rows(self):
         """
         Reset the rows of the keyboard
         """
-        self.colors.clear()
+        blank_row = bytes(self.columns * 3)
 
-        for row in range(0, self.rows):
-            # Create 22 rgb values
-            self.colors.append([RGB() for _ in range(0, self.columns)])
+        for row_id in range(0, self.rows):
+            offset = row_id * self._row_size + self.ROW_HEADER_SIZE
+            self._buffer[offset:offset + len(blank_row)] = blank_row
 
     def set_key_colour(self, row, col, colour):
         """
@@ -467,7 +493,26 @@ class KeyboardColour(object):
 
         :raises KeyDoesNotExistError: If given key does not exist
         """
-        self.colors[row][col].set(colour)
+        offset = self._key_offset(row, col)
+        self._buffer[offset:offset + 3] = bytes(map(RGB.clamp, colour))
+
+    def get_key_colour_at(self, row, col):
+        """
+        Get the colour of a key by position
+
+        :param row: Row ID
+        :type row: int
+
+        :param col: Column ID
+        :type col: int
+
+        :return: RGB tuple
+        :rtype: tuple
+
+        :raises KeyDoesNotExistError: If given key does not exist
+        """
+        offset = self._key_offset(row, col)
+        return tuple(self._buffer[offset:offset + 3])
 
     def get_key_colour(self, key):
         """
@@ -482,7 +527,7 @@ class KeyboardColour(object):
             raise KeyDoesNotExistError("The key \"{0}\" does not exist".format(key))
 
         row_id, col_id = KEY_MAPPING[key]
-        return self.colors[row_id][col_id].get()
+        return self.get_key_colour_at(row_id, col_id)
 
     def reset_key(self, row, col):
         """
@@ -496,7 +541,8 @@ class KeyboardColour(object):
 
         :raises KeyDoesNotExistError: If given key does not exist
         """
-        self.colors[row][col].set((0, 0, 0))
+        offset = self._key_offset(row, col)
+        self._buffer[offset:offset + 3] = b'\x00\x00\x00'
 
     def get_row_binary(self, row_id):
         """
@@ -505,49 +551,41 @@ class KeyboardColour(object):
         :param row_id: Row ID
         :type row_id: int
 
-        :return: Byte string of 67 bytes, Row ID byte then 22 RGB bytes
-        :rtype: bytearray
+        :return: Row ID, start and end column bytes then the RGB bytes of every column
+        :rtype: memoryview
         """
         assert isinstance(row_id, int), "Row ID is not an int"
 
-        payload = bytes([row_id, 0x00, len(self.colors[row_id]) - 1])
-
-        for rgb in self.colors[row_id]:
-            payload += bytes(rgb)
-
-        return payload
+        offset = row_id * self._row_size
+        return self._view[offset:offset + self._row_size]
 
     def get_total_binary(self):
         """
         Gets the binary payload for the whole keyboard
 
-        :return: Byte string of 6*67 bytes, (Row ID byte then 22 RGB bytes) * 6
-        :rtype: bytearray
-        """
-        payload = b''
-
-        for row in range(0, self.rows):
-            payload += self.get_row_binary(row)
+        The view tracks the colours, copy it with bytes() to keep a frame.
 
-        return payload
+        :return: Every row's payload one after the other
+        :rtype: memoryview
+        """
+        return self._view
 
     def get_from_total_binary(self, binary_blob):
         """
         Load in a binary blob which is the output from get_total_binary
 
         :param binary_blob: Binary blob
-        :type binary_blob: bytearray
+        :type binary_blob: bytes or bytearray or memoryview
+
+        :raises ValueError: If the blob isn't the size of this keyboard's payload
         """
-        self.reset_rows()
+        if len(binary_blob) != len(self._buffer):
+            raise ValueError("Expected {0} bytes, got {1}".format(len(self._buffer), len(binary_blob)))
 
         for row_id in range(0, self.rows):
-            binary_blob = binary_blob[1:]  # Skip first byte
-
-            for col_id, binary_rgb in enumerate([binary_blob[i:i + 3] for i in range(0, 66, 3)]):
-                rgb = struct.unpack('=BBB', binary_rgb)
-                self.colors[row_id][col_id].set(rgb)
-
-            binary_blob = binary_blob[66:]  # Skip the current row
+            offset = row_id * self._row_size + self.ROW_HEADER_SIZE
+            end = offset + self.columns * 3
+            self._buffer[offset:end] = binary_blob[offset:end]
 
 
 def get_keyboard_layout():
@@ -3,36 +3,122 @@
 """
 A class that writes persistence data to disk when device state is updated.
 
-Due to the architecture of the daemon, it's not as simple to know when
-something has changed, so for now, an interval will periodically check for
-changes in memory and write them to disk. This also avoids excessive
-writes when lots of variables change at once.
+Devices mark the zones they change, which arms a timer on the reactor. When it fires the
+changed devices are written to disk in one go on a thread of its own, so lots of variables
+changing at once only cause one write, nothing wakes up while nothing changes and a slow disk
+doesn't hold up the reactor.
 
 This is essential because many desktop environments actually kill off
 the daemon upon logout/shutdown, thereby persistence isn't retained across
-sessions.
+sessions. The daemon flushes on shutdown and suspend so changes still waiting
+on the timer aren't lost.
 
 A known issue is that this doesn't monitor DPI changes via hardware buttons,
 so this won't be persisted until the state is updated via the API.
 """
-import time
+import concurrent.futures
+import threading
+
+from openrazer_daemon.misc.reactor import get_reactor
 
 
 class PersistenceAutoSave(object):
-    def __init__(self, persistence, persistence_file, persistence_status, logger, interval, persistence_save_fn):
-        self.persistence = persistence
+    def __init__(self, persistence_file, logger, delay, persistence_save_fn):
+        """
+        :param persistence_file: Persistence file, nothing is saved if None
+        :type persistence_file: str or None
+
+        :param logger: Logger
+        :type logger: logging.Logger
+
+        :param delay: Seconds from the first change to the write
+        :type delay: float
+
+        :param persistence_save_fn: Called with the file and a dict of storage name to changed zones
+        :type persistence_save_fn: callable
+        """
         self.persistence_file = persistence_file
-        self.persistence_status = persistence_status
         self.persistence_save_fn = persistence_save_fn
         self.logger = logger
-        self.interval = interval
+        self.delay = delay
+
+        self._lock = threading.Lock()
+        self._changed = {}
+        self._timer = None
+        self._closed = False
+
+        self._executor = concurrent.futures.ThreadPoolExecutor(max_workers=1, thread_name_prefix='razer-persistence')
+
+    def mark_changed(self, storage_name, zone=None):
+        """
+        Note that part of a device's state changed and schedule a write
+
+        :param storage_name: Device's persistence section
+        :type storage_name: str
+
+        :param zone: Zone that changed, None for state of the whole device like DPI
+        :type zone: str or None
+        """
+        if not self.persistence_file:
+            return
+
+        with self._lock:
+            self._changed.setdefault(storage_name, set()).add(zone)
+            self._arm()
+
+    def _arm(self):
+        """
+        Arm the timer if it isn't already, called with the lock held
+        """
+        if self._timer is None and not self._closed:
+            self._timer = get_reactor().call_later(self.delay, self._flush_later)
+
+    def _flush_later(self):
+        """
+        Hand the write to the persistence thread, runs on the reactor
+        """
+        self._executor.submit(self.flush)
+
+    def flush(self):
+        """
+        Write the changes now if there are any
+
+        Blocks on the disk, so this is never called on the reactor.
+        """
+        with self._lock:
+            changed = self._changed
+            self._changed = {}
+
+            if self._timer is not None:
+                self._timer.cancel()
+                self._timer = None
+
+        if not changed:
+            return
+
+        self.logger.debug("State of %s changed, writing to disk", ', '.join(sorted(changed)))
+
+        try:
+            self.persistence_save_fn(self.persistence_file, changed)
+        except (OSError, RuntimeError) as err:
+            # RuntimeError is the device list or the config changing under the write
+            self.logger.warning("Failed to write persistence config, trying again later: %s", err)
+
+            with self._lock:
+                for storage_name, zones in changed.items():
+                    self._changed.setdefault(storage_name, set()).update(zones)
+                self._arm()
+
+    def close(self):
+        """
+        Stop the timer and wait for a write that's already running
 
-    def watch(self):
-        # Run indefinitely until process is terminated
-        while True:
-            time.sleep(self.interval)
+        Changes made after this are only written by a flush.
+        """
+        with self._lock:
+            self._closed = True
+            if self._timer is not None:
+                self._timer.cancel()
+                self._timer = None
 
-            if self.persistence_status["changed"]:
-                self.logger.debug("State recently changed, writing to disk")
-                self.persistence_status["changed"] = False
-                self.persistence_save_fn(self.persistence_file)
+        self._executor.shutdown(wait=True)
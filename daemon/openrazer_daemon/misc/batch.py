@@ -0,0 +1,91 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Calls to several devices sent in one DBus message
+
+Applying a scene otherwise takes a call per device, zone and setting, each a round trip through
+the bus. A batch is a list of (serial, interface, method, arguments) operations. The operations
+of a device run in order on its worker, while different devices run at the same time.
+"""
+import dbus
+
+from openrazer_daemon.dbus_services.service import reply_values, typed_value
+
+
+class Batch(object):
+    """
+    Batch of operations, grouped by device
+    """
+
+    def __init__(self, devices, operations, logger):
+        """
+        :param devices: Devices
+        :type devices: openrazer_daemon.device.DeviceCollection
+
+        :param operations: (serial, interface, method, arguments) tuples
+        :type operations: list of tuple
+
+        :param logger: Logger
+        :type logger: logging.Logger
+        """
+        self._devices = devices
+        self._logger = logger
+        self._cancelled = False
+        self._device_operations = {}
+
+        self.results = [(False, 'Not run before the timeout', []) for _ in operations]
+
+        for index, (serial, interface, method, args) in enumerate(operations):
+            try:
+                device = devices[str(serial)]
+            except IndexError:
+                self.results[index] = (False, 'No device with serial ' + str(serial), [])
+                continue
+
+            self._device_operations.setdefault(device, []).append((index, str(interface), str(method), list(args)))
+
+    def run(self, timeout):
+        """
+        Run the operations and wait for them
+
+        Operations not started by the deadline are dropped and reported as not run.
+
+        :param timeout: Seconds to wait
+        :type timeout: float
+
+        :return: (success, error, return values) for each operation
+        :rtype: list of tuple
+        """
+        self._devices.run('Batch', list(self._device_operations), self._run_device, timeout)
+        self._cancelled = True
+
+        return self.results
+
+    def _run_device(self, device):
+        for index, interface, method, args in self._device_operations[device]:
+            if self._cancelled:
+                return
+
+            self.results[index] = self._call(device, interface, method, args)
+
+    def _call(self, device, interface, method, args):
+        """
+        Call a DBus method of a device directly
+
+        :return: (success, error, return values)
+        :rtype: tuple
+        """
+        func = getattr(type(device.dbus), method, None)
+        if not getattr(func, '_dbus_is_method', False) or func._dbus_interface != interface:
+            return False, 'No method {0}.{1}'.format(interface, method), []
+
+        try:
+            values = reply_values(func._dbus_out_signature, func(device.dbus, *args))
+
+            if func._dbus_out_signature is not None:
+                values = [typed_value(signature, value) for signature, value in zip(dbus.Signature(func._dbus_out_signature), values)]
+        except Exception as err:  # pylint: disable=broad-except
+            self._logger.warning("Batch %s.%s on %s failed: %s", interface, method, device.serial, err)
+            return False, '{0}: {1}'.format(type(err).__name__, err), []
+
+        return True, '', list(values)
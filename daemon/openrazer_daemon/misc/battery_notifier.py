@@ -4,10 +4,11 @@
 This will do until I can be bothered to create indicator applet to do battery level
 """
 import logging
-import threading
-import datetime
 import time
 
+# pylint: disable=import-error
+from openrazer_daemon.misc.reactor import get_reactor
+
 try:
     import notify2
 except ImportError:
@@ -17,19 +18,26 @@ except ImportError:
 # TODO https://askubuntu.com/questions/110969/notify-send-ignores-timeout
 NOTIFY_TIMEOUT = 4000
 
+# Sometimes on wifi don't get batt, wait this long before asking again
+BATTERY_RETRY_DELAY = 0.2
+
 
-class BatteryNotifier(threading.Thread):
+class BatteryNotifier(object):
     """
-    Thread to notify about battery
+    Notify about battery every so often
+
+    The notifications are timers on the shared reactor, nothing runs in between them. The battery
+    level is read on the device's worker as it has to wait for the device.
     """
 
     def __init__(self, parent, device_id, device_name):
-        super().__init__()
         self._logger = logging.getLogger('razer.device{0}.batterynotifier'.format(device_id))
         self._notify2 = notify2 is not None
+        self._reactor = get_reactor()
+        self._timer = None
 
-        self.event = threading.Event()
-        self.frequency = 0
+        self._active = False
+        self._frequency = 0
         self.percent = 0
 
         if self._notify2:
@@ -42,87 +50,144 @@ class BatteryNotifier(threading.Thread):
         self._shutdown = False
         self._device_name = device_name
 
-        # Could save reference to parent but only need battery level function
+        # Could save reference to parent but only need battery level function and its worker
         self._get_battery_func = parent.getBattery
+        self._submit = parent.submit
 
         if self._notify2:
             self._notification = notify2.Notification(summary=device_name)
             self._notification.set_timeout(NOTIFY_TIMEOUT)
 
-        self._last_notify_time = datetime.datetime(1970, 1, 1)
+        self._last_notify_time = None
 
     @property
-    def shutdown(self):
+    def active(self):
         """
-        Get the shutdown flag
+        Are notifications enabled
         """
-        return self._shutdown
+        return self._active
 
-    @shutdown.setter
-    def shutdown(self, value):
+    @active.setter
+    def active(self, value):
         """
-        Set the shutdown flag
+        Enable or disable notifications
 
-        :param value: Shutdown
+        :param value: Active
         :type value: bool
         """
-        self._shutdown = value
+        self._active = value
+        self._reactor.call_soon(self._schedule)
 
-    def notify_battery(self):
-        now = datetime.datetime.now()
+    @property
+    def frequency(self):
+        """
+        Seconds between notifications
+        """
+        return self._frequency
 
-        if (now - self._last_notify_time).seconds > self.frequency:
-            # Update last notified
-            self._last_notify_time = now
+    @frequency.setter
+    def frequency(self, value):
+        """
+        Set the seconds between notifications
 
-            battery_level = self._get_battery_func()
-            battery_percent = int(round(battery_level, 0))
+        :param value: Frequency
+        :type value: int
+        """
+        self._frequency = value
+        self._reactor.call_soon(self._schedule)
 
-            # Sometimes on wifi don't get batt
-            if battery_level == -1.0:
-                time.sleep(0.2)
-                battery_level = self._get_battery_func()
+    def stop(self):
+        """
+        Stop notifying
+        """
+        self._shutdown = True
+        self._reactor.call_soon(self._schedule)
 
-            title = self._device_name
-            message = "Battery is {0}%".format(battery_percent)
-            icon = "battery-full"
+    def _schedule(self):
+        """
+        (Re)arm the timer for the next notification, runs on the reactor
+        """
+        if self._timer is not None:
+            self._timer.cancel()
+            self._timer = None
 
-            if battery_level == 0.0:
-                # Do nothing
-                pass
+        if self._shutdown or not self._active or self._frequency <= 0:
+            return
 
-            elif battery_level <= 10.0:
-                message = "Battery is low ({0}%). Please charge your device".format(battery_percent)
-                icon = "battery-empty"
+        if self._last_notify_time is None:
+            delay = 0
+        else:
+            delay = self._last_notify_time + self._frequency - time.monotonic()
 
-            elif battery_level <= 30.0:
-                icon = "battery-low"
+        self._timer = self._reactor.call_later(delay, self._request_battery)
 
-            elif battery_level <= 70.0:
-                icon = "battery-good"
+    def _request_battery(self, retry=True):
+        """
+        Hand reading the battery level to the device's worker, runs on the reactor
 
-            elif battery_level == 100.0:
-                message = "Battery is fully charged ({0}%)".format(battery_percent)
+        :param retry: Ask again shortly if the level couldn't be read
+        :type retry: bool
+        """
+        self._timer = None
+        self._submit('Battery notification', lambda: self.notify_battery(retry))
 
-            if self._notify2:
-                self._logger.debug("{0} Battery at {1}%".format(self._device_name, battery_percent))
+    def _retry(self):
+        """
+        Arm the timer to ask for the battery level again, runs on the reactor
+        """
+        if self._timer is not None:
+            self._timer.cancel()
 
-                if battery_level <= self.percent:
-                    self._notification.update(summary=title, message=message, icon=icon)
-                    self._notification.show()
+        self._timer = self._reactor.call_later(BATTERY_RETRY_DELAY, self._request_battery, False)
 
-    def run(self):
+    def notify_battery(self, retry=True):
         """
-        Main thread function
+        Read the battery level and show it, runs on the device's worker
+
+        :param retry: Ask again shortly if the level couldn't be read
+        :type retry: bool
         """
+        battery_level = self._get_battery_func()
+
+        # Sometimes on wifi don't get batt
+        if battery_level == -1.0 and retry:
+            self._reactor.call_soon(self._retry)
+            return
+
+        # Update last notified
+        self._last_notify_time = time.monotonic()
+
+        battery_percent = int(round(battery_level, 0))
 
-        while not self._shutdown:
-            if self.event.is_set() and self.frequency > 0:
-                self.notify_battery()
+        title = self._device_name
+        message = "Battery is {0}%".format(battery_percent)
+        icon = "battery-full"
 
-            time.sleep(0.1)
+        if battery_level == 0.0:
+            # Do nothing
+            pass
 
-        self._logger.debug("Shutting down battery notifier")
+        elif battery_level <= 10.0:
+            message = "Battery is low ({0}%). Please charge your device".format(battery_percent)
+            icon = "battery-empty"
+
+        elif battery_level <= 30.0:
+            icon = "battery-low"
+
+        elif battery_level <= 70.0:
+            icon = "battery-good"
+
+        elif battery_level == 100.0:
+            message = "Battery is fully charged ({0}%)".format(battery_percent)
+
+        if self._notify2:
+            self._logger.debug("{0} Battery at {1}%".format(self._device_name, battery_percent))
+
+            if battery_level <= self.percent:
+                self._notification.update(summary=title, message=message, icon=icon)
+                self._notification.show()
+
+        self._reactor.call_soon(self._schedule)
 
 
 class BatteryManager(object):
@@ -134,50 +199,43 @@ class BatteryManager(object):
         self._logger = logging.getLogger('razer.device{0}.batterymanager'.format(device_number))
         self._parent = parent
 
-        self._battery_thread = BatteryNotifier(parent, device_number, device_name)
-        self._battery_thread.start()
+        self._battery_notifier = BatteryNotifier(parent, device_number, device_name)
 
         self._is_closed = False
 
     def close(self):
         """
-        Close the manager, stop ripple thread
+        Close the manager, stop the notifications
         """
         if not self._is_closed:
             self._logger.debug("Closing Battery Manager")
             self._is_closed = True
 
-            self._battery_thread.shutdown = True
-            self._battery_thread.join(timeout=2)
-            if self._battery_thread.is_alive():
-                self._logger.error("Could not stop BatteryNotify thread")
+            self._battery_notifier.stop()
 
     def __del__(self):
         self.close()
 
     @property
     def active(self):
-        return self._battery_thread.event.is_set()
+        return self._battery_notifier.active
 
     @active.setter
     def active(self, value):
-        if value:
-            self._battery_thread.event.set()
-        else:
-            self._battery_thread.event.clear()
+        self._battery_notifier.active = value
 
     @property
     def frequency(self):
-        return self._battery_thread.frequency
+        return self._battery_notifier.frequency
 
     @frequency.setter
     def frequency(self, frequency):
-        self._battery_thread.frequency = frequency
+        self._battery_notifier.frequency = frequency
 
     @property
     def percent(self):
-        return self._battery_thread.percent
+        return self._battery_notifier.percent
 
     @percent.setter
     def percent(self, percent):
-        self._battery_thread.percent = percent
+        self._battery_notifier.percent = percent
@@ -0,0 +1,100 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Work out which parts of a custom frame payload change what the device shows
+
+A payload is what the driver's matrix_custom_frame file takes, rows of row ID, start column,
+stop column then the RGB bytes of every column in between.
+"""
+import numpy as np
+
+
+def diff_custom_frame(shown, known, payload, whole_rows=False):
+    """
+    Cut a payload down to the keys that change
+
+    Each row is cut down to the span between the first and last key that changed and rows
+    without changes are left out. With whole_rows a row that changed is kept as it is, for
+    drivers that ignore the start column.
+
+    :param shown: Colours last sent for every key, shape (rows, columns, 3)
+    :type shown: numpy.ndarray
+
+    :param known: Whether the colour in shown is on the device, shape (rows, columns)
+    :type known: numpy.ndarray
+
+    :param payload: Custom frame payload
+    :type payload: bytes
+
+    :param whole_rows: Don't cut rows down
+    :type whole_rows: bool
+
+    :return: Row ID, start column and colours of every span to write, None if the payload doesn't fit the matrix
+    :rtype: list or None
+    """
+    rows, columns = known.shape
+    data = np.frombuffer(payload, dtype=np.uint8)
+    spans = []
+    offset = 0
+
+    while offset < len(data):
+        if offset + 3 > len(data):
+            return None
+        row_id, start_col, stop_col = (int(value) for value in data[offset:offset + 3])
+        end = offset + 3 + (stop_col + 1 - start_col) * 3
+        if row_id >= rows or start_col > stop_col or stop_col >= columns or end > len(data):
+            return None
+
+        colours = data[offset + 3:end].reshape(-1, 3)
+        offset = end
+
+        changed = (colours != shown[row_id, start_col:stop_col + 1]).any(axis=1)
+        changed |= ~known[row_id, start_col:stop_col + 1]
+        changed_cols = np.flatnonzero(changed)
+        if len(changed_cols) == 0:
+            continue
+
+        if whole_rows:
+            spans.append((row_id, start_col, colours))
+        else:
+            first, last = int(changed_cols[0]), int(changed_cols[-1])
+            spans.append((row_id, start_col + first, colours[first:last + 1]))
+
+    return spans
+
+
+def span_payload(row_id, start_col, colours):
+    """
+    Build the payload for one span
+
+    :param row_id: Row ID
+    :type row_id: int
+
+    :param start_col: First column
+    :type start_col: int
+
+    :param colours: RGB colour of every column, shape (n, 3)
+    :type colours: numpy.ndarray
+
+    :return: Payload
+    :rtype: bytes
+    """
+    return bytes((row_id, start_col, start_col + len(colours) - 1)) + colours.tobytes()
+
+
+def apply_spans(shown, known, spans):
+    """
+    Remember the spans as shown once they are written
+
+    :param shown: Colours last sent for every key, shape (rows, columns, 3)
+    :type shown: numpy.ndarray
+
+    :param known: Whether the colour in shown is on the device, shape (rows, columns)
+    :type known: numpy.ndarray
+
+    :param spans: Spans from diff_custom_frame()
+    :type spans: list
+    """
+    for row_id, start_col, colours in spans:
+        shown[row_id, start_col:start_col + len(colours)] = colours
+        known[row_id, start_col:start_col + len(colours)] = True
@@ -0,0 +1,146 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Run work on several devices at once
+
+Syncing an effect, suspending or resuming touches every device, and every device does blocking
+driver writes which take tens of milliseconds on wireless devices. Done one after another the
+caller waits for the sum of them, here it waits for the slowest one.
+"""
+import concurrent.futures
+import logging
+import threading
+import time
+
+
+class DeviceExecutor(object):
+    """
+    Runs work for a group of devices concurrently
+
+    Every device gets a worker thread of its own, so work for one device still happens in the
+    order it was submitted.
+    """
+
+    def __init__(self):
+        self._logger = logging.getLogger('razer.executor')
+        self._lock = threading.Lock()
+        self._workers = {}
+        self._local = threading.local()
+
+    def _get_worker(self, device):
+        with self._lock:
+            worker = self._workers.get(device)
+            if worker is None:
+                worker = concurrent.futures.ThreadPoolExecutor(
+                    max_workers=1, thread_name_prefix='razer-{0}'.format(device.device_id),
+                    initializer=self._set_current, initargs=(device,))
+                self._workers[device] = worker
+
+            return worker
+
+    def _set_current(self, device):
+        self._local.device = device
+
+    def run(self, name, devices, func, timeout):
+        """
+        Call func for every device and wait for them all to finish
+
+        Devices that haven't finished by the deadline are logged and left to finish on their own.
+        When called from a device's worker the work is only queued, two devices waiting on each
+        other's workers would otherwise both sit out the timeout.
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param devices: Devices
+        :type devices: list of openrazer_daemon.device.Device
+
+        :param func: Called with the device
+        :type func: callable
+
+        :param timeout: Seconds to wait
+        :type timeout: float
+        """
+        start = time.monotonic()
+        futures = {}
+
+        for device in devices:
+            # Queueing onto our own worker and waiting would never finish
+            if getattr(self._local, 'device', None) is device:
+                self._call(name, device, func)
+            else:
+                futures[self._get_worker(device).submit(self._call, name, device, func)] = device
+
+        if not futures or self.in_worker():
+            return
+
+        _, not_done = concurrent.futures.wait(futures, timeout=timeout)
+
+        for future in not_done:
+            self._logger.warning("%s on %s didn't finish within %.1fs", name, futures[future].device_id, timeout)
+
+        self._logger.debug("%s on %d devices took %.1fms", name, len(futures), (time.monotonic() - start) * 1000)
+
+    def submit(self, name, device, func):
+        """
+        Queue func on the worker of a device without waiting for it
+
+        Called from the device's own worker it runs straight away, after the work in progress it
+        would have been queued behind anyway.
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param device: Device
+        :type device: openrazer_daemon.device.Device
+
+        :param func: Called with the device
+        :type func: callable
+        """
+        if getattr(self._local, 'device', None) is device:
+            self._call(name, device, func)
+        else:
+            self._get_worker(device).submit(self._call, name, device, func)
+
+    def in_worker(self):
+        """
+        Check if the calling thread is one of the device workers
+
+        :return: True if it's a device worker
+        :rtype: bool
+        """
+        return getattr(self._local, 'device', None) is not None
+
+    def _call(self, name, device, func):
+        start = time.monotonic()
+
+        try:
+            func(device)
+        except Exception:
+            self._logger.exception("%s on %s failed", name, device.device_id)
+
+        self._logger.debug("%s on %s took %.1fms", name, device.device_id, (time.monotonic() - start) * 1000)
+
+    def remove(self, device):
+        """
+        Stop the worker of a device, once its queued work is done
+
+        :param device: Device
+        :type device: openrazer_daemon.device.Device
+        """
+        with self._lock:
+            worker = self._workers.pop(device, None)
+
+        if worker is not None:
+            worker.shutdown(wait=False)
+
+    def shutdown(self):
+        """
+        Stop all workers, once their queued work is done
+        """
+        with self._lock:
+            workers = list(self._workers.values())
+            self._workers.clear()
+
+        for worker in workers:
+            worker.shutdown(wait=False)
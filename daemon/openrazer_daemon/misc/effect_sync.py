@@ -5,6 +5,153 @@ Class to manage syncing of effects
 """
 import inspect
 import logging
+import threading
+
+# Zones of the devices with more than the backlight, in the order they're synced
+ZONE_PREFIXES = ('Scroll', 'Logo', 'Left', 'Right', 'Backlight')
+
+# Effects like pulsate don't carry a colour, devices that need one get green
+DEFAULT_COLOUR = (0x00, 0xFF, 0x00)
+
+
+def _pass_args(args):
+    return args
+
+
+def _no_args(args):
+    return ()
+
+
+def _default_colour(args):
+    return DEFAULT_COLOUR
+
+
+def _zone_effects(effect, adapter, zones=ZONE_PREFIXES):
+    return tuple(('set' + zone + effect, adapter) for zone in zones)
+
+
+# Similar effects to run when the device doesn't have the effect that was synced. Methods the
+# device doesn't have are left out when the dispatch table is built.
+FALLBACK_EFFECTS = {
+    'setPulsate': (('setBreathSingle', _default_colour),) +
+    _zone_effects('BreathSingle', _default_colour, ('Scroll', 'Logo', 'Left', 'Right')) +
+    _zone_effects('Pulsate', _default_colour, ('Scroll', 'Logo', 'Backlight')),
+    'setSpectrum': _zone_effects('Spectrum', _no_args),
+    'setStatic': _zone_effects('Static', _pass_args),
+    'setWave': _zone_effects('Wave', _pass_args),
+    'setReactive': _zone_effects('Reactive', _pass_args),
+    'setBreathRandom': (('setPulsate', _no_args),) +
+    _zone_effects('Pulsate', _default_colour, ('Scroll', 'Logo', 'Backlight')) +
+    _zone_effects('BreathRandom', _pass_args),
+    'setBreathSingle': (('setPulsate', _no_args),) +
+    _zone_effects('Pulsate', _default_colour, ('Scroll', 'Logo', 'Backlight')) +
+    _zone_effects('BreathSingle', _pass_args),
+    'setBreathDual': _zone_effects('BreathDual', _pass_args),
+    'setBrightness': _zone_effects('Brightness', _pass_args),
+}
+
+
+class EffectDispatchTable(object):
+    """
+    How a device class runs every effect another device can sync
+
+    Built once per class after its DBus methods are loaded, so syncing an effect is a dict
+    lookup followed by direct calls instead of attribute lookups and signature inspection.
+    """
+
+    def __init__(self, device_class):
+        """
+        :param device_class: Device class, with its DBus methods loaded
+        :type device_class: type
+        """
+        # Effect name to the unbound method and how many arguments it takes
+        self.methods = {}
+        for name in dir(device_class):
+            func = getattr(device_class, name, None)
+            if name.startswith('set') and inspect.isfunction(func):
+                self.methods[name] = (func, EffectSync.get_num_arguments(func) - 1)
+
+        self._plans = {}
+        for effect_name in set(self.methods) | set(FALLBACK_EFFECTS):
+            self._plans[effect_name] = self._build_plan(effect_name)
+
+    def plan(self, effect_name):
+        """
+        Get the calls that run an effect
+
+        Each call is an unbound method and an adapter, which turns the synced arguments into
+        the method's arguments, or None when the method can't take them.
+
+        :param effect_name: Name of the effect
+        :type effect_name: str
+
+        :return: Tuple of (unbound method, argument adapter)
+        :rtype: tuple
+        """
+        plan = self._plans.get(effect_name)
+        if plan is None:
+            # An effect only some other device class has
+            plan = self._plans[effect_name] = self._build_plan(effect_name)
+        return plan
+
+    def _build_plan(self, effect_name):
+        if effect_name in self.methods:
+            effect_func, num_args = self.methods[effect_name]
+            if effect_name == 'setStatic' and num_args == 0:
+                # Chroma -> BW
+                return ((effect_func, _no_args),)
+            elif effect_name == 'setStatic':
+                # BW -> Chroma, when the argument counts don't match
+                return ((effect_func, lambda args: args if len(args) == num_args else DEFAULT_COLOUR),)
+            # Same method with the wrong arguments, nothing similar to run instead
+            return ((effect_func, lambda args: args if len(args) == num_args else None),)
+
+        # setNone sets active to false and needs to be re-enabled for effects to show
+        if effect_name == 'setNone':
+            plan = _zone_effects('None', _no_args)
+        else:
+            plan = _zone_effects('Active', lambda args: (True,))
+
+        # The device doesn't have the effect, use similar ones
+        plan += FALLBACK_EFFECTS.get(effect_name, ())
+
+        return tuple((self.methods[name][0], adapter) for name, adapter in plan if name in self.methods)
+
+
+_DISPATCH_TABLES = {}
+_DISPATCH_TABLES_LOCK = threading.Lock()
+
+
+def build_dispatch_table(device_class):
+    """
+    Build the dispatch table of a device class, replacing any earlier one
+
+    :param device_class: Device class, with its DBus methods loaded
+    :type device_class: type
+
+    :return: Dispatch table
+    :rtype: EffectDispatchTable
+    """
+    table = EffectDispatchTable(device_class)
+    with _DISPATCH_TABLES_LOCK:
+        _DISPATCH_TABLES[device_class] = table
+    return table
+
+
+def get_dispatch_table(device_class):
+    """
+    Get the dispatch table of a device class, building it if needed
+
+    :param device_class: Device class
+    :type device_class: type
+
+    :return: Dispatch table
+    :rtype: EffectDispatchTable
+    """
+    table = _DISPATCH_TABLES.get(device_class)
+    if table is None:
+        table = build_dispatch_table(device_class)
+    return table
 
 
 class EffectSync(object):
@@ -56,257 +203,10 @@ class EffectSync(object):
         self._parent.disable_notify = True
 
         try:
-            # Does parent have method
-            effect_func = getattr(self._parent, effect_name, None)
-            if effect_func is not None:
-                # We have method, does it have the correct num arguments
-                actual_args = self.get_num_arguments(effect_func)
-                if actual_args == len(args):
-                    # method should be same
-                    effect_func(*args)
-                else:
-                    # Method same but wrong args, try alternatives
-                    if effect_name == 'setStatic':
-                        # Could be static from chroma to non chroma
-                        if actual_args == 0:
-                            # Chroma -> BW
-                            effect_func()
-                        else:
-                            # BW -> Chroma
-                            effect_func(0x0, 0xFF, 0x00)  # Green
-
-            else:
-                # setNone sets active to false and needs to be re-enabled for effects to show - maybe a bit inefficient
-                if not effect_name == 'setNone':
-                    effect_func = getattr(self._parent, 'setScrollActive', None)
-                    if effect_func is not None:
-                        effect_func(True)
-                    effect_func = getattr(self._parent, 'setLogoActive', None)
-                    if effect_func is not None:
-                        effect_func(True)
-                    effect_func = getattr(self._parent, 'setLeftActive', None)
-                    if effect_func is not None:
-                        effect_func(True)
-                    effect_func = getattr(self._parent, 'setRightActive', None)
-                    if effect_func is not None:
-                        effect_func(True)
-                    effect_func = getattr(self._parent, 'setBacklightActive', None)
-                    if effect_func is not None:
-                        effect_func(True)
-                else:
-                    effect_func = getattr(self._parent, 'setScrollNone', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setLogoNone', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setLeftNone', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setRightNone', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setBacklightNone', None)
-                    if effect_func is not None:
-                        effect_func()
-
-                # The target device doesn't have these methods, use similar ones
-
-                if effect_name == 'setPulsate':
-                    # setPulsate doesn't provide a color but we need one, take green.
-                    pargs = (0x00, 0xFF, 0x00)  # Green
-                    effect_func = getattr(self._parent, 'setBreathSingle', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-                    effect_func = getattr(self._parent, 'setScrollBreathSingle', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-                    effect_func = getattr(self._parent, 'setLogoBreathSingle', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-                    effect_func = getattr(self._parent, 'setLeftBreathSingle', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-                    effect_func = getattr(self._parent, 'setRightBreathSingle', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-                    effect_func = getattr(self._parent, 'setScrollPulsate', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-                    effect_func = getattr(self._parent, 'setLogoPulsate', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-                    effect_func = getattr(self._parent, 'setBacklightPulsate', None)
-                    if effect_func is not None:
-                        effect_func(*pargs)
-
-                elif effect_name == 'setSpectrum':
-                    effect_func = getattr(self._parent, 'setScrollSpectrum', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setLogoSpectrum', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setLeftSpectrum', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setRightSpectrum', None)
-                    if effect_func is not None:
-                        effect_func()
-                    effect_func = getattr(self._parent, 'setBacklightSpectrum', None)
-                    if effect_func is not None:
-                        effect_func()
-
-                elif effect_name == 'setStatic':
-                    effect_func = getattr(self._parent, 'setScrollStatic', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLogoStatic', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLeftStatic', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setRightStatic', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setBacklightStatic', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-
-                elif effect_name == 'setWave':
-                    effect_func = getattr(self._parent, 'setScrollWave', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLogoWave', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLeftWave', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setRightWave', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setBacklightWave', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-
-                elif effect_name == 'setReactive':
-                    effect_func = getattr(self._parent, 'setScrollReactive', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLogoReactive', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLeftReactive', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setRightReactive', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setBacklightReactive', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-
-                elif effect_name in ('setBreathRandom', 'setBreathSingle', 'setBreathDual', 'setBreathTriple'):
-                    if effect_name in ('setBreathRandom', 'setBreathSingle'):
-                        pargs = (0x00, 0xFF, 0x00)  # Green
-                    else:
-                        pargs = args[0:3]  # limit args to first 3, as setBreathDual gives 6 args and setBreathTriple gives 9 args
-
-                    if effect_name == 'setBreathRandom':
-                        effect_func = getattr(self._parent, 'setPulsate', None)
-                        if effect_func is not None:
-                            # setPulsate doesn't take any argument
-                            effect_func()
-                        effect_func = getattr(self._parent, 'setScrollPulsate', None)
-                        if effect_func is not None:
-                            effect_func(*pargs)
-                        effect_func = getattr(self._parent, 'setLogoPulsate', None)
-                        if effect_func is not None:
-                            effect_func(*pargs)
-                        effect_func = getattr(self._parent, 'setBacklightPulsate', None)
-                        if effect_func is not None:
-                            effect_func(*pargs)
-
-                        effect_func = getattr(self._parent, 'setScrollBreathRandom', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setLogoBreathRandom', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setLeftBreathRandom', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setRightBreathRandom', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setBacklightBreathRandom', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-
-                    if effect_name == 'setBreathSingle':
-                        if effect_func is not None:
-                            effect_func(*pargs)
-                        effect_func = getattr(self._parent, 'setScrollPulsate', None)
-                        if effect_func is not None:
-                            effect_func(*pargs)
-                        effect_func = getattr(self._parent, 'setLogoPulsate', None)
-                        if effect_func is not None:
-                            effect_func(*pargs)
-                        effect_func = getattr(self._parent, 'setBacklightPulsate', None)
-                        if effect_func is not None:
-                            effect_func(*pargs)
-
-                        effect_func = getattr(self._parent, 'setScrollBreathSingle', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setLogoBreathSingle', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setLeftBreathSingle', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setRightBreathSingle', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setBacklightBreathSingle', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-
-                    if effect_name == 'setBreathDual':
-                        effect_func = getattr(self._parent, 'setScrollBreathDual', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setLogoBreathDual', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setLeftBreathDual', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setRightBreathDual', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-                        effect_func = getattr(self._parent, 'setBacklightBreathDual', None)
-                        if effect_func is not None:
-                            effect_func(*args)
-
-                elif effect_name == 'setBrightness':
-                    effect_func = getattr(self._parent, 'setScrollBrightness', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLogoBrightness', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setLeftBrightness', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setRightBrightness', None)
-                    if effect_func is not None:
-                        effect_func(*args)
-                    effect_func = getattr(self._parent, 'setBacklightBrightness', None)
-                    if effect_func is not None:
-                        effect_func(*args)
+            for effect_func, adapter in get_dispatch_table(type(self._parent)).plan(effect_name):
+                effect_args = adapter(args)
+                if effect_args is not None:
+                    effect_func(self._parent, *effect_args)
 
         except Exception as err:
             self._logger.exception("Caught exception trying to sync effects.", exc_info=err)
@@ -319,11 +219,14 @@ class EffectSync(object):
         """
         Get number of arguments in a function
 
+        DBus methods are counted as the function they wrap, without dbus-python's reply and
+        error callbacks.
+
         :param func: Function
         :type func: callable
 
         :return: Number of arguments
         :rtype: int
         """
-        func_sig = inspect.signature(func)
+        func_sig = inspect.signature(inspect.unwrap(func))
         return len(func_sig.parameters)
@@ -0,0 +1,217 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Shared memory channel for custom frames
+
+Instead of sending every frame over D-Bus with setKeyRow and setCustom, a client can ask for a
+frame channel. It gets a memfd holding a header and two frame buffers, and the write end of a
+pipe to say a frame is ready. The daemon picks the frame up on the reactor and writes it to the
+driver on the device's worker, so the bus is only used to set the channel up. While a write is
+in progress only the newest frame is kept, older ones are dropped.
+
+Layout of the memfd, all little endian:
+    0   4s  magic b'RZFB'
+    4   u16 version
+    6   u16 header size, the first buffer starts here
+    8   u32 frame size, a frame is matrix_custom_frame's payload for the whole matrix
+    12  u16 rows
+    14  u16 columns
+    16  u32 front buffer, index of the last buffer published
+    20  u32 sequence of buffer 0
+    24  u32 sequence of buffer 1
+    28  u32 frames the daemon has picked up
+
+The client writes into the buffer that isn't the front one. Its sequence is made odd while the
+client writes and even once it's done, then the front index is updated and a byte is written to
+the pipe. The daemon copies the front buffer and only uses it if its sequence was even and
+didn't change during the copy.
+"""
+import logging
+import mmap
+import os
+import select
+import struct
+import threading
+
+from openrazer_daemon.misc.reactor import get_reactor
+
+FRAME_CHANNEL_MAGIC = b'RZFB'
+FRAME_CHANNEL_VERSION = 1
+FRAME_CHANNEL_HEADER_FORMAT = '<4sHHIHH'
+FRAME_CHANNEL_HEADER_SIZE = 64
+
+FRONT_OFFSET = 16
+SEQUENCE_OFFSET = 20
+CONSUMED_OFFSET = 28
+
+# Give up on a frame if the client keeps overwriting it while it's being copied
+READ_ATTEMPTS = 3
+
+
+class FrameChannel(object):
+    """
+    Daemon end of a frame channel
+    """
+
+    def __init__(self, device_number, rows, columns, frame_callback, submit):
+        """
+        :param device_number: Device number, for logging
+        :type device_number: int
+
+        :param rows: Matrix rows
+        :type rows: int
+
+        :param columns: Matrix columns
+        :type columns: int
+
+        :param frame_callback: Called on the device's worker with the payload of a new frame
+        :type frame_callback: callable
+
+        :param submit: Queues blocking work on the device's worker, called with a name and a function
+        :type submit: callable
+        """
+        self._logger = logging.getLogger('razer.device{0}.framechannel'.format(device_number))
+        self._reactor = get_reactor()
+        self._frame_callback = frame_callback
+        self._submit = submit
+
+        self.frame_size = rows * (3 + columns * 3)
+        size = FRAME_CHANNEL_HEADER_SIZE + 2 * self.frame_size
+
+        self.memfd = os.memfd_create('openrazer-frames', os.MFD_CLOEXEC)
+        os.ftruncate(self.memfd, size)
+        self._mmap = mmap.mmap(self.memfd, size)
+
+        struct.pack_into(FRAME_CHANNEL_HEADER_FORMAT, self._mmap, 0, FRAME_CHANNEL_MAGIC, FRAME_CHANNEL_VERSION,
+                         FRAME_CHANNEL_HEADER_SIZE, self.frame_size, rows, columns)
+
+        self._signal_read, self.signal_fd = os.pipe2(os.O_NONBLOCK | os.O_CLOEXEC)
+
+        self._last_frame = None
+        self._closed = False
+
+        # Newest frame waiting for the worker, and whether a write is queued or running
+        self._pending_lock = threading.Lock()
+        self._pending_frame = None
+        self._writing = False
+
+        self._reactor.add_reader(self._signal_read, self._on_signal)
+
+    def release_client_fds(self):
+        """
+        Close the daemon's copies of the fds handed to the client
+
+        The mapping stays valid, and once the client closes its end of the pipe the channel
+        closes itself.
+        """
+        os.close(self.memfd)
+        os.close(self.signal_fd)
+        self.memfd = self.signal_fd = None
+
+    def close(self):
+        """
+        Close the channel
+        """
+        self._reactor.call_soon(self._close)
+
+    def _close(self):
+        if self._closed:
+            return
+        self._closed = True
+
+        self._reactor.remove_reader(self._signal_read)
+        os.close(self._signal_read)
+        if self.memfd is not None:
+            self.release_client_fds()
+        self._mmap.close()
+
+    def _buffer_offset(self, index):
+        return FRAME_CHANNEL_HEADER_SIZE + index * self.frame_size
+
+    def _read_frame(self):
+        """
+        Copy the front buffer if the client isn't writing to it
+
+        :return: Buffer index and sequence, and the frame or None
+        :rtype: tuple
+        """
+        for _ in range(READ_ATTEMPTS):
+            front, = struct.unpack_from('<I', self._mmap, FRONT_OFFSET)
+            front &= 1
+            sequence_offset = SEQUENCE_OFFSET + front * 4
+
+            sequence, = struct.unpack_from('<I', self._mmap, sequence_offset)
+            if sequence & 1:
+                continue
+
+            offset = self._buffer_offset(front)
+            frame = self._mmap[offset:offset + self.frame_size]
+
+            if struct.unpack_from('<I', self._mmap, sequence_offset)[0] == sequence:
+                return (front, sequence), frame
+
+        return None, None
+
+    def _on_signal(self, mask):
+        """
+        A frame is ready, or the client went away
+        """
+        try:
+            data = os.read(self._signal_read, 4096)
+        except BlockingIOError:
+            data = None
+
+        if data:
+            self._send_frame()
+
+        # Empty read is the client closing its end of the pipe
+        if data == b'' or mask & (select.EPOLLHUP | select.EPOLLERR):
+            self._logger.debug("Frame channel client went away")
+            self._close()
+
+    def _send_frame(self):
+        """
+        Hand the front buffer to the worker if it's a new frame
+        """
+        frame_id, frame = self._read_frame()
+        if frame is None or frame_id == self._last_frame:
+            return
+        self._last_frame = frame_id
+
+        with self._pending_lock:
+            self._pending_frame = frame
+            if self._writing:
+                return
+            self._writing = True
+
+        self._submit('Frame channel', self._write_frames)
+
+    def _write_frames(self):
+        """
+        Write the newest frame until no new one came in meanwhile, runs on the device's worker
+        """
+        while True:
+            with self._pending_lock:
+                frame = self._pending_frame
+                self._pending_frame = None
+                if frame is None:
+                    self._writing = False
+                    return
+
+            try:
+                self._frame_callback(frame)
+            except OSError as err:
+                self._logger.warning("Failed to send frame: %s", err)
+                continue
+
+            self._reactor.call_soon(self._frame_consumed)
+
+    def _frame_consumed(self):
+        """
+        Count a frame written to the driver, so the client can see the daemon keeping up
+        """
+        if self._closed:
+            return
+
+        consumed, = struct.unpack_from('<I', self._mmap, CONSUMED_OFFSET)
+        struct.pack_into('<I', self._mmap, CONSUMED_OFFSET, (consumed + 1) & 0xFFFFFFFF)
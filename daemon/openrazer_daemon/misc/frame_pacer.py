@@ -0,0 +1,121 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Frame pacing for the software effects
+"""
+import time
+
+# Weight of the newest sample in the running averages
+EWMA_ALPHA = 0.1
+
+
+class FramePacer(object):
+    """
+    Paces a render loop against absolute deadlines on the monotonic clock
+
+    Deadlines are a fixed interval apart, so time spent rendering and writing to the device
+    doesn't stretch the frame. When a frame overruns its deadline the deadlines that were
+    missed are skipped and counted as dropped instead of being caught up on.
+    """
+
+    def __init__(self, interval, clock=time.monotonic):
+        self.interval = interval
+
+        self._clock = clock
+
+        self._deadline = None
+        self._frame_start = None
+        self._last_frame_start = None
+
+        self.frames = 0
+        self.dropped = 0
+        self.fps = 0.0
+        self.render_time = 0.0
+        self.submit_time = 0.0
+
+    def reset(self):
+        """
+        Forget the deadline, the next frame starts a new schedule
+
+        Used when the effect pauses so the idle time isn't counted as dropped frames.
+        """
+        self._deadline = None
+        self._last_frame_start = None
+
+    def start_frame(self):
+        """
+        Mark the start of a frame
+        """
+        self._frame_start = self._clock()
+
+        if self._last_frame_start is not None:
+            elapsed = self._frame_start - self._last_frame_start
+            if elapsed > 0:
+                self.fps = self._average(self.fps, 1.0 / elapsed)
+        self._last_frame_start = self._frame_start
+
+        if self._deadline is None:
+            self._deadline = self._frame_start
+
+    def rendered(self):
+        """
+        Mark the end of rendering and the start of the device write
+        """
+        now = self._clock()
+        self.render_time = self._average(self.render_time, now - self._frame_start)
+        self._frame_start = now
+
+    def submitted(self):
+        """
+        Mark the end of the device write
+        """
+        self.submit_time = self._average(self.submit_time, self._clock() - self._frame_start)
+        self.frames += 1
+
+    def next_delay(self):
+        """
+        Advance to the next deadline, skipping the ones already missed
+
+        :return: Seconds until the next frame is due
+        :rtype: float
+        """
+        now = self._clock()
+
+        if self.interval <= 0:
+            return 0
+
+        if self._deadline is None:
+            self._deadline = now
+
+        self._deadline += self.interval
+
+        if now > self._deadline:
+            missed = int((now - self._deadline) // self.interval) + 1
+            self.dropped += missed
+            self._deadline += missed * self.interval
+
+        return self._deadline - now
+
+    def stats(self):
+        """
+        Get the frame statistics
+
+        Times are in milliseconds, averaged over the last frames.
+
+        :return: Dict of fps, target_fps, render_ms, submit_ms, frames and dropped
+        :rtype: dict
+        """
+        return {
+            'fps': self.fps,
+            'target_fps': 1.0 / self.interval if self.interval > 0 else 0.0,
+            'render_ms': self.render_time * 1000,
+            'submit_ms': self.submit_time * 1000,
+            'frames': float(self.frames),
+            'dropped': float(self.dropped),
+        }
+
+    @staticmethod
+    def _average(current, sample):
+        if current == 0.0:
+            return sample
+        return current + EWMA_ALPHA * (sample - current)
@@ -14,7 +14,6 @@ Each event is in the format of
 * unsigned short code
 * signed int value
 """
-import datetime
 import fcntl
 import json
 import logging
@@ -25,17 +24,30 @@ import struct
 import threading
 import time
 
+import numpy as np
+
 # pylint: disable=import-error
 from openrazer_daemon.keyboard import KEY_MAPPING, TARTARUS_KEY_MAPPING, EVENT_MAPPING, TARTARUS_EVENT_MAPPING, NAGA_HEX_V2_EVENT_MAPPING, NAGA_HEX_V2_KEY_MAPPING, ORBWEAVER_EVENT_MAPPING, ORBWEAVER_KEY_MAPPING
+from openrazer_daemon.misc.reactor import get_reactor
 from .macro import MacroKey, MacroRunner, macro_dict_to_obj
 
-EVENT_FORMAT = '@llHHI'
-EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+# struct input_event: seconds, microseconds, type, code, value, in native layout
+EVENT_DTYPE = np.dtype([('sec', 'l'), ('usec', 'l'), ('type', 'H'), ('code', 'H'), ('value', 'I')], align=True)
+EVENT_SIZE = EVENT_DTYPE.itemsize
 
-EPOLL_TIMEOUT = 0.01
-SPIN_SLEEP = 0.01
+# The kernel only hands out whole records, read up to this many per syscall
+EVENT_READ_COUNT = 64
 
 EVIOCGRAB = 0x40044590
+EVIOCSCLOCKID = 0x400445a0
+
+EV_KEY = 0x01  # input-event-codes.h
+KEY_ACTIONS = ('release', 'press', 'autorepeat')
+
+# How long keypresses stay in the temporary key store, in nanoseconds
+TEMP_KEY_EXPIRE_NS = 2 * 1000000000
+# Most keypresses the temporary key store holds, older ones are overwritten
+TEMP_KEY_CAPACITY = 128
 
 COLOUR_CHOICES = (
     (255, 0, 0),    # Red
@@ -66,152 +78,220 @@ def random_colour_picker(last_choice, iterable):
     return result
 
 
-class KeyWatcher(threading.Thread):
+class KeyEventRing(object):
     """
-    Thread to watch keyboard event files and return keypresses
+    Fixed size ring buffer of recent keypresses
+
+    Holds the time, row, column and colour of each keypress in numpy arrays. Every entry is
+    written twice, capacity apart, so any run of live entries is one contiguous slice and
+    readers get views into the arrays instead of copies.
+
+    There is one writer which only moves the head and one reader which only moves the tail,
+    expiring an entry is just moving the tail past it.
     """
-    @staticmethod
-    def parse_event_record(data):
-        """
-        Parse Input event record
 
-        :param data: Binary data
-        :type data: bytes
+    def __init__(self, capacity=TEMP_KEY_CAPACITY, lifetime=TEMP_KEY_EXPIRE_NS):
+        self.capacity = capacity
+        self.lifetime = lifetime
 
-        :return: Tuple of event time, key_action, key_code
-        :rtype: tuple
-        """
-        # Event Seconds, Event Microseconds, Event Type, Event Code, Event Value
-        ev_sec, ev_usec, ev_type, ev_code, ev_value = struct.unpack(EVENT_FORMAT, data)
+        self.times = np.zeros(capacity * 2, dtype=np.int64)
+        self.rows = np.zeros(capacity * 2, dtype=np.intp)
+        self.cols = np.zeros(capacity * 2, dtype=np.intp)
+        self.colours = np.zeros((capacity * 2, 3), dtype=np.uint8)
 
-        if ev_type != 0x01:  # input-event-codes.h EV_KEY 0x01
-            return None, None, None
+        # Total entries ever written and expired, the slot is the count modulo capacity
+        self._head = 0
+        self._tail = 0
 
-        if ev_value == 0:
-            key_action = 'release'
-        elif ev_value == 1:
-            key_action = 'press'
-        elif ev_value == 2:
-            key_action = 'autorepeat'
-        else:
-            key_action = 'unknown'
+    def __len__(self):
+        return self._head - self._tail
 
-        seconds = ev_sec + (ev_usec * 0.000001)
-        date = datetime.datetime.fromtimestamp(seconds)
+    def append(self, event_time, row, col, colour):
+        """
+        Add a keypress, overwriting the oldest one when full
 
-        result = (date, key_action, ev_code)
+        :param event_time: Time of the keypress, monotonic clock nanoseconds
+        :type event_time: int
 
-        if ev_type == ev_code == ev_value == 0:
-            return None, None, None
+        :param row: Matrix row
+        :type row: int
 
-        return result
+        :param col: Matrix column
+        :type col: int
 
-    def __init__(self, device_id, event_files, parent, use_epoll=True):
-        super().__init__()
+        :param colour: Colour tuple like (0, 255, 255)
+        :type colour: tuple
+        """
+        slot = self._head % self.capacity
 
-        self._logger = logging.getLogger('razer.device{0}.keywatcher'.format(device_id))
-        self._event_files = event_files
-        self._shutdown = False
-        self._use_epoll = use_epoll
-        self._parent = parent
+        for index in (slot, slot + self.capacity):
+            self.times[index] = event_time
+            self.rows[index] = row
+            self.cols[index] = col
+            self.colours[index] = colour
 
-        self.open_event_files = [open(event_file, 'rb') for event_file in self._event_files]
-        # Set open files to non blocking mode
-        for event_file in self.open_event_files:
-            flags = fcntl.fcntl(event_file.fileno(), fcntl.F_GETFL)
-            fcntl.fcntl(event_file.fileno(), fcntl.F_SETFL, flags | os.O_NONBLOCK)
+        # Publish the entry only once it's complete
+        self._head += 1
 
-    def run(self):
+    def snapshot(self, now):
         """
-        Main event loop
+        Expire old keypresses and get the live ones
+
+        :param now: Current time, monotonic clock nanoseconds
+        :type now: int
+
+        :return: Views of the times, rows, cols and colours of the live keypresses, oldest first
+        :rtype: tuple of numpy.ndarray
         """
-        # Create dict of Event File Descriptor: Event File Object
-        event_file_map = {event_file.fileno(): event_file for event_file in self.open_event_files}
+        head = self._head
+        tail = max(self._tail, head - self.capacity)
 
-        # Create epoll object
-        poll_object = select.epoll()
+        # Times only go up so expiring is moving the tail past the old ones
+        while tail < head and self.times[tail % self.capacity] + self.lifetime < now:
+            tail += 1
+        self._tail = tail
 
-        # Register files with select
-        for event_fd in event_file_map.keys():
-            poll_object.register(event_fd, select.EPOLLIN | select.EPOLLPRI)
+        start = tail % self.capacity
+        end = start + head - tail
 
-        # Loop
-        while not self._shutdown:
-            # epoll is nice but it wasn't getting events properly :(
+        return self.times[start:end], self.rows[start:end], self.cols[start:end], self.colours[start:end]
 
-            try:  # Cheap hack until i merged new code
-                if self._use_epoll:
-                    self._poll_epoll(poll_object, event_file_map)
-                else:
-                    self._poll_read()
-            except (IOError, OSError):  # Basically if there's an error, most likely device has been removed then it'll get deleted properly
-                pass
 
-            time.sleep(SPIN_SLEEP)
+class KeyWatcher(object):
+    """
+    Watch keyboard event files and return keypresses
 
-        # Unbind files and close them
-        for event_fd, event_file in event_file_map.items():
-            poll_object.unregister(event_fd)
-            event_file.close()
+    The files are read on the shared reactor whenever they have events pending.
+    """
+    @staticmethod
+    def parse_event_records(data):
+        """
+        Parse a buffer of input event records
 
-        poll_object.close()
+        The records are decoded in one go and anything other than EV_KEY is masked out before
+        it gets turned into Python objects.
 
-    def _poll_epoll(self, poll_object, event_file_map):
-        events = poll_object.poll(EPOLL_TIMEOUT)
+        :param data: Binary data, a whole number of records
+        :type data: bytes or memoryview
 
-        if len(events) != 0:
-            # pylint: disable=unused-variable
-            for event_fd, mask in events:
-                while True:
-                    key_data = event_file_map[event_fd].read(EVENT_SIZE)
-                    if not key_data:
-                        break
+        :return: Iterator of event time in nanoseconds, key_action, key_code
+        :rtype: iterator of tuple
+        """
+        events = np.frombuffer(data, dtype=EVENT_DTYPE)
+        events = events[events['type'] == EV_KEY]
 
-                    date, key_action, key_code = self.parse_event_record(key_data)
+        # Event Seconds, Event Microseconds, Event Type, Event Code, Event Value
+        for ev_sec, ev_usec, _, ev_code, ev_value in events.tolist():
+            yield ev_sec * 1000000000 + ev_usec * 1000, KEY_ACTIONS[ev_value] if ev_value < 3 else 'unknown', ev_code
 
-                    # Skip if date, key_action and key_code is none as that's a spacer record
-                    if date is None:
-                        continue
+    def __init__(self, device_id, event_files, parent):
+        self._logger = logging.getLogger('razer.device{0}.keywatcher'.format(device_id))
+        self._event_files = event_files
+        self._parent = parent
+        self._reactor = get_reactor()
+        self._running = False
 
-                    # Now if key is pressed then we record
-                    self._parent.key_action(date, key_code, key_action)
+        # Reused by every read, records are decoded straight out of it
+        self._buffer = bytearray(EVENT_SIZE * EVENT_READ_COUNT)
+        self._view = memoryview(self._buffer)
 
-    def _poll_read(self):
+        # Unbuffered so each read is exactly one syscall returning whole records
+        self.open_event_files = [open(event_file, 'rb', buffering=0) for event_file in self._event_files]
+        # Set open files to non blocking mode
         for event_file in self.open_event_files:
+            flags = fcntl.fcntl(event_file.fileno(), fcntl.F_GETFL)
+            fcntl.fcntl(event_file.fileno(), fcntl.F_SETFL, flags | os.O_NONBLOCK)
 
-            key_data = event_file.read(EVENT_SIZE)
+        # Have the kernel timestamp events on the monotonic clock, if it can't they get stamped when read
+        self._kernel_timestamps = True
+        for event_file in self.open_event_files:
+            try:
+                fcntl.ioctl(event_file.fileno(), EVIOCSCLOCKID, struct.pack('i', time.CLOCK_MONOTONIC))
+            except OSError:
+                self._kernel_timestamps = False
 
-            if key_data is None:
-                continue
+    @property
+    def running(self):
+        """
+        Are the event files being watched
 
-            date, key_action, key_code = self.parse_event_record(key_data)
+        :return: Running
+        :rtype: bool
+        """
+        return self._running
 
-            # Skip if date, key_action and key_code is none as that's a spacer record
-            if date is None:
-                continue
+    def start(self):
+        """
+        Start watching the event files
+        """
+        for event_file in self.open_event_files:
+            self._reactor.add_reader(event_file.fileno(), self._read_events, event_file)
+        self._running = True
 
-            # Now if key is pressed then we record
-            self._parent.key_action(date, key_code, key_action)
+    def stop(self):
+        """
+        Stop watching the event files and close them
 
-    @property
-    def shutdown(self):
+        The files are closed on the reactor so a read in progress can't see them vanish.
         """
-        Thread shutdown condition
+        self._running = False
+        self._reactor.call_soon(self._close_event_files)
 
-        :return: Shutdown condition
-        :rtype: bool
+    def _close_event_files(self):
+        for event_file in self.open_event_files:
+            self._reactor.remove_reader(event_file.fileno())
+            event_file.close()
+        self.open_event_files.clear()
+
+    def _read_events(self, mask, event_file):
         """
-        return self._shutdown
+        Drain every record pending on an event file
+
+        :param mask: epoll event mask
+        :type mask: int
 
-    @shutdown.setter
-    def shutdown(self, value):
+        :param event_file: Event file
+        :type event_file: file
         """
-        Set thread shutdown condition
+        try:
+            while True:
+                length = event_file.readinto(self._buffer)
+                if not length:
+                    # None is nothing left to read, 0 is end of file
+                    if length is not None:
+                        mask |= select.EPOLLHUP
+                    break
+
+                for event_time, key_action, key_code in self.parse_event_records(self._view[:length]):
+                    if not self._kernel_timestamps:
+                        event_time = time.monotonic_ns()
+
+                    self._parent.key_action(event_time, key_code, key_action)
+
+                if length < len(self._buffer):
+                    break
+        except OSError as err:  # ENODEV once the device has been unplugged
+            self._logger.debug("Failed to read %s: %s", event_file.name, err)
+            mask |= select.EPOLLHUP
 
-        :param value: Boolean, normally only True would be used
-        :type value: str
+        if mask & (select.EPOLLHUP | select.EPOLLERR):
+            self._remove_event_file(event_file)
+
+    def _remove_event_file(self, event_file):
         """
-        self._shutdown = value
+        Forget an event file whose device has gone away
+
+        The device itself gets removed when udev reports it, until then the remaining files
+        keep working.
+
+        :param event_file: Event file
+        :type event_file: file
+        """
+        self._logger.info("Event file %s was removed", event_file.name)
+
+        self._reactor.remove_reader(event_file.fileno())
+        event_file.close()
+        self.open_event_files.remove(event_file)
 
 
 class KeyboardKeyManager(object):
@@ -230,7 +310,7 @@ class KeyboardKeyManager(object):
     EVENT_MAP = EVENT_MAPPING
 
     # pylint: disable=too-many-instance-attributes
-    def __init__(self, device_id, event_files, parent, use_epoll=False, testing=False, should_grab_event_files=False):
+    def __init__(self, device_id, event_files, parent, testing=False, should_grab_event_files=False):
 
         self._device_id = device_id
         self._logger = logging.getLogger('razer.device{0}.keymanager'.format(device_id))
@@ -240,7 +320,7 @@ class KeyboardKeyManager(object):
 
         self._event_files = event_files
         self._access_lock = threading.Lock()
-        self._keywatcher = KeyWatcher(device_id, event_files, self, use_epoll=use_epoll)
+        self._keywatcher = KeyWatcher(device_id, event_files, self)
         self._open_event_files = self._keywatcher.open_event_files
 
         if len(event_files) > 0:
@@ -255,12 +335,11 @@ class KeyboardKeyManager(object):
         self._current_macro_bind_key = None
         self._current_macro_combo = []
 
-        self._threads = set()
-        self._clean_counter = 0
-
         self._temp_key_store_active = False
-        self._temp_key_store = []
-        self._temp_expire_time = datetime.timedelta(seconds=2)
+        self._temp_key_store = KeyEventRing()
+
+        # Called whenever a key is added to the temporary key store
+        self.temp_key_listener = None
 
         self._last_colour_choice = None
 
@@ -275,25 +354,12 @@ class KeyboardKeyManager(object):
         """
         Get the temporary key store
 
-        :return: List of keys
-        :rtype: list
-        """
-        # Locking so it doesn't mutate whilst copying
-        self._access_lock.acquire()
-        now = datetime.datetime.now()
+        Only the ripple effect reads it, through KeyEventRing.snapshot()
 
-        # Remove expired keys from store
-        try:
-            # Get date and if its less than now its expired
-            while self._temp_key_store[0][0] < now:
-                self._temp_key_store.pop(0)
-        except IndexError:
-            pass
-
-        # Creating a copy as then it doesn't mutate whilst iterating
-        result = self._temp_key_store[:]
-        self._access_lock.release()
-        return result
+        :return: Ring buffer of recent keypresses
+        :rtype: KeyEventRing
+        """
+        return self._temp_key_store
 
     @property
     def temp_key_store_state(self):
@@ -338,8 +404,9 @@ class KeyboardKeyManager(object):
           then it will record keys, then pressing FN+F9 will save macro.
         * Pressing any macro key will run macro.
         * Pressing FN+F10 will toggle game mode.
-        :param event_time: Time event occurred
-        :type event_time: datetime.datetime
+        This runs on the reactor, anything that talks to the driver is queued on the device's worker.
+        :param event_time: Time event occurred, monotonic clock nanoseconds
+        :type event_time: int
 
         :param key_id: Key Event ID
         :type key_id: int
@@ -363,21 +430,6 @@ class KeyboardKeyManager(object):
                 # Quit out early
                 return
 
-        now = datetime.datetime.now()
-
-        # Remove expired keys from store
-        try:
-            # Get date and if its less than now its expired
-            while self._temp_key_store[0][0] < now:
-                self._temp_key_store.pop(0)
-        except IndexError:
-            pass
-
-        # Clean up any threads
-        if self._clean_counter > 20 and len(self._threads) > 0:
-            self._clean_counter = 0
-            self.clean_macro_threads()
-
         try:
             # Convert event ID to key name
             key_name = self.EVENT_MAP[key_id]
@@ -398,7 +450,11 @@ class KeyboardKeyManager(object):
                 if self._temp_key_store_active:
                     colour = random_colour_picker(self._last_colour_choice, COLOUR_CHOICES)
                     self._last_colour_choice = colour
-                    self._temp_key_store.append((now + self._temp_expire_time, self.KEY_MAP[key_name], colour))
+                    key_row, key_col = self.KEY_MAP[key_name]
+                    self._temp_key_store.append(event_time, key_row, key_col, colour)
+
+                    if self.temp_key_listener is not None:
+                        self.temp_key_listener()
 
                 # Macro FN+F9 logic
                 if key_name == 'MACROMODE':
@@ -410,8 +466,7 @@ class KeyboardKeyManager(object):
                         self._current_macro_bind_key = None
                         self._current_macro_combo = []
 
-                        self._parent.setMacroEffect(0x01)
-                        self._parent.setMacroMode(True)
+                        self._parent.submit('Macro mode', lambda: self._set_macro_mode(True))
 
                     else:
                         self._logger.debug("Finished recording macro")
@@ -423,42 +478,18 @@ class KeyboardKeyManager(object):
                                 # Clear macro
                                 self.dbus_delete_macro(self._current_macro_bind_key)
                         self._recording_macro = False
-                        self._parent.setMacroEffect(0x00)
-                        self._parent.setMacroMode(False)
+                        self._parent.submit('Macro mode', lambda: self._set_macro_mode(False))
                 # Sets up game mode as when enabling macro keys it stops the key working
                 elif key_name == 'GAMEMODE':
                     self._logger.info("Got game mode combo")
 
-                    game_mode = self._parent.getGameMode()
-                    self._parent.setGameMode(not game_mode)
+                    self._parent.submit('Game mode', self._toggle_game_mode)
 
                 # Brightness logic
                 elif key_name == 'BRIGHTNESSDOWN':
-                    # Get brightness value
-                    current_brightness = self._parent.method_args.get('brightness', None)
-                    if current_brightness is None:
-                        current_brightness = self._parent.getBrightness()
-
-                    if current_brightness > 0:
-                        current_brightness -= 10
-                        if current_brightness < 0:
-                            current_brightness = 0
-
-                        self._parent.setBrightness(current_brightness)
-                        # self._parent.method_args['brightness'] = current_brightness
+                    self._parent.submit('Brightness', lambda: self._step_brightness(-10))
                 elif key_name == 'BRIGHTNESSUP':
-                    # Get brightness value
-                    current_brightness = self._parent.method_args.get('brightness', None)
-                    if current_brightness is None:
-                        current_brightness = self._parent.getBrightness()
-
-                    if current_brightness < 100:
-                        current_brightness += 10
-                        if current_brightness > 100:
-                            current_brightness = 100
-
-                        self._parent.setBrightness(current_brightness)
-                        # self._parent.method_args['brightness'] = current_brightness
+                    self._parent.submit('Brightness', lambda: self._step_brightness(10))
 
                 elif self._recording_macro:
 
@@ -467,15 +498,15 @@ class KeyboardKeyManager(object):
                         if key_name not in ('M1', 'M2', 'M3', 'M4', 'M5'):
                             self._logger.warning("Macros are only for M1-M5 for now.")
                             self._recording_macro = False
-                            self._parent.setMacroMode(False)
+                            self._parent.submit('Macro mode', lambda: self._parent.setMacroMode(False))
                         else:
                             self._current_macro_bind_key = key_name
-                            self._parent.setMacroEffect(0x00)
+                            self._parent.submit('Macro effect', lambda: self._parent.setMacroEffect(0x00))
                     # Don't want no recursion, cancel macro, don't let one call macro in a macro
                     elif key_name == self._current_macro_bind_key:
                         self._logger.warning("Skipping macro assignment as would cause recursion")
                         self._recording_macro = False
-                        self._parent.setMacroMode(False)
+                        self._parent.submit('Macro mode', lambda: self._parent.setMacroMode(False))
                     # Anything else just record it
                     else:
                         self._current_macro_combo.append((event_time, key_name, 'DOWN'))
@@ -488,6 +519,37 @@ class KeyboardKeyManager(object):
         except KeyError as err:
             self._logger.exception("Got key error. Couldn't convert event to key name", exc_info=err)
 
+    def _set_macro_mode(self, enabled):
+        """
+        Switch the macro LED and macro mode, runs on the device's worker
+
+        :param enabled: True when recording starts, False when it stops
+        :type enabled: bool
+        """
+        self._parent.setMacroEffect(0x01 if enabled else 0x00)
+        self._parent.setMacroMode(enabled)
+
+    def _toggle_game_mode(self):
+        """
+        Toggle game mode, runs on the device's worker
+        """
+        self._parent.setGameMode(not self._parent.getGameMode())
+
+    def _step_brightness(self, step):
+        """
+        Change the brightness by a step, runs on the device's worker
+
+        :param step: Percent to add, negative to dim
+        :type step: int
+        """
+        current_brightness = self._parent.method_args.get('brightness', None)
+        if current_brightness is None:
+            current_brightness = self._parent.getBrightness()
+
+        new_brightness = min(max(current_brightness + step, 0), 100)
+        if new_brightness != current_brightness:
+            self._parent.setBrightness(new_brightness)
+
     def add_kb_macro(self):
         """
         Tidy up the recorded macro and add it to the store
@@ -498,41 +560,22 @@ class KeyboardKeyManager(object):
 
         start_time = self._current_macro_combo[0][0]
         for event_time, key, state in self._current_macro_combo:
-            delay = (event_time - start_time).microseconds
+            delay = (event_time - start_time) // 1000
             start_time = event_time
             new_macro.append(MacroKey(key, delay, state))
 
         self._macros[self._current_macro_bind_key] = new_macro
 
-    def clean_macro_threads(self):
-        """
-        Threadless-threadpool
-
-        Goes though the threads (macro play jobs) and removed the threads if they have finished.
-        #SetMagic
-        """
-        self._logger.debug("Cleaning up macro threads")
-        to_remove = set()
-
-        for macro_thread in self._threads:
-            macro_thread.join(timeout=0.05)
-            if not macro_thread.is_alive():
-                to_remove.add(macro_thread)
-
-        self._threads -= to_remove
-
     def play_macro(self, macro_key):
         """
         Play macro for a given key
 
-        Launches a thread and adds it to the pool
+        The macro is played on the shared reactor
         :param macro_key: Macro Key
         :type macro_key: str
         """
         self._logger.info("Running Macro %s:%s", macro_key, str(self._macros[macro_key]))
-        macro_thread = MacroRunner(self._device_id, macro_key, self._macros[macro_key])
-        macro_thread.start()
-        self._threads.add(macro_thread)
+        MacroRunner(self._device_id, macro_key, self._macros[macro_key]).start()
 
     # Methods to be used with DBus
     def dbus_delete_macro(self, key_name):
@@ -585,14 +628,11 @@ class KeyboardKeyManager(object):
         """
         Cleanup function
         """
-        if self._keywatcher.is_alive():
+        if self._keywatcher.running:
             self._parent.remove_observer(self)
 
             self._logger.debug("Stopping key manager")
-            self._keywatcher.shutdown = True
-            self._keywatcher.join(timeout=2)
-            if self._keywatcher.is_alive():
-                self._logger.error("Could not stop KeyWatcher thread")
+            self._keywatcher.stop()
 
     def __del__(self):
         self.close()
@@ -627,8 +667,8 @@ class GamepadKeyManager(KeyboardKeyManager):
     GAMEPAD_EVENT_MAPPING = TARTARUS_EVENT_MAPPING
     GAMEPAD_KEY_MAPPING = TARTARUS_KEY_MAPPING
 
-    def __init__(self, device_id, event_files, parent, use_epoll=True, testing=False):
-        super().__init__(device_id, event_files, parent, use_epoll, testing=testing)
+    def __init__(self, device_id, event_files, parent, testing=False):
+        super().__init__(device_id, event_files, parent, testing=testing)
 
         self._mode_modifier = False
         self._mode_modifier_combo = []
@@ -645,8 +685,8 @@ class GamepadKeyManager(KeyboardKeyManager):
           then it will record keys, then pressing FN+F9 will save macro.
         * Pressing any macro key will run macro.
         * Pressing FN+F10 will toggle game mode.
-        :param event_time: Time event occurred
-        :type event_time: datetime.datetime
+        :param event_time: Time event occurred, monotonic clock nanoseconds
+        :type event_time: int
 
         :param key_id: Key Event ID
         :type key_id: int
@@ -661,21 +701,6 @@ class GamepadKeyManager(KeyboardKeyManager):
         if not self._event_files_locked:
             self.grab_event_files(True)
 
-        now = datetime.datetime.now()
-
-        # Remove expired keys from store
-        try:
-            # Get date and if its less than now its expired
-            while self._temp_key_store[0][0] < now:
-                self._temp_key_store.pop(0)
-        except IndexError:
-            pass
-
-        # Clean up any threads
-        if self._clean_counter > 20 and len(self._threads) > 0:
-            self._clean_counter = 0
-            self.clean_macro_threads()
-
         try:
             # Convert event ID to key name
 
@@ -685,7 +710,11 @@ class GamepadKeyManager(KeyboardKeyManager):
             if self._temp_key_store_active:
                 colour = random_colour_picker(self._last_colour_choice, COLOUR_CHOICES)
                 self._last_colour_choice = colour
-                self._temp_key_store.append((now + self._temp_expire_time, self.GAMEPAD_KEY_MAPPING[key_name], colour))
+                key_row, key_col = self.GAMEPAD_KEY_MAPPING[key_name]
+                self._temp_key_store.append(event_time, key_row, key_col, colour)
+
+                if self.temp_key_listener is not None:
+                    self.temp_key_listener()
 
             # if self._testing:
             # if key_press:
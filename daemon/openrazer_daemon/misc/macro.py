@@ -7,15 +7,19 @@ Has objects representing key events
 Launching programs etc...
 """
 import logging
+import os
 import subprocess
-import threading
 
 # pylint: disable=import-error
 from openrazer_daemon.keyboard import XTE_MAPPING
+from openrazer_daemon.misc.reactor import get_reactor
 
 # This determines if the macro keys are executed with their natural spacing
 XTE_SLEEP = False
 
+# How often to check if a step has finished when pidfds aren't available
+EXIT_POLL_INTERVAL = 0.05
+
 
 class MacroObject(object):
     """
@@ -102,12 +106,20 @@ class MacroURL(MacroObject):
             'url': self.url,
         }
 
+    def spawn(self):
+        """
+        Start opening the URL in the browser
+
+        :return: Process
+        :rtype: subprocess.Popen
+        """
+        return subprocess.Popen(['xdg-open', self.url], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
     def execute(self):
         """
         Open URL in the browser
         """
-        proc = subprocess.Popen(['xdg-open', self.url], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
-        proc.communicate()
+        self.spawn().communicate()
 
 
 class MacroScript(MacroObject):
@@ -135,25 +147,50 @@ class MacroScript(MacroObject):
             'args': self.args
         }
 
+    def spawn(self):
+        """
+        Start the script
+
+        :return: Process
+        :rtype: subprocess.Popen
+        """
+        return subprocess.Popen(self.script + self.args, shell=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
     def execute(self):
         """
         Run script
         """
-        proc = subprocess.Popen(self.script + self.args, shell=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
-        proc.communicate()
+        self.spawn().communicate()
 
 
-class MacroRunner(threading.Thread):
+class MacroRunner(object):
     """
-    Thread to run macros
+    Run a macro on the shared reactor
+
+    Every step of the macro is a process, the next step is started when the reactor sees the
+    previous one exit so no thread waits on them.
     """
 
     def __init__(self, device_id, macro_bind, macro_data):
-        super().__init__()
-
         self._logger = logging.getLogger('razer.device{0}.macro{1}'.format(device_id, macro_bind))
-        self._macro_data = macro_data
         self._macro_bind = macro_bind
+        self._reactor = get_reactor()
+
+        # Runs of key events are merged into one xte script, this just allows for less calls to xte
+        self._steps = []
+        xte = ''
+
+        for event in macro_data:
+            if isinstance(event, MacroKey):
+                xte += self.xte_line(event)
+            else:
+                if xte != '':
+                    self._steps.append(xte)
+                    xte = ''
+                self._steps.append(event)
+
+        if xte != '':
+            self._steps.append(xte)
 
     @staticmethod
     def xte_line(key_event):
@@ -182,32 +219,59 @@ class MacroRunner(threading.Thread):
 
         return cmd
 
-    def run(self):
+    def start(self):
         """
-        Main thread function
+        Start running the macro
         """
+        self._reactor.call_soon(self._next_step)
 
-        # TODO move the xte-munging to the init
-        xte = ''
+    def _next_step(self):
+        """
+        Start the next step of the macro
+        """
+        if len(self._steps) == 0:
+            self._logger.debug("Finished running macro %s", self._macro_bind)
+            return
 
-        for event in self._macro_data:
-            if isinstance(event, MacroKey):
-                xte += self.xte_line(event)
+        step = self._steps.pop(0)
+
+        try:
+            if isinstance(step, str):
+                proc = subprocess.Popen(['xte'], stdin=subprocess.PIPE)
+                proc.stdin.write(step.encode('ascii'))
+                proc.stdin.close()
             else:
-                if xte != '':
-                    proc = subprocess.Popen(['xte'], stdin=subprocess.PIPE)
-                    proc.communicate(input=xte.encode('ascii'))
-                    xte = ''
+                proc = step.spawn()
+        except OSError as err:
+            self._logger.error("Failed to run macro %s, err: %s", self._macro_bind, err)
+            return
+
+        try:
+            pidfd = os.pidfd_open(proc.pid)
+        except (AttributeError, OSError):
+            # Python or kernel too old for pidfds, check on the process every so often
+            self._reactor.call_later(EXIT_POLL_INTERVAL, self._poll_exit, proc)
+        else:
+            self._reactor.add_reader(pidfd, self._on_exit, proc, pidfd)
 
-                # Now run everything else (this just allows for less calls to xte
-                if not isinstance(event, MacroKey):
-                    event.execute()
+    def _on_exit(self, mask, proc, pidfd):
+        """
+        Reap the step's process once its pidfd becomes readable
+        """
+        self._reactor.remove_reader(pidfd)
+        os.close(pidfd)
+        proc.wait()
 
-        if xte != '':
-            proc = subprocess.Popen(['xte'], stdin=subprocess.PIPE)
-            proc.communicate(input=xte.encode('ascii'))
+        self._next_step()
 
-        self._logger.debug("Finished running macro %s", self._macro_bind)
+    def _poll_exit(self, proc):
+        """
+        Reap the step's process if it has exited
+        """
+        if proc.poll() is None:
+            self._reactor.call_later(EXIT_POLL_INTERVAL, self._poll_exit, proc)
+        else:
+            self._next_step()
 
 
 def macro_dict_to_obj(macro_dict):
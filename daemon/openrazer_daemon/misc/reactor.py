@@ -0,0 +1,294 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Shared event loop for the periodic and file descriptor driven work of all devices
+
+Effects, battery notifications, macros and the evdev readers used to run a thread each per
+device. They now all run on one reactor thread, which sleeps in epoll until a file descriptor
+is ready or the next timer is due, so an idle device costs no wakeups at all.
+
+Callbacks run on the reactor thread and must not block, anything slow holds up every device.
+"""
+import heapq
+import itertools
+import logging
+import os
+import select
+import threading
+import time
+
+
+class Timer(object):
+    """
+    Handle for a scheduled callback
+    """
+    __slots__ = ('when', 'callback', 'args', 'cancelled', '_reactor')
+
+    def __init__(self, when, callback, args):
+        self.when = when
+        self.callback = callback
+        self.args = args
+        self.cancelled = False
+
+        # Reactor whose queue holds the timer, None once it is taken off
+        self._reactor = None
+
+    def cancel(self):
+        """
+        Stop the callback from running, does nothing if it already ran
+        """
+        reactor = self._reactor
+        if reactor is None:
+            self.cancelled = True
+        else:
+            reactor._cancel_timer(self)
+
+
+class Reactor(threading.Thread):
+    """
+    Event loop with epoll readers and a timer queue
+
+    All the methods are thread safe, the loop is woken through a pipe when work is added
+    from another thread.
+    """
+
+    def __init__(self):
+        super().__init__(name='razer-reactor', daemon=True)
+
+        self._logger = logging.getLogger('razer.reactor')
+
+        self._epoll = select.epoll()
+        self._wakeup_read, self._wakeup_write = os.pipe2(os.O_NONBLOCK | os.O_CLOEXEC)
+        self._epoll.register(self._wakeup_read, select.EPOLLIN)
+
+        self._lock = threading.Lock()
+        self._timers = []
+        self._cancelled_timers = 0
+        self._sequence = itertools.count()
+        self._readers = {}
+
+        self._shutdown = False
+
+    def call_at(self, when, callback, *args):
+        """
+        Run a callback at a time on the monotonic clock
+
+        :param when: time.monotonic() value
+        :type when: float
+
+        :param callback: Callback
+        :type callback: callable
+
+        :return: Timer handle
+        :rtype: Timer
+        """
+        timer = Timer(when, callback, args)
+
+        with self._lock:
+            timer._reactor = self
+            heapq.heappush(self._timers, (when, next(self._sequence), timer))
+            first = self._timers[0][2] is timer
+
+        # Only wake the loop if it's sleeping past the new timer
+        if first and threading.current_thread() is not self:
+            self._wakeup()
+
+        return timer
+
+    def call_later(self, delay, callback, *args):
+        """
+        Run a callback after a delay
+
+        :param delay: Delay in seconds
+        :type delay: float
+
+        :param callback: Callback
+        :type callback: callable
+
+        :return: Timer handle
+        :rtype: Timer
+        """
+        return self.call_at(time.monotonic() + max(delay, 0), callback, *args)
+
+    def call_soon(self, callback, *args):
+        """
+        Run a callback on the reactor thread as soon as possible
+
+        :param callback: Callback
+        :type callback: callable
+
+        :return: Timer handle
+        :rtype: Timer
+        """
+        return self.call_at(time.monotonic(), callback, *args)
+
+    def add_reader(self, fd, callback, *args):
+        """
+        Run a callback whenever a file descriptor is readable
+
+        The callback is passed the epoll event mask followed by args.
+
+        :param fd: File descriptor
+        :type fd: int
+
+        :param callback: Callback
+        :type callback: callable
+        """
+        with self._lock:
+            self._readers[fd] = (callback, args)
+        self._epoll.register(fd, select.EPOLLIN | select.EPOLLPRI)
+
+    def remove_reader(self, fd):
+        """
+        Stop watching a file descriptor
+
+        Must be called before the file descriptor is closed.
+
+        :param fd: File descriptor
+        :type fd: int
+        """
+        with self._lock:
+            if self._readers.pop(fd, None) is None:
+                return
+        try:
+            self._epoll.unregister(fd)
+        except (OSError, ValueError):
+            pass
+
+    def stop(self):
+        """
+        Stop the loop
+        """
+        self._shutdown = True
+        self._wakeup()
+
+    def _wakeup(self):
+        try:
+            os.write(self._wakeup_write, b'\0')
+        except BlockingIOError:
+            # Pipe is full so the loop is being woken anyway
+            pass
+
+    def _cancel_timer(self, timer):
+        """
+        Cancel a timer, dropping the cancelled ones from the queue once they are over half of it
+
+        Timers cancelled long before they are due, like the autosave timer once a flush beat it,
+        would otherwise pile up in the heap until their time came.
+        """
+        with self._lock:
+            if timer.cancelled:
+                return
+            timer.cancelled = True
+
+            if timer._reactor is not self:
+                return
+
+            self._cancelled_timers += 1
+            if self._cancelled_timers * 2 > len(self._timers):
+                for entry in self._timers:
+                    if entry[2].cancelled:
+                        entry[2]._reactor = None
+                self._timers = [entry for entry in self._timers if not entry[2].cancelled]
+                heapq.heapify(self._timers)
+                self._cancelled_timers = 0
+
+    def _pop_timer(self):
+        """
+        Take the first timer off the queue, the caller holds the lock
+        """
+        timer = heapq.heappop(self._timers)[2]
+        timer._reactor = None
+        if timer.cancelled:
+            self._cancelled_timers -= 1
+        return timer
+
+    def _next_timeout(self):
+        with self._lock:
+            while self._timers and self._timers[0][2].cancelled:
+                self._pop_timer()
+
+            if not self._timers:
+                return -1
+
+            return max(self._timers[0][0] - time.monotonic(), 0)
+
+    def _run_timers(self):
+        now = time.monotonic()
+        due = []
+
+        with self._lock:
+            while self._timers and self._timers[0][0] <= now:
+                due.append(self._pop_timer())
+
+        for timer in due:
+            if not timer.cancelled:
+                self._dispatch(timer.callback, timer.args)
+
+    def _dispatch(self, callback, args):
+        try:
+            callback(*args)
+        except Exception:
+            self._logger.exception("Callback %r failed", callback)
+
+    def run(self):
+        """
+        Event loop
+        """
+        while not self._shutdown:
+            try:
+                events = self._epoll.poll(self._next_timeout())
+            except InterruptedError:
+                continue
+
+            for fd, mask in events:
+                if fd == self._wakeup_read:
+                    try:
+                        os.read(self._wakeup_read, 4096)
+                    except BlockingIOError:
+                        pass
+                    continue
+
+                reader = self._readers.get(fd)
+                if reader is not None:
+                    self._dispatch(reader[0], (mask,) + reader[1])
+
+            self._run_timers()
+
+        self._epoll.close()
+        os.close(self._wakeup_read)
+        os.close(self._wakeup_write)
+
+
+_REACTOR = None
+_REACTOR_LOCK = threading.Lock()
+
+
+def get_reactor():
+    """
+    Get the shared reactor, starting it on first use
+
+    :return: Reactor
+    :rtype: Reactor
+    """
+    global _REACTOR
+
+    with _REACTOR_LOCK:
+        if _REACTOR is None:
+            _REACTOR = Reactor()
+            _REACTOR.start()
+
+        return _REACTOR
+
+
+def stop_reactor():
+    """
+    Stop the shared reactor if it was started
+    """
+    global _REACTOR
+
+    with _REACTOR_LOCK:
+        if _REACTOR is not None:
+            _REACTOR.stop()
+            _REACTOR.join(timeout=2)
+            _REACTOR = None
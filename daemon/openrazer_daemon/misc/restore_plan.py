@@ -0,0 +1,177 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+State a device is put back into when the daemon starts
+"""
+import configparser
+
+DEFAULT_COLORS = [0, 255, 0, 0, 255, 255, 0, 0, 255]
+
+
+def parse_bool(value):
+    """
+    Parse a boolean the way configparser does
+
+    :param value: String from the persistence file
+    :type value: str
+
+    :return: Boolean
+    :rtype: bool
+
+    :raises ValueError: If it's not a boolean
+    """
+    try:
+        return configparser.ConfigParser.BOOLEAN_STATES[value.lower()]
+    except KeyError:
+        raise ValueError("Not a boolean: " + value) from None
+
+
+def parse_colors(value):
+    """
+    Parse the colors of a zone, 9 numbers separated with spaces
+
+    :param value: String from the persistence file
+    :type value: str
+
+    :return: Colors
+    :rtype: list of int
+
+    :raises ValueError: If there aren't 9 colors in range
+    """
+    colors = [int(item) for item in value.split(" ")]
+
+    if len(colors) != 9:
+        raise ValueError('There must be exactly 9 colors')
+    if not all(0 <= color <= 255 for color in colors):
+        raise ValueError('Color out of range')
+
+    return colors
+
+
+# Zone keys in the persistence file and how to parse them
+ZONE_FIELDS = {
+    'effect': str,
+    'active': parse_bool,
+    'brightness': float,
+    'colors': parse_colors,
+    'speed': int,
+    'wave_dir': int,
+}
+
+
+class RestorePlan(object):
+    """
+    A device's persisted state, parsed once
+
+    Values that are missing or don't parse are left out, the device keeps its defaults for them.
+    """
+
+    def __init__(self, dpi=None, poll_rate=None, zones=None):
+        self.dpi = dpi
+        self.poll_rate = poll_rate
+        self.zones = zones if zones is not None else {}
+
+    @classmethod
+    def from_persistence(cls, persistence, storage_name, zones, logger):
+        """
+        Parse a device's section of the persistence file
+
+        :param persistence: Persistence config
+        :type persistence: configparser.ConfigParser
+
+        :param storage_name: Device's section
+        :type storage_name: str
+
+        :param zones: Zones the device has
+        :type zones: list of str
+
+        :param logger: Logger
+        :type logger: logging.Logger
+
+        :return: Restore plan, empty if the device isn't in the file
+        :rtype: RestorePlan
+        """
+        plan = cls()
+        if not persistence.has_section(storage_name):
+            return plan
+
+        section = dict(persistence[storage_name])
+
+        try:
+            plan.dpi = (int(section['dpi_x']), int(section['dpi_y']))
+        except KeyError:
+            pass
+        except ValueError:
+            logger.info("Invalid DPI in persistence storage, using default.")
+
+        try:
+            plan.poll_rate = int(section['poll_rate'])
+        except KeyError:
+            pass
+        except ValueError:
+            logger.info("Invalid poll rate in persistence storage, using default.")
+
+        for zone in zones:
+            values = {}
+            missing = []
+
+            for field, parse in ZONE_FIELDS.items():
+                try:
+                    values[field] = parse(section[zone + '_' + field])
+                except KeyError:
+                    missing.append(field)
+                except ValueError:
+                    logger.info("Invalid %s %s in persistence storage, using default.", zone, field)
+                    if field == 'colors':
+                        values[field] = list(DEFAULT_COLORS)
+
+            if missing:
+                logger.info("Failed to get %s %s from persistence storage, using default.", zone, ', '.join(missing))
+
+            plan.zones[zone] = values
+
+        return plan
+
+    def apply(self, device):
+        """
+        Put the planned state into the device's state, without touching the hardware
+
+        :param device: Device
+        :type device: openrazer_daemon.hardware.device_base.RazerDevice
+        """
+        if self.dpi is not None and ('set_dpi_xy' in device.METHODS or 'set_dpi_xy_byte' in device.METHODS):
+            device.dpi[0], device.dpi[1] = self.dpi
+
+        if self.poll_rate is not None and 'set_poll_rate' in device.METHODS:
+            device.poll_rate = self.poll_rate
+
+        for zone, values in self.zones.items():
+            device.zone[zone].update(values)
+
+
+def driver_state_holds(driver_state, driver_filename, *values):
+    """
+    Check if a setting cached in a state snapshot holds the given numbers
+
+    Numbers are compared the way the driver shows them, decimal and separated by colons.
+
+    :param driver_state: Values from the state snapshot by driver file name
+    :type driver_state: dict
+
+    :param driver_filename: Driver file
+    :type driver_filename: str
+
+    :param values: Expected numbers
+    :type values: int
+
+    :return: True if the file was in the snapshot and holds exactly those numbers
+    :rtype: bool
+    """
+    content = driver_state.get(driver_filename)
+    if content is None:
+        return False
+
+    try:
+        return [int(value) for value in content.decode('ascii').strip().split(':')] == list(values)
+    except (UnicodeDecodeError, ValueError):
+        return False
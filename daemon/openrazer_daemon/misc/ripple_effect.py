@@ -3,55 +3,76 @@
 """
 Contains the functions and classes to perform ripple effects
 """
-import datetime
 import logging
-import math
-import threading
 import time
 
-# pylint: disable=import-error
-from openrazer_daemon.keyboard import KeyboardColour
+import numpy as np
 
+from openrazer_daemon.misc.frame_pacer import FramePacer
+from openrazer_daemon.misc.key_event_management import KeyEventRing
+from openrazer_daemon.misc.reactor import get_reactor
 
-class RippleEffectThread(threading.Thread):
+
+class RippleEffect(object):
     """
-    Ripple thread.
+    Ripple effect.
 
-    This thread contains the run loop which performs all the circle calculations and generating of the binary payload
+    Performs all the circle calculations and generating of the binary payload. Frames are rendered on the
+    shared reactor while there are ripples to draw, once they have all faded it stops until the next keypress.
+    Each frame is written to the device on its worker, and the next one is only scheduled once it's written.
     """
 
     def __init__(self, parent, device_number):
-        super().__init__()
-
-        self._logger = logging.getLogger('razer.device{0}.ripplethread'.format(device_number))
+        self._logger = logging.getLogger('razer.device{0}.ripple'.format(device_number))
         self._parent = parent
+        self._reactor = get_reactor()
 
         self._colour = (0, 255, 0)
         self._refresh_rate = 0.040
 
-        self._shutdown = False
         self._active = False
+        self._timer = None
+        self._sending = False
+        self._blank = True
 
         self._rows, self._cols = self._parent._parent.MATRIX_DIMS
 
-        self._keyboard_grid = KeyboardColour(self._rows, self._cols)
+        # Frame buffer, each row is the row ID, 0x00, the last column then the RGB bytes
+        self._frame = np.zeros((self._rows, 3 + self._cols * 3), dtype=np.uint8)
+        self._frame[:, 0] = np.arange(self._rows)
+        self._frame[:, 2] = self._cols - 1
+        self._pixels = self._frame[:, 3:].reshape(self._rows, self._cols, 3)
 
-    @property
-    def shutdown(self):
-        """
-        Get the shutdown flag
-        """
-        return self._shutdown
+        self._distances = self.distance_fields(self._rows, self._cols)
+
+        self._pacer = FramePacer(self._refresh_rate)
 
-    @shutdown.setter
-    def shutdown(self, value):
+    @staticmethod
+    def distance_fields(rows, cols):
         """
-        Set the shutdown flag
+        Precompute the distance from every key to every LED
+
+        The logo location is physically at (6, 11) but logically at (0, 20) on 6x22 keyboards,
+        so the distance to that LED is measured from where the logo actually is.
+
+        :param rows: Matrix rows
+        :type rows: int
 
-        :param value: Shutdown
-        :type value: bool
+        :param cols: Matrix columns
+        :type cols: int
+
+        :return: Array of shape (rows, cols, rows, cols), indexed by ripple centre then LED
+        :rtype: numpy.ndarray
         """
-        self._shutdown = value
+        led_rows, led_cols = np.indices((rows, cols), dtype=np.float64)
+
+        if rows == 6 and cols == 22:
+            led_rows[0, 20] = 6
+            led_cols[0, 20] = 11
+
+        centre_rows, centre_cols = np.indices((rows, cols), dtype=np.float64)
+
+        return np.hypot(centre_rows[:, :, None, None] - led_rows, centre_cols[:, :, None, None] - led_cols)
 
     @property
     def active(self):
@@ -64,14 +85,24 @@ class RippleEffectThread(threading.Thread):
         return self._active
 
     @property
-    def key_list(self):
+    def key_events(self):
         """
-        Get key list
+        Get the recent keypresses
 
-        :return: Key list
-        :rtype: list
+        :return: Ring buffer of keypresses
+        :rtype: KeyEventRing
+        """
+        return self._parent.key_events
+
+    @property
+    def frame_stats(self):
         """
-        return self._parent.key_list
+        Get the frame pacing statistics
+
+        :return: Dict of fps, target_fps, render_ms, submit_ms, frames and dropped
+        :rtype: dict
+        """
+        return self._pacer.stats()
 
     def enable(self, colour, refresh_rate):
         """
@@ -90,84 +121,133 @@ class RippleEffectThread(threading.Thread):
             self._colour = colour
         self._refresh_rate = refresh_rate
         self._active = True
+        # Draw at least one frame so whatever effect was on before gets cleared
+        self._blank = False
+        self.wake()
 
     def disable(self):
         """
         Disable the ripple effect
         """
         self._active = False
+        self._reactor.call_soon(self._stop)
 
-    def run(self):
+    def wake(self):
         """
-        Event loop
+        Start rendering frames again if the effect went idle
         """
-        # pylint: disable=too-many-nested-blocks,too-many-branches
-        expire_diff = datetime.timedelta(seconds=2)
+        if self._active:
+            self._reactor.call_soon(self._start)
 
-        # self._parent: RippleManager
-        # self._parent._parent: The device class (e.g. RazerBlackWidowUltimate2013)
-        if self._rows == 6 and self._cols == 22:
-            needslogohandling = True
-            # a virtual 7th row for logo handling
-            self._rows += 1
-        else:
-            needslogohandling = False
+    def _start(self):
+        if self._timer is None and not self._sending and self._active:
+            self._pacer.reset()
+            self._timer = self._reactor.call_soon(self._draw_frame)
+
+    def _stop(self):
+        if self._timer is not None:
+            self._timer.cancel()
+            self._timer = None
+
+    def render(self, centre_rows, centre_cols, radii, colours):
+        """
+        Draw the ripples into the frame buffer
 
-        # TODO time execution and then sleep for _refresh_rate - time_taken
-        while not self._shutdown:
-            if self._active:
-                # Clear keyboard
-                self._keyboard_grid.reset_rows()
+        A LED is lit when it is within 2 keys inside a ripple's radius. Where ripples overlap
+        the first one wins.
 
-                now = datetime.datetime.now()
+        :param centre_rows: Row of the key each ripple started from
+        :type centre_rows: numpy.ndarray
 
-                radiuses = []
+        :param centre_cols: Column of the key each ripple started from
+        :type centre_cols: numpy.ndarray
 
-                for expire_time, (key_row, key_col), colour in self.key_list:
-                    event_time = expire_time - expire_diff
+        :param radii: Radius of each ripple
+        :type radii: numpy.ndarray
 
-                    now_diff = now - event_time
+        :param colours: RGB colour of each ripple, shape (n, 3)
+        :type colours: numpy.ndarray
 
-                    # Current radius is based off a time metric
-                    if self._colour is not None:
-                        colour = self._colour
-                    radiuses.append((key_row, key_col, now_diff.total_seconds() * 24, colour))
+        :return: Binary payload for the whole matrix
+        :rtype: bytes
+        """
+        self._pixels.fill(0)
+
+        if len(radii) > 0:
+            radii = radii[:, None, None]
+
+            distances = self._distances[centre_rows, centre_cols]
+            rings = (distances <= radii) & (distances >= radii - 2)
+
+            lit = rings.any(axis=0)
+            first = rings.argmax(axis=0)
+            self._pixels[lit] = colours[first[lit]]
 
-                # Iterate through the rows
-                for row in range(0, self._rows):
-                    # Iterate through the columns
-                    for col in range(0, self._cols):
-                        # The logo location is physically at (6, 11), logically at (0, 20)
-                        # Skip when we come across the logo location, as the ripple would look wrong
-                        if needslogohandling and row == 0 and col == 20:
-                            continue
+        return self._frame.tobytes()
+
+    def _draw_frame(self):
+        """
+        Render one frame and hand it to the device's worker
+        """
+        if not self._active:
+            self._timer = None
+            return
 
-                        if needslogohandling and row == 6:
-                            if col != 11:
-                                continue
+        self._pacer.interval = self._refresh_rate
+        self._pacer.start_frame()
 
-                            # To account for logo placement
-                            for cirlce_centre_row, circle_centre_col, rad, colour in radiuses:
-                                radius = math.sqrt(math.pow(cirlce_centre_row - row, 2) + math.pow(circle_centre_col - col, 2))
-                                if rad >= radius >= rad - 2:
-                                    # Again, (0, 20) is the logical location of the logo led
-                                    self._keyboard_grid.set_key_colour(0, 20, colour)
-                                    break
-                        else:
-                            for cirlce_centre_row, circle_centre_col, rad, colour in radiuses:
-                                radius = math.sqrt(math.pow(cirlce_centre_row - row, 2) + math.pow(circle_centre_col - col, 2))
-                                if rad >= radius >= rad - 2:
-                                    self._keyboard_grid.set_key_colour(row, col, colour)
-                                    break
+        now = time.monotonic_ns()
 
-                # Set the colors on the device
-                payload = self._keyboard_grid.get_total_binary()
+        event_times, centre_rows, centre_cols, colours = self.key_events.snapshot(now)
+        ripple_count = len(event_times)
 
-                self._parent.set_rgb_matrix(payload)
-                self._parent.refresh_keyboard()
+        # Nothing left to draw and the matrix is already clear, wait for the next keypress
+        if ripple_count == 0 and self._blank:
+            self._timer = None
+            return
 
-            # Sleep until the next ripple refresh
-            time.sleep(self._refresh_rate)
+        # Current radius is based off a time metric
+        radii = (now - event_times) * 24e-9
+
+        if self._colour is not None:
+            colours = np.broadcast_to(self._colour, (ripple_count, 3))
+
+        payload = self.render(centre_rows, centre_cols, radii, colours)
+        self._pacer.rendered()
+
+        self._timer = None
+        self._sending = True
+        # self._parent: RippleManager
+        self._parent.submit('Ripple frame', lambda: self._send_frame(payload, ripple_count))
+
+    def _send_frame(self, payload, ripple_count):
+        """
+        Write a frame to the device, runs on the device's worker
+
+        :param payload: Binary payload for the whole matrix
+        :type payload: bytes
+
+        :param ripple_count: Number of ripples in the frame
+        :type ripple_count: int
+        """
+        try:
+            self._parent.set_rgb_matrix(payload)
+            self._parent.refresh_keyboard()
+        except OSError as err:
+            self._logger.warning("Failed to send ripple frame: %s", err)
+        self._pacer.submitted()
+
+        self._reactor.call_soon(self._frame_sent, ripple_count)
+
+    def _frame_sent(self, ripple_count):
+        """
+        Schedule the next frame once the last one is written
+        """
+        self._sending = False
+        self._blank = ripple_count == 0
+
+        if self._active and self._timer is None:
+            self._timer = self._reactor.call_later(self._pacer.next_delay(), self._draw_frame)
 
 
 class RippleManager(object):
@@ -182,22 +262,49 @@ class RippleManager(object):
 
         self._is_closed = False
 
-        self._ripple_thread = RippleEffectThread(self, device_number)
-        self._ripple_thread.start()
+        # Stays empty for devices without a key manager
+        self._no_key_events = KeyEventRing()
+
+        self._ripple_effect = RippleEffect(self, device_number)
+
+        # Keypresses restart the effect once it has gone idle
+        if hasattr(self._parent, 'key_manager'):
+            self._parent.key_manager.temp_key_listener = self._ripple_effect.wake
 
     @property
-    def key_list(self):
+    def key_events(self):
         """
-        Get the list of keys from the key manager
+        Get the recent keypresses from the key manager
 
-        :return: List of tuples (expire_time, (key_row, key_col), random_colour)
-        :rtype: list of tuple
+        :return: Ring buffer of keypresses
+        :rtype: KeyEventRing
         """
-        result = []
         if hasattr(self._parent, 'key_manager'):
-            result = self._parent.key_manager.temp_key_store
+            return self._parent.key_manager.temp_key_store
+
+        return self._no_key_events
+
+    @property
+    def frame_stats(self):
+        """
+        Get the ripple effect's frame statistics
+
+        :return: Dict of fps, target_fps, render_ms, submit_ms, frames and dropped
+        :rtype: dict
+        """
+        return self._ripple_effect.frame_stats
 
-        return result
+    def submit(self, name, func):
+        """
+        Queue blocking work on the device's worker
+
+        :param name: Name of the work, for logging
+        :type name: str
+
+        :param func: Function to call
+        :type func: callable
+        """
+        self._parent.submit(name, func)
 
     def set_rgb_matrix(self, payload):
         """
@@ -232,25 +339,22 @@ class RippleManager(object):
             if msg[2] == 'setRipple':
                 # Get (red, green, blue) tuple (args 3:6), and refreshrate arg 6
                 self._parent.key_manager.temp_key_store_state = True
-                self._ripple_thread.enable(msg[3:6], msg[6])
+                self._ripple_effect.enable(msg[3:6], msg[6])
             else:
                 # Effect other than ripple so stop
-                self._ripple_thread.disable()
+                self._ripple_effect.disable()
 
                 self._parent.key_manager.temp_key_store_state = False
 
     def close(self):
         """
-        Close the manager, stop ripple thread
+        Close the manager, stop ripple effect
         """
         if not self._is_closed:
             self._logger.debug("Closing Ripple Manager")
             self._is_closed = True
 
-            self._ripple_thread.shutdown = True
-            self._ripple_thread.join(timeout=2)
-            if self._ripple_thread.is_alive():
-                self._logger.error("Could not stop RippleEffect thread")
+            self._ripple_effect.disable()
 
     def __del__(self):
         self.close()
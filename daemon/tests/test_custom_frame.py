@@ -0,0 +1,74 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import unittest
+
+import numpy as np
+
+from openrazer_daemon.misc.custom_frame import diff_custom_frame, span_payload, apply_spans
+
+ROWS = 3
+COLUMNS = 4
+
+
+def row_payload(row_id, colours, start_col=0):
+    return bytes((row_id, start_col, start_col + len(colours) - 1)) + bytes(value for colour in colours for value in colour)
+
+
+def frame_payload(frame):
+    return b''.join(row_payload(row_id, row) for row_id, row in enumerate(frame))
+
+
+class CustomFrameTest(unittest.TestCase):
+    def setUp(self):
+        self.shown = np.zeros((ROWS, COLUMNS, 3), dtype=np.uint8)
+        self.known = np.zeros((ROWS, COLUMNS), dtype=bool)
+        self.frame = [[(row, col, 0) for col in range(COLUMNS)] for row in range(ROWS)]
+
+    def _write(self, payload, whole_rows=False):
+        spans = diff_custom_frame(self.shown, self.known, payload, whole_rows)
+        if spans is not None:
+            apply_spans(self.shown, self.known, spans)
+        return spans
+
+    def test_first_frame_is_written_in_full(self):
+        spans = self._write(frame_payload(self.frame))
+
+        self.assertEqual(b''.join(span_payload(*span) for span in spans), frame_payload(self.frame))
+        self.assertTrue(self.known.all())
+
+    def test_unchanged_frame_writes_nothing(self):
+        self._write(frame_payload(self.frame))
+
+        self.assertEqual(self._write(frame_payload(self.frame)), [])
+
+    def test_changed_row_is_cut_to_span(self):
+        self._write(frame_payload(self.frame))
+        self.frame[1][1] = (255, 255, 255)
+        self.frame[1][2] = (255, 0, 255)
+
+        spans = self._write(frame_payload(self.frame))
+
+        self.assertEqual([span_payload(*span) for span in spans], [row_payload(1, self.frame[1][1:3], start_col=1)])
+        self.assertEqual(tuple(self.shown[1, 2]), (255, 0, 255))
+
+    def test_whole_rows_keep_the_start_column(self):
+        self._write(frame_payload(self.frame))
+        self.frame[2][3] = (255, 255, 255)
+
+        spans = self._write(frame_payload(self.frame), whole_rows=True)
+
+        self.assertEqual([span_payload(*span) for span in spans], [row_payload(2, self.frame[2])])
+
+    def test_unknown_keys_are_written_again(self):
+        self._write(frame_payload(self.frame))
+        self.known[0, 2] = False
+
+        spans = self._write(frame_payload(self.frame))
+
+        self.assertEqual([span_payload(*span) for span in spans], [row_payload(0, self.frame[0][2:3], start_col=2)])
+
+    def test_malformed_payload(self):
+        self.assertIsNone(self._write(frame_payload(self.frame)[:-1]))
+        self.assertIsNone(self._write(row_payload(ROWS, self.frame[0])))
+        self.assertIsNone(self._write(row_payload(0, self.frame[0], start_col=1)))
+        self.assertFalse(self.known.any())
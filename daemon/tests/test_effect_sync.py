@@ -5,6 +5,11 @@ import unittest.mock
 
 import openrazer_daemon.misc.effect_sync
 
+try:
+    from openrazer_daemon.dbus_services.service import dispatched_method
+except ImportError:
+    dispatched_method = None
+
 # msg type = effect, arg = orig_device, arg = effect_name, arg.. = arg..
 MSG1 = ('effect', None, 'setBrightness', 255)
 
@@ -85,6 +90,25 @@ class EffectSyncTest(unittest.TestCase):
 
         self.assertEqual(num_args, 2)
 
+    @unittest.skipIf(dispatched_method is None, "dbus-python is not installed")
+    def test_dispatch_table_of_dbus_methods(self):
+        class DummyDBusDevice(DummyHardwareBlackWidowChroma):
+            pass
+
+        # Wrapped the way DBusService.add_dbus_method() does it
+        for name in ('setStatic', 'setBreathSingle'):
+            setattr(DummyDBusDevice, name, dispatched_method(getattr(DummyHardwareBlackWidowChroma, name), name, None))
+
+        table = openrazer_daemon.misc.effect_sync.EffectDispatchTable(DummyDBusDevice)
+
+        self.assertEqual(table.methods['setStatic'][1], 3)
+        self.assertEqual(table.methods['setBreathSingle'][1], 3)
+
+        device = DummyDBusDevice()
+        for effect_func, adapter in table.plan('setStatic'):
+            effect_func(device, *adapter((255, 0, 0)))
+        self.assertTupleEqual(device.effect_call, ('setStatic', 255, 0, 0))
+
     def test_notify_invalid_message(self):
         self.effect_sync.notify("test")
 
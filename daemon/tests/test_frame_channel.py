@@ -0,0 +1,156 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import os
+import struct
+import unittest
+import unittest.mock
+
+import openrazer_daemon.misc.frame_channel as frame_channel
+
+ROWS = 2
+COLUMNS = 3
+FRAME_SIZE = ROWS * (3 + COLUMNS * 3)
+
+
+class StubReactor(object):
+    """
+    Runs everything inline instead of on the reactor thread
+    """
+
+    def __init__(self):
+        self.readers = {}
+
+    def call_soon(self, callback, *args):
+        callback(*args)
+
+    def add_reader(self, fd, callback):
+        self.readers[fd] = callback
+
+    def remove_reader(self, fd):
+        del self.readers[fd]
+
+
+class StubWriter(object):
+    """
+    Stands in for the driver, and for the device's worker when deferred
+    """
+
+    def __init__(self, deferred=False):
+        self.frames = []
+        self.error = None
+        self.deferred = deferred
+        self.queued = []
+
+    def write(self, frame):
+        if self.error is not None:
+            raise self.error
+        self.frames.append(frame)
+
+    def submit(self, name, func):
+        if self.deferred:
+            self.queued.append(func)
+        else:
+            func()
+
+    def run_queued(self):
+        queued, self.queued = self.queued, []
+        for func in queued:
+            func()
+
+
+class FrameChannelTest(unittest.TestCase):
+    def setUp(self):
+        self.reactor = StubReactor()
+        patcher = unittest.mock.patch.object(frame_channel, 'get_reactor', return_value=self.reactor)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+    def _open(self, writer):
+        channel = frame_channel.FrameChannel(0, ROWS, COLUMNS, writer.write, writer.submit)
+        self.addCleanup(channel._close)
+        self.mmap = channel._mmap
+        return channel
+
+    def _publish(self, channel, payload, writing=False):
+        """
+        Publish a frame the way the client does
+        """
+        back = (struct.unpack_from('<I', self.mmap, frame_channel.FRONT_OFFSET)[0] & 1) ^ 1
+        sequence_offset = frame_channel.SEQUENCE_OFFSET + back * 4
+        sequence = struct.unpack_from('<I', self.mmap, sequence_offset)[0]
+
+        struct.pack_into('<I', self.mmap, sequence_offset, sequence + 1)
+        offset = frame_channel.FRAME_CHANNEL_HEADER_SIZE + back * FRAME_SIZE
+        self.mmap[offset:offset + FRAME_SIZE] = payload
+        if not writing:
+            struct.pack_into('<I', self.mmap, sequence_offset, sequence + 2)
+
+        struct.pack_into('<I', self.mmap, frame_channel.FRONT_OFFSET, back)
+        os.write(channel.signal_fd, b'\x01')
+        self.reactor.readers[channel._signal_read](0)
+
+    def _consumed(self):
+        return struct.unpack_from('<I', self.mmap, frame_channel.CONSUMED_OFFSET)[0]
+
+    def test_header(self):
+        channel = self._open(StubWriter())
+
+        self.assertEqual(channel.frame_size, FRAME_SIZE)
+        self.assertEqual(struct.unpack_from(frame_channel.FRAME_CHANNEL_HEADER_FORMAT, self.mmap, 0),
+                         (frame_channel.FRAME_CHANNEL_MAGIC, frame_channel.FRAME_CHANNEL_VERSION,
+                          frame_channel.FRAME_CHANNEL_HEADER_SIZE, FRAME_SIZE, ROWS, COLUMNS))
+
+    def test_frames_are_written(self):
+        writer = StubWriter()
+        channel = self._open(writer)
+
+        self._publish(channel, bytes([1]) * FRAME_SIZE)
+        self._publish(channel, bytes([2]) * FRAME_SIZE)
+
+        self.assertEqual(writer.frames, [bytes([1]) * FRAME_SIZE, bytes([2]) * FRAME_SIZE])
+        self.assertEqual(self._consumed(), 2)
+
+    def test_frame_being_written_is_skipped(self):
+        writer = StubWriter()
+        channel = self._open(writer)
+
+        self._publish(channel, bytes([1]) * FRAME_SIZE, writing=True)
+
+        self.assertEqual(writer.frames, [])
+        self.assertEqual(self._consumed(), 0)
+
+    def test_only_newest_frame_is_written_while_busy(self):
+        writer = StubWriter(deferred=True)
+        channel = self._open(writer)
+
+        self._publish(channel, bytes([1]) * FRAME_SIZE)
+        self._publish(channel, bytes([2]) * FRAME_SIZE)
+        self.assertEqual(len(writer.queued), 1)
+
+        writer.run_queued()
+
+        self.assertEqual(writer.frames, [bytes([2]) * FRAME_SIZE])
+        self.assertEqual(self._consumed(), 1)
+
+    def test_failed_write_is_not_counted(self):
+        writer = StubWriter()
+        writer.error = OSError("Device gone")
+        channel = self._open(writer)
+
+        self._publish(channel, bytes([1]) * FRAME_SIZE)
+        self.assertEqual(self._consumed(), 0)
+
+        writer.error = None
+        self._publish(channel, bytes([2]) * FRAME_SIZE)
+        self.assertEqual(writer.frames, [bytes([2]) * FRAME_SIZE])
+        self.assertEqual(self._consumed(), 1)
+
+    def test_closes_when_client_goes_away(self):
+        channel = self._open(StubWriter())
+        signal_read = channel._signal_read
+
+        channel.release_client_fds()
+        self.reactor.readers[signal_read](0)
+
+        self.assertNotIn(signal_read, self.reactor.readers)
+        self.assertTrue(channel._closed)
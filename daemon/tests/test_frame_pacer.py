@@ -0,0 +1,81 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import unittest
+
+from openrazer_daemon.misc.frame_pacer import FramePacer
+
+
+class StubClock(object):
+    """
+    Monotonic clock that only moves when told to
+    """
+
+    def __init__(self):
+        self.now = 100.0
+
+    def __call__(self):
+        return self.now
+
+
+class FramePacerTest(unittest.TestCase):
+    def setUp(self):
+        self.clock = StubClock()
+        self.pacer = FramePacer(0.1, clock=self.clock)
+
+    def _frame(self, render=0.0, submit=0.0):
+        self.pacer.start_frame()
+        self.clock.now += render
+        self.pacer.rendered()
+        self.clock.now += submit
+        self.pacer.submitted()
+        return self.pacer.next_delay()
+
+    def test_work_is_taken_off_the_delay(self):
+        self.assertAlmostEqual(self._frame(render=0.02, submit=0.03), 0.05)
+        self.assertEqual(self.pacer.dropped, 0)
+
+    def test_deadlines_do_not_drift(self):
+        for _ in range(10):
+            delay = self._frame(render=0.01)
+            self.clock.now += delay
+
+        self.assertAlmostEqual(self.clock.now, 101.0)
+        self.assertEqual(self.pacer.frames, 10)
+        self.assertAlmostEqual(self.pacer.fps, 10.0)
+
+    def test_missed_deadlines_are_dropped(self):
+        delay = self._frame()
+        self.clock.now += delay
+
+        delay = self._frame(render=0.25)
+
+        self.assertEqual(self.pacer.dropped, 2)
+        self.assertAlmostEqual(delay, 0.05)
+
+    def test_reset_starts_a_new_schedule(self):
+        delay = self._frame()
+        self.clock.now += delay
+        self.pacer.reset()
+        self.clock.now += 5
+
+        self.assertAlmostEqual(self._frame(), 0.1)
+        self.assertEqual(self.pacer.dropped, 0)
+
+    def test_stats(self):
+        self._frame(render=0.02, submit=0.03)
+
+        stats = self.pacer.stats()
+
+        self.assertAlmostEqual(stats['target_fps'], 10.0)
+        self.assertAlmostEqual(stats['render_ms'], 20.0)
+        self.assertAlmostEqual(stats['submit_ms'], 30.0)
+        self.assertEqual(stats['frames'], 1.0)
+        self.assertEqual(stats['dropped'], 0.0)
+
+    def test_no_interval_does_not_wait(self):
+        pacer = FramePacer(0, clock=self.clock)
+        pacer.start_frame()
+
+        self.assertEqual(pacer.next_delay(), 0)
+        self.assertEqual(pacer.stats()['target_fps'], 0.0)
+
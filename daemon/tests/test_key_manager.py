@@ -0,0 +1,134 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import struct
+import unittest
+import unittest.mock
+
+import openrazer_daemon.misc.key_event_management as key_event_management
+
+KEY_MACROMODE = 188
+KEY_GAMEMODE = 189
+KEY_BRIGHTNESSDOWN = 190
+KEY_BRIGHTNESSUP = 194
+KEY_M1 = 183
+
+
+def event_record(sec, usec, ev_type, code, value):
+    return struct.pack('@llHHI', sec, usec, ev_type, code, value)
+
+
+class ParseEventRecordsTest(unittest.TestCase):
+    def test_only_key_events_are_returned(self):
+        data = bytearray(event_record(1, 2, key_event_management.EV_KEY, 30, 1) +
+                         event_record(1, 3, 0, 0, 0) +
+                         event_record(2, 4, 4, 4, 458756) +
+                         event_record(3, 5, key_event_management.EV_KEY, 31, 0) +
+                         event_record(3, 6, key_event_management.EV_KEY, 32, 2) +
+                         event_record(3, 7, key_event_management.EV_KEY, 33, 7))
+
+        events = list(key_event_management.KeyWatcher.parse_event_records(memoryview(data)))
+
+        self.assertEqual(events, [(1000002000, 'press', 30), (3000005000, 'release', 31),
+                                  (3000006000, 'autorepeat', 32), (3000007000, 'unknown', 33)])
+
+    def test_empty_buffer(self):
+        self.assertEqual(list(key_event_management.KeyWatcher.parse_event_records(b'')), [])
+
+
+class StubDevice(object):
+    """
+    Stands in for the device, calls are queued like on its worker and the driver is recorded
+    """
+
+    def __init__(self):
+        self.method_args = {}
+        self.queued = []
+        self.driver_calls = []
+        self.game_mode = False
+        self.brightness = 50
+
+    def register_observer(self, observer):
+        pass
+
+    def submit(self, name, func):
+        self.queued.append(func)
+
+    def run_queued(self):
+        queued, self.queued = self.queued, []
+        for func in queued:
+            func()
+
+    def setMacroEffect(self, effect):
+        self.driver_calls.append(('setMacroEffect', effect))
+
+    def setMacroMode(self, enabled):
+        self.driver_calls.append(('setMacroMode', enabled))
+
+    def getGameMode(self):
+        self.driver_calls.append(('getGameMode',))
+        return self.game_mode
+
+    def setGameMode(self, enabled):
+        self.driver_calls.append(('setGameMode', enabled))
+        self.game_mode = enabled
+
+    def getBrightness(self):
+        self.driver_calls.append(('getBrightness',))
+        return self.brightness
+
+    def setBrightness(self, brightness):
+        self.driver_calls.append(('setBrightness', brightness))
+        self.brightness = brightness
+
+
+class KeyboardKeyManagerTest(unittest.TestCase):
+    def setUp(self):
+        patcher = unittest.mock.patch.object(key_event_management, 'get_reactor')
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+        self.device = StubDevice()
+        self.key_manager = key_event_management.KeyboardKeyManager(0, [], self.device, testing=True)
+
+    def _press(self, key_id):
+        self.key_manager.key_action(0, key_id, 'press')
+        self.key_manager.key_action(0, key_id, 'release')
+
+    def test_no_driver_io_on_the_reactor(self):
+        for key_id in (KEY_MACROMODE, KEY_M1, KEY_MACROMODE, KEY_GAMEMODE, KEY_BRIGHTNESSDOWN, KEY_BRIGHTNESSUP):
+            self._press(key_id)
+
+        self.assertEqual(self.device.driver_calls, [])
+        self.assertEqual(len(self.device.queued), 6)
+
+    def test_macro_recording(self):
+        self._press(KEY_MACROMODE)
+        self.device.run_queued()
+        self.assertEqual(self.device.driver_calls, [('setMacroEffect', 0x01), ('setMacroMode', True)])
+
+        self._press(KEY_M1)
+        self._press(KEY_MACROMODE)
+        self.device.run_queued()
+        self.assertEqual(self.device.driver_calls[2:], [('setMacroEffect', 0x00), ('setMacroEffect', 0x00), ('setMacroMode', False)])
+
+    def test_game_mode_is_toggled(self):
+        self._press(KEY_GAMEMODE)
+        self.device.run_queued()
+
+        self.assertTrue(self.device.game_mode)
+
+    def test_brightness_steps_stay_in_range(self):
+        self.device.brightness = 95
+        self._press(KEY_BRIGHTNESSUP)
+        self._press(KEY_BRIGHTNESSUP)
+        self.device.run_queued()
+
+        self.assertEqual(self.device.brightness, 100)
+        self.assertEqual(self.device.driver_calls.count(('setBrightness', 100)), 1)
+
+    def test_brightness_uses_the_last_value_set(self):
+        self.device.method_args['brightness'] = 30
+        self._press(KEY_BRIGHTNESSDOWN)
+        self.device.run_queued()
+
+        self.assertEqual(self.device.driver_calls, [('setBrightness', 20)])
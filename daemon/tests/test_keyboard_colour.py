@@ -0,0 +1,82 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import unittest
+
+from openrazer_daemon.keyboard import KeyboardColour, KeyDoesNotExistError, NoBackupError, KEY_MAPPING
+
+
+def row_payload(row_id, colours):
+    return bytes((row_id, 0, len(colours) - 1)) + bytes(value for colour in colours for value in colour)
+
+
+class KeyboardColourTest(unittest.TestCase):
+    def test_payload_matches_the_driver_format(self):
+        for rows, columns in ((6, 22), (1, 1), (4, 5), (9, 24)):
+            keyboard = KeyboardColour(rows, columns)
+            keyboard.set_key_colour(rows - 1, columns - 1, (1, 2, 3))
+
+            expected = [[(0, 0, 0)] * columns for _ in range(rows)]
+            expected[rows - 1][columns - 1] = (1, 2, 3)
+
+            self.assertEqual(bytes(keyboard.get_total_binary()), b''.join(row_payload(row_id, row) for row_id, row in enumerate(expected)))
+            self.assertEqual(bytes(keyboard.get_row_binary(rows - 1)), row_payload(rows - 1, expected[rows - 1]))
+            self.assertEqual(keyboard.get_rows_raw(), expected)
+
+    def test_colours_are_clamped(self):
+        keyboard = KeyboardColour(2, 3)
+
+        keyboard.set_key_colour(1, 2, (300, -5, 127.9))
+
+        self.assertEqual(keyboard.get_key_colour_at(1, 2), (255, 0, 127))
+
+    def test_keys_outside_the_matrix(self):
+        keyboard = KeyboardColour(2, 3)
+
+        with self.assertRaises(KeyDoesNotExistError):
+            keyboard.set_key_colour(2, 0, (1, 2, 3))
+        with self.assertRaises(KeyDoesNotExistError):
+            keyboard.get_key_colour_at(0, -1)
+        with self.assertRaises(KeyDoesNotExistError):
+            keyboard.get_key_colour('NOT_A_KEY')
+
+    def test_get_key_colour_by_name(self):
+        keyboard = KeyboardColour(6, 22)
+        row, col = KEY_MAPPING['ESC']
+
+        keyboard.set_key_colour(row, col, (10, 20, 30))
+
+        self.assertEqual(keyboard.get_key_colour('ESC'), (10, 20, 30))
+
+    def test_reset(self):
+        keyboard = KeyboardColour(2, 3)
+        keyboard.set_key_colour(0, 0, (1, 2, 3))
+        keyboard.set_key_colour(1, 1, (4, 5, 6))
+
+        keyboard.reset_key(0, 0)
+        self.assertEqual(keyboard.get_key_colour_at(0, 0), (0, 0, 0))
+
+        keyboard.reset_rows()
+        self.assertEqual(bytes(keyboard.get_total_binary()), row_payload(0, [(0, 0, 0)] * 3) + row_payload(1, [(0, 0, 0)] * 3))
+
+    def test_load_total_binary(self):
+        source = KeyboardColour(3, 4)
+        source.set_key_colour(2, 3, (7, 8, 9))
+        keyboard = KeyboardColour(3, 4)
+
+        keyboard.get_from_total_binary(bytes(source.get_total_binary()))
+
+        self.assertEqual(keyboard.get_key_colour_at(2, 3), (7, 8, 9))
+        with self.assertRaises(ValueError):
+            keyboard.get_from_total_binary(b'\x00' * 5)
+
+    def test_backup_and_restore(self):
+        keyboard = KeyboardColour(2, 3)
+        with self.assertRaises(NoBackupError):
+            keyboard.restore_configuration()
+
+        keyboard.set_key_colour(0, 1, (1, 2, 3))
+        keyboard.backup_configuration()
+        keyboard.set_key_colour(0, 1, (4, 5, 6))
+        keyboard.restore_configuration()
+
+        self.assertEqual(keyboard.get_key_colour_at(0, 1), (1, 2, 3))
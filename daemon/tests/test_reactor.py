@@ -0,0 +1,48 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import os
+import unittest
+
+from openrazer_daemon.misc.reactor import Reactor
+
+
+class ReactorTimerTest(unittest.TestCase):
+    def setUp(self):
+        # Not started, the timers are run by hand
+        self.reactor = Reactor()
+        self.addCleanup(self._close)
+
+    def _close(self):
+        self.reactor._epoll.close()
+        os.close(self.reactor._wakeup_read)
+        os.close(self.reactor._wakeup_write)
+
+    def test_cancelled_timers_do_not_pile_up(self):
+        live = self.reactor.call_later(3600, lambda: None)
+
+        for _ in range(1000):
+            self.reactor.call_later(60, lambda: None).cancel()
+
+        self.assertLessEqual(len(self.reactor._timers), 2)
+        self.assertIn(live, [entry[2] for entry in self.reactor._timers])
+
+    def test_cancelled_timers_do_not_run(self):
+        ran = []
+        timers = [self.reactor.call_soon(ran.append, number) for number in range(5)]
+        timers[1].cancel()
+        timers[3].cancel()
+
+        self.reactor._run_timers()
+
+        self.assertEqual(ran, [0, 2, 4])
+        self.assertEqual(self.reactor._timers, [])
+        self.assertEqual(self.reactor._cancelled_timers, 0)
+
+    def test_cancel_after_running_does_nothing(self):
+        timer = self.reactor.call_soon(lambda: None)
+        self.reactor._run_timers()
+
+        timer.cancel()
+
+        self.assertEqual(self.reactor._cancelled_timers, 0)
+        self.assertEqual(self.reactor._next_timeout(), -1)
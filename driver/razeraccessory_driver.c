@@ -10,6 +10,8 @@
 #include <linux/usb/input.h>
 #include <linux/hid.h>
 #include <linux/random.h>
+#include <linux/ktime.h>
+#include <linux/workqueue.h>
 
 #include "razeraccessory_driver.h"
 #include "razercommon.h"
@@ -1075,6 +1077,9 @@ static ssize_t razer_attr_write_device_mode(struct device *dev, struct device_at
         return -EINVAL;
     }
 
+    // Don't let the mode switch done after probe override this one
+    flush_work(&device->init_work);
+
     request = razer_chroma_standard_set_device_mode(buf[0], buf[1]);
 
     switch(device->usb_pid) {
@@ -1233,7 +1238,9 @@ static ssize_t razer_attr_write_matrix_brightness(struct device *dev, struct dev
     }
 
     mutex_lock(&device->lock);
-    razer_send_payload(device->usb_dev, &request, &response);
+    if(!razer_send_payload(device->usb_dev, &request, &response)) {
+        razer_cache_value(&device->cached[RAZER_ACCESSORY_CAP_MATRIX_BRIGHTNESS], "%d", brightness);
+    }
     mutex_unlock(&device->lock);
 
     return count;
@@ -1283,7 +1290,9 @@ static ssize_t razer_attr_read_matrix_brightness(struct device *dev, struct devi
     default:
         request = razer_chroma_standard_get_led_brightness(VARSTORE, BACKLIGHT_LED);
         mutex_lock(&device->lock);
-        razer_send_payload(device->usb_dev, &request, &response);
+        if(!razer_send_payload(device->usb_dev, &request, &response)) {
+            razer_cache_value(&device->cached[RAZER_ACCESSORY_CAP_MATRIX_BRIGHTNESS], "%d", response.arguments[2]);
+        }
         mutex_unlock(&device->lock);
         brightness = response.arguments[2];
         break;
@@ -2012,6 +2021,193 @@ static DEVICE_ATTR(channel6_led_brightness,                 0660, razer_attr_rea
 
 static DEVICE_ATTR(is_mug_present,                          0440, razer_attr_read_is_mug_present,                 NULL);
 
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf);
+static DEVICE_ATTR(capabilities,            0440, razer_attr_read_capabilities,               NULL);
+
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count);
+static BIN_ATTR(state_snapshot, 0440, razer_attr_read_state_snapshot, NULL, RAZER_STATE_SNAPSHOT_SIZE);
+
+/**
+ * Every attribute the driver knows about, indexed by capability bit
+ */
+static struct attribute *razer_accessory_attrs[] = {
+    [RAZER_ACCESSORY_CAP_VERSION] = &dev_attr_version.attr,                              // Get driver version
+    [RAZER_ACCESSORY_CAP_TEST] = &dev_attr_test.attr,                                    // Test mode
+    [RAZER_ACCESSORY_CAP_DEVICE_TYPE] = &dev_attr_device_type.attr,                      // Get string of device type
+    [RAZER_ACCESSORY_CAP_DEVICE_MODE] = &dev_attr_device_mode.attr,                      // Get string of device mode
+    [RAZER_ACCESSORY_CAP_DEVICE_SERIAL] = &dev_attr_device_serial.attr,                  // Get string of device serial
+    [RAZER_ACCESSORY_CAP_FIRMWARE_VERSION] = &dev_attr_firmware_version.attr,            // Get string of device fw version
+    [RAZER_ACCESSORY_CAP_CAPABILITIES] = &dev_attr_capabilities.attr,                    // Get the list of supported attributes
+    [RAZER_ACCESSORY_CAP_MATRIX_CUSTOM_FRAME] = &dev_attr_matrix_custom_frame.attr,      // Custom effect frame
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_NONE] = &dev_attr_matrix_effect_none.attr,        // No effect
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_STATIC] = &dev_attr_matrix_effect_static.attr,    // Static effect
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_BREATH] = &dev_attr_matrix_effect_breath.attr,    // Breathing effect
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_CUSTOM] = &dev_attr_matrix_effect_custom.attr,    // Custom effect
+    [RAZER_ACCESSORY_CAP_MATRIX_BRIGHTNESS] = &dev_attr_matrix_brightness.attr,          // Brightness
+    [RAZER_ACCESSORY_CAP_CHARGING_LED_BRIGHTNESS] = &dev_attr_charging_led_brightness.attr, // Charging effects
+    [RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_WAVE] = &dev_attr_charging_matrix_effect_wave.attr,
+    [RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_SPECTRUM] = &dev_attr_charging_matrix_effect_spectrum.attr,
+    [RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_BREATH] = &dev_attr_charging_matrix_effect_breath.attr,
+    [RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_STATIC] = &dev_attr_charging_matrix_effect_static.attr,
+    [RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_NONE] = &dev_attr_charging_matrix_effect_none.attr,
+    [RAZER_ACCESSORY_CAP_FAST_CHARGING_LED_BRIGHTNESS] = &dev_attr_fast_charging_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_WAVE] = &dev_attr_fast_charging_matrix_effect_wave.attr,
+    [RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_SPECTRUM] = &dev_attr_fast_charging_matrix_effect_spectrum.attr,
+    [RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_BREATH] = &dev_attr_fast_charging_matrix_effect_breath.attr,
+    [RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_STATIC] = &dev_attr_fast_charging_matrix_effect_static.attr,
+    [RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_NONE] = &dev_attr_fast_charging_matrix_effect_none.attr,
+    [RAZER_ACCESSORY_CAP_FULLY_CHARGED_LED_BRIGHTNESS] = &dev_attr_fully_charged_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_WAVE] = &dev_attr_fully_charged_matrix_effect_wave.attr,
+    [RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_SPECTRUM] = &dev_attr_fully_charged_matrix_effect_spectrum.attr,
+    [RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_BREATH] = &dev_attr_fully_charged_matrix_effect_breath.attr,
+    [RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_STATIC] = &dev_attr_fully_charged_matrix_effect_static.attr,
+    [RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_NONE] = &dev_attr_fully_charged_matrix_effect_none.attr,
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_SPECTRUM] = &dev_attr_matrix_effect_spectrum.attr, // Spectrum effect
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_WAVE] = &dev_attr_matrix_effect_wave.attr,        // Wave effect
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_REACTIVE] = &dev_attr_matrix_effect_reactive.attr, // Reactive
+    [RAZER_ACCESSORY_CAP_MATRIX_REACTIVE_TRIGGER] = &dev_attr_matrix_reactive_trigger.attr, // Reactive trigger
+    [RAZER_ACCESSORY_CAP_IS_MUG_PRESENT] = &dev_attr_is_mug_present.attr,                // Is cup present
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_BLINKING] = &dev_attr_matrix_effect_blinking.attr, // Blinking effect
+    [RAZER_ACCESSORY_CAP_MATRIX_EFFECT_STARLIGHT] = &dev_attr_matrix_effect_starlight.attr,
+    [RAZER_ACCESSORY_CAP_RESET_CHANNELS] = &dev_attr_reset_channels.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL1_SIZE] = &dev_attr_channel1_size.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL2_SIZE] = &dev_attr_channel2_size.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL3_SIZE] = &dev_attr_channel3_size.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL4_SIZE] = &dev_attr_channel4_size.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL5_SIZE] = &dev_attr_channel5_size.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL6_SIZE] = &dev_attr_channel6_size.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL1_LED_BRIGHTNESS] = &dev_attr_channel1_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL2_LED_BRIGHTNESS] = &dev_attr_channel2_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL3_LED_BRIGHTNESS] = &dev_attr_channel3_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL4_LED_BRIGHTNESS] = &dev_attr_channel4_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL5_LED_BRIGHTNESS] = &dev_attr_channel5_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_CHANNEL6_LED_BRIGHTNESS] = &dev_attr_channel6_led_brightness.attr,
+    [RAZER_ACCESSORY_CAP_COUNT] = NULL
+};
+
+/**
+ * Only show the attributes the bound device has a capability bit for
+ */
+static umode_t razer_accessory_attr_is_visible(struct kobject *kobj, struct attribute *attr, int n)
+{
+    struct razer_accessory_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(n, device->caps)) {
+        return 0;
+    }
+
+    return attr->mode;
+}
+
+/**
+ * Read device file "capabilities"
+ *
+ * Returns the names of the attributes supported by the device, space separated
+ */
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct razer_accessory_device *device = dev_get_drvdata(dev);
+
+    return razer_print_caps(buf, razer_accessory_attrs, device->caps, RAZER_ACCESSORY_CAP_COUNT);
+}
+
+/**
+ * Settings whose show functions cache what they read from the device
+ */
+static const unsigned int razer_accessory_cached_caps[] = {
+    RAZER_ACCESSORY_CAP_MATRIX_BRIGHTNESS,
+};
+
+/**
+ * Read device file "state_snapshot"
+ *
+ * Returns the driver version, device type, capabilities and the cached settings in one packed
+ * blob, see razercommon.h for the layout. The first read after probe or resume reads the cached
+ * settings from the device, later reads don't talk to the device. It has to be read in one go,
+ * reads at an offset return nothing.
+ */
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count)
+{
+    struct device *dev = kobj_to_dev(kobj);
+    struct razer_accessory_device *device = dev_get_drvdata(dev);
+    DECLARE_BITMAP(cheap_caps, RAZER_ACCESSORY_CAP_COUNT) = {0};
+    ssize_t len;
+
+    if(off) {
+        return 0;
+    }
+
+    set_bit(RAZER_ACCESSORY_CAP_VERSION, cheap_caps);
+    set_bit(RAZER_ACCESSORY_CAP_DEVICE_TYPE, cheap_caps);
+    set_bit(RAZER_ACCESSORY_CAP_CAPABILITIES, cheap_caps);
+
+    if(!READ_ONCE(device->settings_cached)) {
+        razer_fill_settings_cache(dev, razer_accessory_attrs, device->caps, razer_accessory_cached_caps, ARRAY_SIZE(razer_accessory_cached_caps));
+        WRITE_ONCE(device->settings_cached, true);
+    }
+
+    mutex_lock(&device->lock);
+    len = razer_build_state_snapshot(dev, razer_accessory_attrs, device->caps, cheap_caps, device->cached, RAZER_ACCESSORY_CAP_COUNT, buf, count);
+    mutex_unlock(&device->lock);
+
+    return len;
+}
+
+static struct bin_attribute *razer_accessory_bin_attrs[] = {
+    &bin_attr_state_snapshot,
+    NULL
+};
+
+/**
+ * The snapshot is available wherever the capability list is
+ */
+static umode_t razer_accessory_bin_attr_is_visible(struct kobject *kobj, struct bin_attribute *attr, int n)
+{
+    struct razer_accessory_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(RAZER_ACCESSORY_CAP_CAPABILITIES, device->caps)) {
+        return 0;
+    }
+
+    return attr->attr.mode;
+}
+
+static const struct attribute_group razer_accessory_group = {
+    .attrs = razer_accessory_attrs,
+    .bin_attrs = razer_accessory_bin_attrs,
+    .is_visible = razer_accessory_attr_is_visible,
+    .is_bin_visible = razer_accessory_bin_attr_is_visible,
+};
+
+__ATTRIBUTE_GROUPS(razer_accessory);
+
+/**
+ * Deferred part of the probe
+ *
+ * Does the USB round trips that aren't needed to register the device so probe doesn't
+ * stall on them, especially when several devices are plugged in at once.
+ */
+static void razer_accessory_init_work(struct work_struct *work)
+{
+    struct razer_accessory_device *dev = container_of(work, struct razer_accessory_device, init_work);
+
+    switch(dev->usb_pid) {
+    case USB_DEVICE_ID_RAZER_KRAKEN_KITTY_EDITION:
+    // Needs to be in "Normal" mode for idle effects to function properly
+    case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
+        break;
+
+    default:
+        // Needs to be in "Driver" mode just to function
+        mutex_lock(&dev->lock);
+        razer_set_device_mode(dev->usb_dev, 0x03, 0x00);
+        mutex_unlock(&dev->lock);
+        break;
+    }
+
+    hid_dbg(dev->hdev, "initialised in %lld us\n", ktime_us_delta(ktime_get(), dev->probe_start));
+}
+
 void razer_accessory_init(struct razer_accessory_device *dev, struct usb_interface *intf, struct hid_device *hdev)
 {
     struct usb_device *usb_dev = interface_to_usbdev(intf);
@@ -2024,6 +2220,8 @@ void razer_accessory_init(struct razer_accessory_device *dev, struct usb_interfa
     dev->usb_vid = usb_dev->descriptor.idVendor;
     dev->usb_pid = usb_dev->descriptor.idProduct;
     dev->usb_interface_protocol = intf->cur_altsetting->desc.bInterfaceProtocol;
+    dev->hdev = hdev;
+    INIT_WORK(&dev->init_work, razer_accessory_init_work);
 
     // Get a "random" integer
     get_random_bytes(&rand_serial, sizeof(unsigned int));
@@ -2116,6 +2314,7 @@ static int razer_accessory_probe(struct hid_device *hdev, const struct hid_devic
     }
 
     // Init data
+    dev->probe_start = ktime_get();
     razer_accessory_init(dev, intf, hdev);
 
     switch(usb_dev->descriptor.idProduct) {
@@ -2151,43 +2350,44 @@ static int razer_accessory_probe(struct hid_device *hdev, const struct hid_devic
     }
 
     if(dev->usb_interface_protocol == expected_protocol) {
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_version);                               // Get driver version
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_test);                                  // Test mode
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_type);                           // Get string of device type
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_mode);                           // Get string of device mode
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_serial);                         // Get string of device serial
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_firmware_version);                      // Get string of device fw version
-
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);                   // Custom effect frame
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);                    // No effect
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);                  // Static effect
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);                  // Breathing effect
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);                  // Custom effect
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);                     // Brightness
+        set_bit(RAZER_ACCESSORY_CAP_VERSION, dev->caps);
+        set_bit(RAZER_ACCESSORY_CAP_TEST, dev->caps);
+        set_bit(RAZER_ACCESSORY_CAP_DEVICE_TYPE, dev->caps);
+        set_bit(RAZER_ACCESSORY_CAP_DEVICE_MODE, dev->caps);
+        set_bit(RAZER_ACCESSORY_CAP_DEVICE_SERIAL, dev->caps);
+        set_bit(RAZER_ACCESSORY_CAP_FIRMWARE_VERSION, dev->caps);
+        set_bit(RAZER_ACCESSORY_CAP_CAPABILITIES, dev->caps);
+
+        set_bit(RAZER_ACCESSORY_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                     // Custom effect frame
+        set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_NONE, dev->caps);                      // No effect
+        set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_STATIC, dev->caps);                    // Static effect
+        set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_BREATH, dev->caps);                    // Breathing effect
+        set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                    // Custom effect
+        set_bit(RAZER_ACCESSORY_CAP_MATRIX_BRIGHTNESS, dev->caps);                       // Brightness
 
         switch(usb_dev->descriptor.idProduct) {
         case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
             // Razer has also added a "Fast Wave" effect for at least this device
             // which uses the same effect command but a speed parameter of 0x10.
             // It has not been implemented.
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charging_led_brightness);           // Charging effects
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charging_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charging_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charging_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charging_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charging_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fast_charging_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fast_charging_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fast_charging_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fast_charging_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fast_charging_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fast_charging_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fully_charged_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fully_charged_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fully_charged_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fully_charged_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fully_charged_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fully_charged_matrix_effect_none);
+            set_bit(RAZER_ACCESSORY_CAP_CHARGING_LED_BRIGHTNESS, dev->caps);             // Charging effects
+            set_bit(RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FAST_CHARGING_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FULLY_CHARGED_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_NONE, dev->caps);
             break;
         }
 
@@ -2223,7 +2423,7 @@ static int razer_accessory_probe(struct hid_device *hdev, const struct hid_devic
         case USB_DEVICE_ID_RAZER_MOUSE_DOCK:
         case USB_DEVICE_ID_RAZER_RAPTOR_27:
         case USB_DEVICE_ID_RAZER_LAPTOP_STAND_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);            // Spectrum effect
+            set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);              // Spectrum effect
             break;
         }
 
@@ -2245,7 +2445,7 @@ static int razer_accessory_probe(struct hid_device *hdev, const struct hid_devic
         case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
         case USB_DEVICE_ID_RAZER_RAPTOR_27:
         case USB_DEVICE_ID_RAZER_LAPTOP_STAND_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);                // Wave effect
+            set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_WAVE, dev->caps);                  // Wave effect
             break;
         }
 
@@ -2258,15 +2458,15 @@ static int razer_accessory_probe(struct hid_device *hdev, const struct hid_devic
         case USB_DEVICE_ID_RAZER_CORE:
         case USB_DEVICE_ID_RAZER_CORE_X_CHROMA:
         case USB_DEVICE_ID_RAZER_LAPTOP_STAND_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);            // Reactive
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_reactive_trigger);           // Reactive trigger
+            set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);              // Reactive
+            set_bit(RAZER_ACCESSORY_CAP_MATRIX_REACTIVE_TRIGGER, dev->caps);             // Reactive trigger
             break;
         }
 
         switch(usb_dev->descriptor.idProduct) {
         case USB_DEVICE_ID_RAZER_CHROMA_MUG:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_is_mug_present);                    // Is cup present
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_blinking);            // Blinking effect
+            set_bit(RAZER_ACCESSORY_CAP_IS_MUG_PRESENT, dev->caps);                      // Is cup present
+            set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_BLINKING, dev->caps);              // Blinking effect
             break;
         }
 
@@ -2274,37 +2474,25 @@ static int razer_accessory_probe(struct hid_device *hdev, const struct hid_devic
         case USB_DEVICE_ID_RAZER_KRAKEN_KITTY_EDITION:
         case USB_DEVICE_ID_RAZER_THUNDERBOLT_4_DOCK_CHROMA:
         case USB_DEVICE_ID_RAZER_CORE_X_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);
+            set_bit(RAZER_ACCESSORY_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);
             break;
         }
 
         switch(usb_dev->descriptor.idProduct) {
         case USB_DEVICE_ID_RAZER_CHROMA_ADDRESSABLE_RGB_CONTROLLER:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_reset_channels);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel1_size);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel2_size);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel3_size);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel4_size);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel5_size);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel6_size);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel1_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel2_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel3_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel4_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel5_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_channel6_led_brightness);
-            break;
-        }
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_KRAKEN_KITTY_EDITION:
-        // Needs to be in "Normal" mode for idle effects to function properly
-        case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
-            break;
-
-        default:
-            // Needs to be in "Driver" mode just to function
-            razer_set_device_mode(dev->usb_dev, 0x03, 0x00);
+            set_bit(RAZER_ACCESSORY_CAP_RESET_CHANNELS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL1_SIZE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL2_SIZE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL3_SIZE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL4_SIZE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL5_SIZE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL6_SIZE, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL1_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL2_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL3_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL4_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL5_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_ACCESSORY_CAP_CHANNEL6_LED_BRIGHTNESS, dev->caps);
             break;
         }
     }
@@ -2312,18 +2500,26 @@ static int razer_accessory_probe(struct hid_device *hdev, const struct hid_devic
     hid_set_drvdata(hdev, dev);
     dev_set_drvdata(&hdev->dev, dev);
 
-    if(hid_parse(hdev)) {
+    retval = hid_parse(hdev);
+    if(retval) {
         hid_err(hdev, "parse failed\n");
         goto exit_free;
     }
 
-    if (hid_hw_start(hdev, HID_CONNECT_DEFAULT)) {
+    retval = hid_hw_start(hdev, HID_CONNECT_DEFAULT);
+    if(retval) {
         hid_err(hdev, "hw start failed\n");
         goto exit_free;
     }
 
     usb_disable_autosuspend(usb_dev);
 
+    if(dev->usb_interface_protocol == expected_protocol) {
+        schedule_work(&dev->init_work);
+    }
+
+    hid_dbg(hdev, "probe took %lld us\n", ktime_us_delta(ktime_get(), dev->probe_start));
+
     return 0;
 exit:
     return retval;
@@ -2337,185 +2533,37 @@ exit_free:
  */
 static void razer_accessory_disconnect(struct hid_device *hdev)
 {
-    unsigned char expected_protocol = USB_INTERFACE_PROTOCOL_MOUSE;
     struct razer_accessory_device *dev;
     struct usb_interface *intf = to_usb_interface(hdev->dev.parent);
-    struct usb_device *usb_dev = interface_to_usbdev(intf);
 
     dev = hid_get_drvdata(hdev);
 
+    cancel_work_sync(&dev->init_work);
     dev->firmware_version[0] = 0;
 
-    switch(usb_dev->descriptor.idProduct) {
-    case USB_DEVICE_ID_RAZER_CORE:
-    case USB_DEVICE_ID_RAZER_FIREFLY_V2:
-    case USB_DEVICE_ID_RAZER_KRAKEN_KITTY_EDITION:
-    case USB_DEVICE_ID_RAZER_MOUSE_BUNGEE_V3_CHROMA:
-    case USB_DEVICE_ID_RAZER_BASE_STATION_V2_CHROMA:
-    case USB_DEVICE_ID_RAZER_THUNDERBOLT_4_DOCK_CHROMA:
-    case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
-    case USB_DEVICE_ID_RAZER_RAPTOR_27:
-    case USB_DEVICE_ID_RAZER_CHROMA_ADDRESSABLE_RGB_CONTROLLER:
-        expected_protocol = 0;
-        break;
-
-    case USB_DEVICE_ID_RAZER_FIREFLY:
-    case USB_DEVICE_ID_RAZER_FIREFLY_HYPERFLUX:
-    case USB_DEVICE_ID_RAZER_GOLIATHUS_CHROMA:
-    case USB_DEVICE_ID_RAZER_GOLIATHUS_CHROMA_EXTENDED:
-    case USB_DEVICE_ID_RAZER_CHROMA_MUG:
-    case USB_DEVICE_ID_RAZER_CHROMA_HDK:
-    case USB_DEVICE_ID_RAZER_CHROMA_BASE:
-    case USB_DEVICE_ID_RAZER_MOUSE_DOCK:
-        expected_protocol = USB_INTERFACE_PROTOCOL_MOUSE;
-        break;
-
-    case USB_DEVICE_ID_RAZER_NOMMO_PRO:
-    case USB_DEVICE_ID_RAZER_NOMMO_CHROMA:
-    case USB_DEVICE_ID_RAZER_CORE_X_CHROMA:
-    case USB_DEVICE_ID_RAZER_LAPTOP_STAND_CHROMA:
-        expected_protocol = USB_INTERFACE_PROTOCOL_KEYBOARD;
-        break;
-    }
-
-    if(dev->usb_interface_protocol == expected_protocol) {
-        device_remove_file(&hdev->dev, &dev_attr_version);                               // Get driver version
-        device_remove_file(&hdev->dev, &dev_attr_test);                                  // Test mode
-        device_remove_file(&hdev->dev, &dev_attr_device_type);                           // Get string of device type
-        device_remove_file(&hdev->dev, &dev_attr_device_mode);                           // Get string of device mode
-        device_remove_file(&hdev->dev, &dev_attr_device_serial);                         // Get string of device serial
-        device_remove_file(&hdev->dev, &dev_attr_firmware_version);                      // Get string of device fw version
-
-        device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);                   // Custom effect frame
-        device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);                    // No effect
-        device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);                  // Static effect
-        device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);                  // Breathing effect
-        device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);                  // Custom effect
-        device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);                     // Brightness
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_charging_led_brightness);           // Charging effects
-            device_remove_file(&hdev->dev, &dev_attr_charging_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_charging_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_charging_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_charging_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_charging_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_fast_charging_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_fast_charging_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_fast_charging_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_fast_charging_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_fast_charging_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_fast_charging_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_fully_charged_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_fully_charged_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_fully_charged_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_fully_charged_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_fully_charged_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_fully_charged_matrix_effect_none);
-            break;
-        }
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_FIREFLY_HYPERFLUX:
-        case USB_DEVICE_ID_RAZER_FIREFLY_V2:
-        case USB_DEVICE_ID_RAZER_CORE:
-        case USB_DEVICE_ID_RAZER_CORE_X_CHROMA:
-        case USB_DEVICE_ID_RAZER_NOMMO_CHROMA:
-        case USB_DEVICE_ID_RAZER_NOMMO_PRO:
-        case USB_DEVICE_ID_RAZER_FIREFLY:
-        case USB_DEVICE_ID_RAZER_GOLIATHUS_CHROMA:
-        case USB_DEVICE_ID_RAZER_GOLIATHUS_CHROMA_EXTENDED:
-        case USB_DEVICE_ID_RAZER_CHROMA_MUG:
-        case USB_DEVICE_ID_RAZER_CHROMA_BASE:
-        case USB_DEVICE_ID_RAZER_CHROMA_HDK:
-        case USB_DEVICE_ID_RAZER_CHROMA_ADDRESSABLE_RGB_CONTROLLER:
-        case USB_DEVICE_ID_RAZER_KRAKEN_KITTY_EDITION:
-        case USB_DEVICE_ID_RAZER_MOUSE_BUNGEE_V3_CHROMA:
-        case USB_DEVICE_ID_RAZER_BASE_STATION_V2_CHROMA:
-        case USB_DEVICE_ID_RAZER_THUNDERBOLT_4_DOCK_CHROMA:
-        case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
-        case USB_DEVICE_ID_RAZER_MOUSE_DOCK:
-        case USB_DEVICE_ID_RAZER_RAPTOR_27:
-        case USB_DEVICE_ID_RAZER_LAPTOP_STAND_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);            // Spectrum effect
-            break;
-        }
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_FIREFLY:
-        case USB_DEVICE_ID_RAZER_FIREFLY_V2:
-        case USB_DEVICE_ID_RAZER_CORE:
-        case USB_DEVICE_ID_RAZER_CORE_X_CHROMA:
-        case USB_DEVICE_ID_RAZER_CHROMA_MUG:
-        case USB_DEVICE_ID_RAZER_CHROMA_HDK:
-        case USB_DEVICE_ID_RAZER_CHROMA_BASE:
-        case USB_DEVICE_ID_RAZER_NOMMO_PRO:
-        case USB_DEVICE_ID_RAZER_NOMMO_CHROMA:
-        case USB_DEVICE_ID_RAZER_CHROMA_ADDRESSABLE_RGB_CONTROLLER:
-        case USB_DEVICE_ID_RAZER_KRAKEN_KITTY_EDITION:
-        case USB_DEVICE_ID_RAZER_MOUSE_BUNGEE_V3_CHROMA:
-        case USB_DEVICE_ID_RAZER_BASE_STATION_V2_CHROMA:
-        case USB_DEVICE_ID_RAZER_THUNDERBOLT_4_DOCK_CHROMA:
-        case USB_DEVICE_ID_RAZER_CHARGING_PAD_CHROMA:
-        case USB_DEVICE_ID_RAZER_RAPTOR_27:
-        case USB_DEVICE_ID_RAZER_LAPTOP_STAND_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);                // Wave effect
-            break;
-        }
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_FIREFLY_HYPERFLUX:
-        case USB_DEVICE_ID_RAZER_FIREFLY_V2:
-        case USB_DEVICE_ID_RAZER_GOLIATHUS_CHROMA:
-        case USB_DEVICE_ID_RAZER_GOLIATHUS_CHROMA_EXTENDED:
-        case USB_DEVICE_ID_RAZER_FIREFLY:
-        case USB_DEVICE_ID_RAZER_CORE:
-        case USB_DEVICE_ID_RAZER_CORE_X_CHROMA:
-        case USB_DEVICE_ID_RAZER_LAPTOP_STAND_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);            // Reactive
-            device_remove_file(&hdev->dev, &dev_attr_matrix_reactive_trigger);           // Reactive trigger
-            break;
-        }
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_CHROMA_MUG:
-            device_remove_file(&hdev->dev, &dev_attr_is_mug_present);                    // Is cup present
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_blinking);            // Blinking effect
-            break;
-        }
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_KRAKEN_KITTY_EDITION:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);
-            break;
-        }
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_CHROMA_ADDRESSABLE_RGB_CONTROLLER:
-            device_remove_file(&hdev->dev, &dev_attr_reset_channels);
-            device_remove_file(&hdev->dev, &dev_attr_channel1_size);
-            device_remove_file(&hdev->dev, &dev_attr_channel2_size);
-            device_remove_file(&hdev->dev, &dev_attr_channel3_size);
-            device_remove_file(&hdev->dev, &dev_attr_channel4_size);
-            device_remove_file(&hdev->dev, &dev_attr_channel5_size);
-            device_remove_file(&hdev->dev, &dev_attr_channel6_size);
-            device_remove_file(&hdev->dev, &dev_attr_channel1_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_channel2_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_channel3_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_channel4_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_channel5_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_channel6_led_brightness);
-            break;
-        }
-    }
-
     hid_hw_stop(hdev);
 
     kfree(dev);
     dev_info(&intf->dev, "Razer Device disconnected\n");
 }
 
+#ifdef CONFIG_PM
+/**
+ * Forget the cached settings, the device may have lost them over suspend
+ */
+static int razer_accessory_resume(struct hid_device *hdev)
+{
+    struct razer_accessory_device *dev = hid_get_drvdata(hdev);
+
+    mutex_lock(&dev->lock);
+    memset(dev->cached, 0, sizeof(dev->cached));
+    WRITE_ONCE(dev->settings_cached, false);
+    mutex_unlock(&dev->lock);
+
+    return 0;
+}
+#endif
+
 /**
  * Converts interrupt event into PROG1 keypress
  *
@@ -2582,7 +2630,15 @@ static struct hid_driver razer_accessory_driver = {
     .remove = razer_accessory_disconnect,
     .raw_event = razer_raw_event,
     .input_mapping = razer_input_mapping,
-    .input_configured = razer_input_configured
+    .input_configured = razer_input_configured,
+#ifdef CONFIG_PM
+    .resume = razer_accessory_resume,
+    .reset_resume = razer_accessory_resume,
+#endif
+    .driver = {
+        .dev_groups = razer_accessory_groups,
+        .probe_type = PROBE_PREFER_ASYNCHRONOUS,
+    },
 };
 
 module_hid_driver(razer_accessory_driver);
@@ -6,6 +6,10 @@
 #ifndef __HID_RAZER_ACCESSORY_H
 #define __HID_RAZER_ACCESSORY_H
 
+#include <linux/bitmap.h>
+
+#include "razercommon.h"
+
 #define USB_DEVICE_ID_RAZER_FIREFLY_HYPERFLUX 0x0068
 #define USB_DEVICE_ID_RAZER_MOUSE_DOCK 0x007E
 #define USB_DEVICE_ID_RAZER_CORE 0x0215
@@ -34,10 +38,74 @@
 #define RAZER_NEW_DEVICE_WAIT_MIN_US 31000
 #define RAZER_NEW_DEVICE_WAIT_MAX_US 31100
 
+/*
+ * One bit per sysfs attribute, set in probe for the attributes the device supports
+ */
+enum razer_accessory_cap {
+    RAZER_ACCESSORY_CAP_VERSION,
+    RAZER_ACCESSORY_CAP_TEST,
+    RAZER_ACCESSORY_CAP_DEVICE_TYPE,
+    RAZER_ACCESSORY_CAP_DEVICE_MODE,
+    RAZER_ACCESSORY_CAP_DEVICE_SERIAL,
+    RAZER_ACCESSORY_CAP_FIRMWARE_VERSION,
+    RAZER_ACCESSORY_CAP_CAPABILITIES,
+    RAZER_ACCESSORY_CAP_MATRIX_CUSTOM_FRAME,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_NONE,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_STATIC,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_BREATH,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_CUSTOM,
+    RAZER_ACCESSORY_CAP_MATRIX_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_CHARGING_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_WAVE,
+    RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_SPECTRUM,
+    RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_BREATH,
+    RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_STATIC,
+    RAZER_ACCESSORY_CAP_CHARGING_MATRIX_EFFECT_NONE,
+    RAZER_ACCESSORY_CAP_FAST_CHARGING_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_WAVE,
+    RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_SPECTRUM,
+    RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_BREATH,
+    RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_STATIC,
+    RAZER_ACCESSORY_CAP_FAST_CHARGING_MATRIX_EFFECT_NONE,
+    RAZER_ACCESSORY_CAP_FULLY_CHARGED_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_WAVE,
+    RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_SPECTRUM,
+    RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_BREATH,
+    RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_STATIC,
+    RAZER_ACCESSORY_CAP_FULLY_CHARGED_MATRIX_EFFECT_NONE,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_SPECTRUM,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_WAVE,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_REACTIVE,
+    RAZER_ACCESSORY_CAP_MATRIX_REACTIVE_TRIGGER,
+    RAZER_ACCESSORY_CAP_IS_MUG_PRESENT,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_BLINKING,
+    RAZER_ACCESSORY_CAP_MATRIX_EFFECT_STARLIGHT,
+    RAZER_ACCESSORY_CAP_RESET_CHANNELS,
+    RAZER_ACCESSORY_CAP_CHANNEL1_SIZE,
+    RAZER_ACCESSORY_CAP_CHANNEL2_SIZE,
+    RAZER_ACCESSORY_CAP_CHANNEL3_SIZE,
+    RAZER_ACCESSORY_CAP_CHANNEL4_SIZE,
+    RAZER_ACCESSORY_CAP_CHANNEL5_SIZE,
+    RAZER_ACCESSORY_CAP_CHANNEL6_SIZE,
+    RAZER_ACCESSORY_CAP_CHANNEL1_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_CHANNEL2_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_CHANNEL3_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_CHANNEL4_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_CHANNEL5_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_CHANNEL6_LED_BRIGHTNESS,
+    RAZER_ACCESSORY_CAP_COUNT
+};
+
 struct razer_accessory_device {
     struct usb_device *usb_dev;
+    struct hid_device *hdev;
     struct input_dev *input;
     struct mutex lock;
+
+    // USB round trips done after probe returned, see razer_accessory_init_work()
+    struct work_struct init_work;
+    ktime_t probe_start;
+
     unsigned char usb_interface_protocol;
 
     unsigned short usb_vid;
@@ -48,6 +116,11 @@ struct razer_accessory_device {
     char serial[23];
     // 3 Bytes, first byte is whether fw version is collected, 2nd byte is major version, 3rd is minor, should be printed out in hex form as are bcd
     unsigned char firmware_version[3];
+
+    DECLARE_BITMAP(caps, RAZER_ACCESSORY_CAP_COUNT);
+    struct razer_cached_value cached[RAZER_ACCESSORY_CAP_COUNT];
+    // Whether cached was read from the device since probe or resume
+    bool settings_cached;
 };
 
 /*
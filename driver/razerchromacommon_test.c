@@ -0,0 +1,473 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/*
+ * KUnit tests and microbenchmarks for the Chroma report builders
+ *
+ * Covers the most used builders, not all of them. The expected byte strings below are the
+ * "Status Trans Packet Proto DataSize Class CMD Args" descriptions documented above the
+ * builders in razerchromacommon.c, so a refactor of the covered builders or of
+ * razer_calculate_crc() has to produce exactly the same reports on the wire.
+ *
+ * Build as a module with "make driver_kunit" and load razerchroma_test.ko on a kernel with
+ * CONFIG_KUNIT, or run under UML with
+ *   ./tools/testing/kunit/kunit.py run --kunitconfig=<path to openrazer>/driver
+ * after dropping the driver directory into the kernel tree (see driver/Kconfig).
+ */
+
+#include <kunit/test.h>
+#include <linux/kernel.h>
+#include <linux/module.h>
+#include <linux/ktime.h>
+
+#include "razercommon.h"
+#include "razerchromacommon.h"
+
+#define RAZER_REPORT_HEADER_LEN 8
+#define RAZER_REPORT_CRC_OFFSET 88
+
+#define RAZER_BENCH_ITERATIONS 100000
+
+#ifndef KUNIT_CASE_SLOW
+#define KUNIT_CASE_SLOW(test_name) KUNIT_CASE(test_name)
+#endif
+
+static struct razer_rgb red = { .r = 0xFF, .g = 0x00, .b = 0x00 };
+static struct razer_rgb green = { .r = 0x00, .g = 0xFF, .b = 0x00 };
+static struct razer_rgb yellow = { .r = 0xFF, .g = 0xFF, .b = 0x00 };
+
+/**
+ * Compare a report against a golden vector
+ *
+ * The vector covers the header and the used arguments, every byte after it up to the
+ * CRC must be zero. The CRC is recalculated from the vector independently of
+ * razer_calculate_crc() so both get checked.
+ */
+static void razer_expect_report(struct kunit *test, struct razer_report *report, const unsigned char *expected, size_t expected_len)
+{
+    unsigned char *raw = (unsigned char *)report;
+    unsigned char crc = 0;
+    size_t i;
+
+    KUNIT_ASSERT_LE(test, expected_len, (size_t)RAZER_REPORT_CRC_OFFSET);
+
+    for(i = 0; i < expected_len; i++) {
+        KUNIT_EXPECT_EQ_MSG(test, raw[i], expected[i], "byte %zu differs", i);
+        if(i >= 2) {
+            crc ^= expected[i];
+        }
+    }
+
+    for(i = expected_len; i < RAZER_REPORT_CRC_OFFSET; i++) {
+        KUNIT_EXPECT_EQ_MSG(test, raw[i], 0x00, "byte %zu should be zero", i);
+    }
+
+    KUNIT_EXPECT_EQ(test, razer_calculate_crc(report), crc);
+}
+
+/*
+ * Layout
+ */
+
+static void razer_report_layout_test(struct kunit *test)
+{
+    struct razer_report report = get_razer_report(0x0F, 0x02, 0x09);
+    unsigned char *raw = (unsigned char *)&report;
+
+    KUNIT_EXPECT_EQ(test, sizeof(struct razer_report), (size_t)RAZER_USB_REPORT_LEN);
+    KUNIT_EXPECT_EQ(test, offsetof(struct razer_report, arguments), (size_t)RAZER_REPORT_HEADER_LEN);
+    KUNIT_EXPECT_EQ(test, offsetof(struct razer_report, crc), (size_t)RAZER_REPORT_CRC_OFFSET);
+
+    KUNIT_EXPECT_EQ(test, raw[1], 0xFF); // Default transaction ID
+    KUNIT_EXPECT_EQ(test, raw[5], 0x09); // Data size
+    KUNIT_EXPECT_EQ(test, raw[6], 0x0F); // Class
+    KUNIT_EXPECT_EQ(test, raw[7], 0x02); // Command
+}
+
+static void razer_calculate_crc_test(struct kunit *test)
+{
+    struct razer_report report = get_empty_razer_report();
+    unsigned char *raw = (unsigned char *)&report;
+
+    KUNIT_EXPECT_EQ(test, razer_calculate_crc(&report), 0x00);
+
+    // Status and transaction ID are not part of the checksum
+    raw[0] = 0x02;
+    raw[1] = 0x3F;
+    KUNIT_EXPECT_EQ(test, razer_calculate_crc(&report), 0x00);
+
+    // Neither are the CRC and reserved bytes
+    raw[88] = 0xAA;
+    raw[89] = 0x55;
+    KUNIT_EXPECT_EQ(test, razer_calculate_crc(&report), 0x00);
+
+    raw[2] = 0x01;
+    raw[87] = 0x80;
+    KUNIT_EXPECT_EQ(test, razer_calculate_crc(&report), 0x81);
+
+    // Extended static red, see razer_chroma_extended_matrix_effect_static()
+    report = razer_chroma_extended_matrix_effect_static(VARSTORE, BACKLIGHT_LED, &red);
+    KUNIT_EXPECT_EQ(test, razer_calculate_crc(&report), 0xFF);
+}
+
+/*
+ * Standard
+ */
+
+static void razer_standard_device_mode_test(struct kunit *test)
+{
+    const unsigned char driver_mode[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x02, 0x00, 0x04, 0x03, 0x00 };
+    const unsigned char blocked_mode[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x02, 0x00, 0x04, 0x00, 0x00 };
+    struct razer_report report;
+
+    report = razer_chroma_standard_set_device_mode(0x03, 0x00);
+    razer_expect_report(test, &report, driver_mode, sizeof(driver_mode));
+
+    // 0x02 is explicitly blocked
+    report = razer_chroma_standard_set_device_mode(0x02, 0x01);
+    razer_expect_report(test, &report, blocked_mode, sizeof(blocked_mode));
+}
+
+static void razer_standard_led_state_test(struct kunit *test)
+{
+    const unsigned char on[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0x03, 0x00, 0x01, 0x08, 0x01 };
+    const unsigned char off[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0x03, 0x00, 0x01, 0x08, 0x00 };
+    struct razer_report report;
+
+    report = razer_chroma_standard_set_led_state(VARSTORE, GAME_LED, ON);
+    razer_expect_report(test, &report, on, sizeof(on));
+
+    report = razer_chroma_standard_set_led_state(VARSTORE, GAME_LED, OFF);
+    razer_expect_report(test, &report, off, sizeof(off));
+}
+
+static void razer_standard_matrix_effects_test(struct kunit *test)
+{
+    const unsigned char wave[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x02, 0x03, 0x0a, 0x01, 0x02 };
+    const unsigned char spectrum[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x01, 0x03, 0x0a, 0x04 };
+    const unsigned char reactive[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x05, 0x03, 0x0a, 0x02, 0x04, 0xff, 0x00, 0x00 };
+    const unsigned char stat[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x04, 0x03, 0x0a, 0x06, 0x00, 0xff, 0x00 };
+    const unsigned char breathing[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x08, 0x03, 0x0a, 0x03, 0x02, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00 };
+    const unsigned char custom[] = { 0x00, 0xff, 0x00, 0x00, 0x00, 0x02, 0x03, 0x0a, 0x05, 0x01 };
+    struct razer_report report;
+
+    report = razer_chroma_standard_matrix_effect_wave(VARSTORE, BACKLIGHT_LED, 0x05); // Direction is clamped
+    razer_expect_report(test, &report, wave, sizeof(wave));
+
+    report = razer_chroma_standard_matrix_effect_spectrum(VARSTORE, BACKLIGHT_LED);
+    razer_expect_report(test, &report, spectrum, sizeof(spectrum));
+
+    report = razer_chroma_standard_matrix_effect_reactive(VARSTORE, BACKLIGHT_LED, 0x09, &red); // Speed is clamped
+    razer_expect_report(test, &report, reactive, sizeof(reactive));
+
+    report = razer_chroma_standard_matrix_effect_static(VARSTORE, BACKLIGHT_LED, &green);
+    razer_expect_report(test, &report, stat, sizeof(stat));
+
+    report = razer_chroma_standard_matrix_effect_breathing_dual(VARSTORE, BACKLIGHT_LED, &red, &green);
+    razer_expect_report(test, &report, breathing, sizeof(breathing));
+
+    report = razer_chroma_standard_matrix_effect_custom_frame(VARSTORE);
+    razer_expect_report(test, &report, custom, sizeof(custom));
+}
+
+static void razer_standard_custom_frame_test(struct kunit *test)
+{
+    unsigned char rgb_data[3 * 3] = { 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90 };
+    const unsigned char row[] = {
+        0x00, 0xff, 0x00, 0x00, 0x00, 0x46, 0x03, 0x0b,
+        0xff, 0x02, 0x04, 0x06, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90
+    };
+    struct razer_report report;
+
+    report = razer_chroma_standard_matrix_set_custom_frame(0x02, 0x04, 0x06, rgb_data);
+    razer_expect_report(test, &report, row, sizeof(row));
+}
+
+/*
+ * Extended
+ */
+
+static void razer_extended_matrix_effects_test(struct kunit *test)
+{
+    const unsigned char none[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x06, 0x0f, 0x02, 0x01, 0x05, 0x00, 0x00, 0x00, 0x00 };
+    const unsigned char stat[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x09, 0x0f, 0x02, 0x01, 0x05, 0x01, 0x00, 0x00, 0x01, 0xff, 0x00, 0x00 };
+    const unsigned char wave_left[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x06, 0x0f, 0x02, 0x01, 0x05, 0x04, 0x00, 0x28, 0x00 };
+    const unsigned char wave_right[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x06, 0x0f, 0x02, 0x01, 0x05, 0x04, 0x01, 0x28, 0x00 };
+    const unsigned char starlight_random[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x06, 0x0f, 0x02, 0x01, 0x05, 0x07, 0x00, 0x02, 0x00 };
+    const unsigned char starlight_single[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x09, 0x0f, 0x02, 0x01, 0x05, 0x07, 0x00, 0x03, 0x01, 0xff, 0x00, 0x00 };
+    const unsigned char starlight_dual[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x0c, 0x0f, 0x02, 0x01, 0x05, 0x07, 0x00, 0x03, 0x02, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00 };
+    const unsigned char spectrum[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x06, 0x0f, 0x02, 0x01, 0x05, 0x03, 0x00, 0x00, 0x00 };
+    const unsigned char reactive[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x09, 0x0f, 0x02, 0x01, 0x05, 0x05, 0x00, 0x01, 0x01, 0xff, 0xff, 0x00 };
+    const unsigned char breathing_random[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x06, 0x0f, 0x02, 0x01, 0x05, 0x02, 0x00, 0x00, 0x00 };
+    const unsigned char breathing_single[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x09, 0x0f, 0x02, 0x01, 0x05, 0x02, 0x01, 0x00, 0x01, 0x00, 0xff, 0x00 };
+    const unsigned char breathing_dual[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x0c, 0x0f, 0x02, 0x01, 0x05, 0x02, 0x02, 0x00, 0x02, 0x00, 0xff, 0x00, 0xff, 0x00, 0x00 };
+    const unsigned char custom[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x0c, 0x0f, 0x02, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    struct razer_report report;
+
+    report = razer_chroma_extended_matrix_effect_none(VARSTORE, BACKLIGHT_LED);
+    razer_expect_report(test, &report, none, sizeof(none));
+
+    report = razer_chroma_extended_matrix_effect_static(VARSTORE, BACKLIGHT_LED, &red);
+    razer_expect_report(test, &report, stat, sizeof(stat));
+
+    report = razer_chroma_extended_matrix_effect_wave(VARSTORE, BACKLIGHT_LED, 0x00);
+    razer_expect_report(test, &report, wave_left, sizeof(wave_left));
+
+    report = razer_chroma_extended_matrix_effect_wave(VARSTORE, BACKLIGHT_LED, 0x01);
+    razer_expect_report(test, &report, wave_right, sizeof(wave_right));
+
+    report = razer_chroma_extended_matrix_effect_starlight_random(VARSTORE, BACKLIGHT_LED, 0x02);
+    razer_expect_report(test, &report, starlight_random, sizeof(starlight_random));
+
+    report = razer_chroma_extended_matrix_effect_starlight_single(VARSTORE, BACKLIGHT_LED, 0x03, &red);
+    razer_expect_report(test, &report, starlight_single, sizeof(starlight_single));
+
+    report = razer_chroma_extended_matrix_effect_starlight_dual(VARSTORE, BACKLIGHT_LED, 0x03, &red, &green);
+    razer_expect_report(test, &report, starlight_dual, sizeof(starlight_dual));
+
+    report = razer_chroma_extended_matrix_effect_spectrum(VARSTORE, BACKLIGHT_LED);
+    razer_expect_report(test, &report, spectrum, sizeof(spectrum));
+
+    report = razer_chroma_extended_matrix_effect_reactive(VARSTORE, BACKLIGHT_LED, 0x01, &yellow);
+    razer_expect_report(test, &report, reactive, sizeof(reactive));
+
+    report = razer_chroma_extended_matrix_effect_breathing_random(VARSTORE, BACKLIGHT_LED);
+    razer_expect_report(test, &report, breathing_random, sizeof(breathing_random));
+
+    report = razer_chroma_extended_matrix_effect_breathing_single(VARSTORE, BACKLIGHT_LED, &green);
+    razer_expect_report(test, &report, breathing_single, sizeof(breathing_single));
+
+    report = razer_chroma_extended_matrix_effect_breathing_dual(VARSTORE, BACKLIGHT_LED, &green, &red);
+    razer_expect_report(test, &report, breathing_dual, sizeof(breathing_dual));
+
+    report = razer_chroma_extended_matrix_effect_custom_frame();
+    razer_expect_report(test, &report, custom, sizeof(custom));
+}
+
+static void razer_extended_brightness_test(struct kunit *test)
+{
+    const unsigned char set[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x03, 0x0f, 0x04, 0x01, 0x04, 0xb7 };
+    const unsigned char get[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x03, 0x0f, 0x84, 0x01, 0x04 };
+    struct razer_report report;
+
+    report = razer_chroma_extended_matrix_brightness(VARSTORE, LOGO_LED, 0xB7);
+    razer_expect_report(test, &report, set, sizeof(set));
+
+    report = razer_chroma_extended_matrix_get_brightness(VARSTORE, LOGO_LED);
+    razer_expect_report(test, &report, get, sizeof(get));
+}
+
+static void razer_extended_custom_frame_test(struct kunit *test)
+{
+    unsigned char rgb_data[2 * 3] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    const unsigned char fixed_len[] = {
+        0x00, 0x3f, 0x00, 0x00, 0x00, 0x47, 0x0f, 0x03,
+        0x00, 0x00, 0x05, 0x0a, 0x0b, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66
+    };
+    const unsigned char exact_len[] = {
+        0x00, 0x3f, 0x00, 0x00, 0x00, 0x0b, 0x0f, 0x03,
+        0x00, 0x00, 0x05, 0x0a, 0x0b, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66
+    };
+    struct razer_report report;
+
+    report = razer_chroma_extended_matrix_set_custom_frame(0x05, 0x0A, 0x0B, rgb_data);
+    razer_expect_report(test, &report, fixed_len, sizeof(fixed_len));
+
+    // A packet length of 0 means "row length + 5"
+    report = razer_chroma_extended_matrix_set_custom_frame2(0x05, 0x0A, 0x0B, rgb_data, 0);
+    razer_expect_report(test, &report, exact_len, sizeof(exact_len));
+}
+
+static void razer_extended_custom_frame_overflow_test(struct kunit *test)
+{
+    unsigned char rgb_data[256];
+    unsigned char *raw;
+    struct razer_report report;
+    size_t i;
+
+    for(i = 0; i < sizeof(rgb_data); i++) {
+        rgb_data[i] = (unsigned char)i;
+    }
+
+    // 0..40 would be 123 bytes, the row gets truncated to what fits into the arguments
+    report = razer_chroma_extended_matrix_set_custom_frame(0x00, 0x00, 0x28, rgb_data);
+    raw = (unsigned char *)&report;
+
+    KUNIT_EXPECT_EQ(test, report.arguments[4], 0x28);
+    KUNIT_EXPECT_EQ(test, report.arguments[5], 0x00);
+    KUNIT_EXPECT_EQ(test, report.arguments[79], 74);
+    KUNIT_EXPECT_EQ(test, raw[RAZER_REPORT_CRC_OFFSET], 0x00);
+}
+
+/*
+ * Extended (Mouse)
+ */
+
+static void razer_mouse_extended_matrix_effects_test(struct kunit *test)
+{
+    const unsigned char stat[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x06, 0x03, 0x0d, 0x01, 0x01, 0x06, 0x00, 0xff, 0x00 };
+    const unsigned char reactive[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x07, 0x03, 0x0d, 0x01, 0x01, 0x02, 0x03, 0x00, 0xff, 0x00 };
+    const unsigned char breathing_single[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x0a, 0x03, 0x0d, 0x01, 0x01, 0x03, 0x01, 0x00, 0xff, 0x00 };
+    const unsigned char breathing_dual[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x0a, 0x03, 0x0d, 0x01, 0x01, 0x03, 0x02, 0x00, 0xff, 0x00, 0xff, 0x00, 0x00 };
+    const unsigned char breathing_random[] = { 0x00, 0x3f, 0x00, 0x00, 0x00, 0x0a, 0x03, 0x0d, 0x01, 0x01, 0x03, 0x03 };
+    struct razer_report report;
+
+    report = razer_chroma_mouse_extended_matrix_effect_static(VARSTORE, SCROLL_WHEEL_LED, &green);
+    razer_expect_report(test, &report, stat, sizeof(stat));
+
+    report = razer_chroma_mouse_extended_matrix_effect_reactive(VARSTORE, SCROLL_WHEEL_LED, 0x03, &green);
+    razer_expect_report(test, &report, reactive, sizeof(reactive));
+
+    report = razer_chroma_mouse_extended_matrix_effect_breathing_single(VARSTORE, SCROLL_WHEEL_LED, &green);
+    razer_expect_report(test, &report, breathing_single, sizeof(breathing_single));
+
+    report = razer_chroma_mouse_extended_matrix_effect_breathing_dual(VARSTORE, SCROLL_WHEEL_LED, &green, &red);
+    razer_expect_report(test, &report, breathing_dual, sizeof(breathing_dual));
+
+    report = razer_chroma_mouse_extended_matrix_effect_breathing_random(VARSTORE, SCROLL_WHEEL_LED);
+    razer_expect_report(test, &report, breathing_random, sizeof(breathing_random));
+}
+
+/*
+ * Benchmarks
+ *
+ * Not pass/fail, they report the average time to build a report and calculate its CRC
+ * which is what razer_send_payload() does for every command sent to a device.
+ */
+
+typedef struct razer_report (*razer_bench_builder)(unsigned int i);
+
+static struct razer_report razer_bench_extended_static(unsigned int i)
+{
+    struct razer_rgb rgb = { .r = i, .g = i >> 8, .b = i >> 16 };
+
+    return razer_chroma_extended_matrix_effect_static(VARSTORE, BACKLIGHT_LED, &rgb);
+}
+
+static struct razer_report razer_bench_extended_breathing_dual(unsigned int i)
+{
+    struct razer_rgb rgb1 = { .r = i, .g = i >> 8, .b = i >> 16 };
+    struct razer_rgb rgb2 = { .r = ~i, .g = 0x00, .b = 0xFF };
+
+    return razer_chroma_extended_matrix_effect_breathing_dual(VARSTORE, BACKLIGHT_LED, &rgb1, &rgb2);
+}
+
+static struct razer_report razer_bench_extended_wave(unsigned int i)
+{
+    return razer_chroma_extended_matrix_effect_wave(VARSTORE, BACKLIGHT_LED, i & 0x01);
+}
+
+static struct razer_report razer_bench_extended_brightness(unsigned int i)
+{
+    return razer_chroma_extended_matrix_brightness(VARSTORE, BACKLIGHT_LED, i);
+}
+
+static struct razer_report razer_bench_extended_custom_frame(unsigned int i)
+{
+    static unsigned char rgb_data[22 * 3];
+
+    rgb_data[0] = i;
+    return razer_chroma_extended_matrix_set_custom_frame(i % 6, 0x00, 0x15, rgb_data);
+}
+
+static struct razer_report razer_bench_standard_static(unsigned int i)
+{
+    struct razer_rgb rgb = { .r = i, .g = i >> 8, .b = i >> 16 };
+
+    return razer_chroma_standard_matrix_effect_static(VARSTORE, BACKLIGHT_LED, &rgb);
+}
+
+static struct razer_report razer_bench_standard_custom_frame(unsigned int i)
+{
+    static unsigned char rgb_data[22 * 3];
+
+    rgb_data[0] = i;
+    return razer_chroma_standard_matrix_set_custom_frame(i % 6, 0x00, 0x15, rgb_data);
+}
+
+static struct razer_report razer_bench_mouse_extended_reactive(unsigned int i)
+{
+    struct razer_rgb rgb = { .r = i, .g = i >> 8, .b = i >> 16 };
+
+    return razer_chroma_mouse_extended_matrix_effect_reactive(VARSTORE, SCROLL_WHEEL_LED, i & 0x03, &rgb);
+}
+
+static const struct {
+    const char *name;
+    razer_bench_builder build;
+} razer_bench_cases[] = {
+    { "extended_static", razer_bench_extended_static },
+    { "extended_breathing_dual", razer_bench_extended_breathing_dual },
+    { "extended_wave", razer_bench_extended_wave },
+    { "extended_brightness", razer_bench_extended_brightness },
+    { "extended_custom_frame", razer_bench_extended_custom_frame },
+    { "standard_static", razer_bench_standard_static },
+    { "standard_custom_frame", razer_bench_standard_custom_frame },
+    { "mouse_extended_reactive", razer_bench_mouse_extended_reactive },
+};
+
+static void razer_bench_build_and_crc(struct kunit *test)
+{
+    struct razer_report report;
+    volatile unsigned char sink = 0; // Keep the compiler from dropping the loops
+    u64 build_ns, crc_ns, start;
+    unsigned int i;
+    size_t c;
+
+    for(c = 0; c < ARRAY_SIZE(razer_bench_cases); c++) {
+        build_ns = 0;
+        crc_ns = 0;
+
+        for(i = 0; i < RAZER_BENCH_ITERATIONS; i++) {
+            start = ktime_get_ns();
+            report = razer_bench_cases[c].build(i);
+            barrier();
+            build_ns += ktime_get_ns() - start;
+
+            start = ktime_get_ns();
+            report.crc = razer_calculate_crc(&report);
+            barrier();
+            crc_ns += ktime_get_ns() - start;
+
+            sink ^= report.crc;
+        }
+
+        kunit_info(test, "%-24s build %4llu ns/op, crc %4llu ns/op\n",
+                   razer_bench_cases[c].name,
+                   div_u64(build_ns, RAZER_BENCH_ITERATIONS),
+                   div_u64(crc_ns, RAZER_BENCH_ITERATIONS));
+    }
+}
+
+static struct kunit_case razer_chroma_test_cases[] = {
+    KUNIT_CASE(razer_report_layout_test),
+    KUNIT_CASE(razer_calculate_crc_test),
+    KUNIT_CASE(razer_standard_device_mode_test),
+    KUNIT_CASE(razer_standard_led_state_test),
+    KUNIT_CASE(razer_standard_matrix_effects_test),
+    KUNIT_CASE(razer_standard_custom_frame_test),
+    KUNIT_CASE(razer_extended_matrix_effects_test),
+    KUNIT_CASE(razer_extended_brightness_test),
+    KUNIT_CASE(razer_extended_custom_frame_test),
+    KUNIT_CASE(razer_extended_custom_frame_overflow_test),
+    KUNIT_CASE(razer_mouse_extended_matrix_effects_test),
+    {}
+};
+
+static struct kunit_suite razer_chroma_test_suite = {
+    .name = "razer_chroma",
+    .test_cases = razer_chroma_test_cases,
+};
+
+static struct kunit_case razer_chroma_bench_cases[] = {
+    KUNIT_CASE_SLOW(razer_bench_build_and_crc),
+    {}
+};
+
+static struct kunit_suite razer_chroma_bench_suite = {
+    .name = "razer_chroma_bench",
+    .test_cases = razer_chroma_bench_cases,
+};
+
+kunit_test_suites(&razer_chroma_test_suite, &razer_chroma_bench_suite);
+
+MODULE_DESCRIPTION("KUnit tests for the Razer Chroma report builders");
+MODULE_LICENSE("GPL");
@@ -190,6 +190,160 @@ void print_erroneous_report(struct razer_report* report, char* driver_name, char
            report->arguments[12], report->arguments[13], report->arguments[14], report->arguments[15]);
 }
 
+/**
+ * Print the names of the attributes set in a capability bitmap, space separated
+ *
+ * attrs is indexed by capability bit
+ */
+ssize_t razer_print_caps(char *buf, struct attribute **attrs, const unsigned long *caps, unsigned int nbits)
+{
+    ssize_t len = 0;
+    unsigned int bit;
+
+    for_each_set_bit(bit, caps, nbits) {
+        len += scnprintf(buf + len, PAGE_SIZE - len, "%s%s", len ? " " : "", attrs[bit]->name);
+    }
+
+    return len + scnprintf(buf + len, PAGE_SIZE - len, "\n");
+}
+
+/**
+ * Remember the value of a setting for the state snapshot
+ *
+ * fmt is the format the attribute shows the value in, without the trailing newline.
+ * The caller holds the device lock.
+ */
+void razer_cache_value(struct razer_cached_value *cached, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    cached->len = vscnprintf(cached->value, sizeof(cached->value), fmt, args);
+    va_end(args);
+}
+
+/**
+ * Read the settings a driver caches so the state snapshot has them
+ *
+ * cached_caps lists the capabilities whose show functions cache what they read. Each one the
+ * device has is read from the device once. The caller must not hold the device lock, the show
+ * functions take it.
+ */
+void razer_fill_settings_cache(struct device *dev, struct attribute **attrs, const unsigned long *caps, const unsigned int *cached_caps, unsigned int n_cached)
+{
+    struct device_attribute *dev_attr;
+    unsigned int i;
+    char *value;
+
+    value = (char *)get_zeroed_page(GFP_KERNEL);
+    if(value == NULL) {
+        return;
+    }
+
+    for(i = 0; i < n_cached; i++) {
+        if(!test_bit(cached_caps[i], caps)) {
+            continue;
+        }
+
+        dev_attr = container_of(attrs[cached_caps[i]], struct device_attribute, attr);
+        if(!(attrs[cached_caps[i]]->mode & 0444) || dev_attr->show == NULL) {
+            continue;
+        }
+
+        dev_attr->show(dev, dev_attr, value);
+    }
+
+    free_page((unsigned long)value);
+}
+
+/**
+ * Append a record to a state snapshot
+ */
+static int razer_snapshot_add(char *buf, size_t *len, size_t count, const char *name, const char *value, size_t value_len)
+{
+    size_t name_len = strlen(name);
+
+    if(*len + 1 + name_len + 2 + value_len > count) {
+        return -E2BIG;
+    }
+
+    buf[(*len)++] = name_len;
+    memcpy(buf + *len, name, name_len);
+    *len += name_len;
+    buf[(*len)++] = value_len & 0xFF;
+    buf[(*len)++] = (value_len >> 8) & 0xFF;
+    memcpy(buf + *len, value, value_len);
+    *len += value_len;
+
+    return 0;
+}
+
+/**
+ * Pack the state of a device into a snapshot without talking to the device
+ *
+ * For every attribute set in caps, the snapshot holds what its show function returns if it is
+ * also set in cheap_caps (these must not do USB transfers or take the device lock), else the
+ * cached value if there is one. cached can be NULL for drivers that don't cache settings.
+ * The caller holds the device lock. Returns -E2BIG if the snapshot does not fit in count bytes.
+ */
+ssize_t razer_build_state_snapshot(struct device *dev, struct attribute **attrs, const unsigned long *caps, const unsigned long *cheap_caps, const struct razer_cached_value *cached, unsigned int nbits, char *buf, size_t count)
+{
+    struct device_attribute *dev_attr;
+    unsigned short records = 0;
+    size_t len = 4;
+    ssize_t value_len;
+    unsigned int bit;
+    char *value;
+    int err = 0;
+
+    if(count < len) {
+        return -E2BIG;
+    }
+
+    value = (char *)get_zeroed_page(GFP_KERNEL);
+    if(value == NULL) {
+        return -ENOMEM;
+    }
+
+    for_each_set_bit(bit, caps, nbits) {
+        if(test_bit(bit, cheap_caps)) {
+            dev_attr = container_of(attrs[bit], struct device_attribute, attr);
+            if(!(attrs[bit]->mode & 0444) || dev_attr->show == NULL) {
+                continue;
+            }
+
+            value_len = dev_attr->show(dev, dev_attr, value);
+            if(value_len < 0) {
+                continue;
+            }
+            if(value_len > 0 && value[value_len - 1] == '\n') {
+                value_len--;
+            }
+
+            err = razer_snapshot_add(buf, &len, count, attrs[bit]->name, value, value_len);
+        } else if(cached != NULL && cached[bit].len) {
+            err = razer_snapshot_add(buf, &len, count, attrs[bit]->name, cached[bit].value, cached[bit].len);
+        } else {
+            continue;
+        }
+
+        if(err) {
+            free_page((unsigned long)value);
+            return err;
+        }
+        records++;
+    }
+
+    free_page((unsigned long)value);
+
+    buf[0] = RAZER_STATE_SNAPSHOT_VERSION;
+    buf[1] = 0;
+    buf[2] = records & 0xFF;
+    buf[3] = (records >> 8) & 0xFF;
+
+    return len;
+}
+
 /**
  * Clamp a value to a min,max
  */
@@ -23,15 +23,6 @@
 #endif
 #endif
 
-// Macro to create device files
-#define CREATE_DEVICE_FILE(dev, type) \
-do { \
-    if(device_create_file(dev, type)) { \
-        goto exit_free; \
-    } \
-} while (0)
-
-
 #define USB_VENDOR_ID_RAZER 0x1532
 
 /* Each USB report has 90 bytes*/
@@ -81,6 +72,36 @@ do { \
 #define RAZER_CMD_TIMEOUT       0x04
 #define RAZER_CMD_NOT_SUPPORTED 0x05
 
+/* State snapshot, read from the "state_snapshot" binary attribute
+ *
+ * Header:  u8 version, u8 reserved, le16 record count
+ * Records: u8 name length, name, le16 value length, value
+ *
+ * The value is formatted like reading the attribute of that name, without the trailing newline.
+ * Building it never talks to the device: it only holds attributes which are shown without a USB
+ * transfer and settings the driver has cached, see struct razer_cached_value. The first read after
+ * probe or resume reads the cached settings from the device once, the device may have lost them over suspend.
+ * */
+#define RAZER_STATE_SNAPSHOT_VERSION 1
+#define RAZER_STATE_SNAPSHOT_SIZE PAGE_SIZE
+
+/* Last value of a setting written through or read from the driver, formatted like the attribute
+ * shows it. len is 0 until the value is known. Protected by the device lock.
+ * */
+#define RAZER_CACHED_VALUE_LEN 16
+
+struct razer_cached_value {
+    unsigned char len;
+    char value[RAZER_CACHED_VALUE_LEN];
+};
+
+/* Cache a setting of a device with a "lock" mutex and a "cached" array indexed by capability */
+#define razer_cache_setting(device, cap, fmt, ...) do { \
+        mutex_lock(&(device)->lock); \
+        razer_cache_value(&(device)->cached[cap], fmt, ##__VA_ARGS__); \
+        mutex_unlock(&(device)->lock); \
+    } while (0)
+
 struct razer_report;
 
 struct razer_rgb {
@@ -156,6 +177,10 @@ unsigned char razer_calculate_crc(struct razer_report *report);
 struct razer_report get_razer_report(unsigned char command_class, unsigned char command_id, unsigned char data_size);
 struct razer_report get_empty_razer_report(void);
 void print_erroneous_report(struct razer_report* report, char* driver_name, char* message);
+ssize_t razer_print_caps(char *buf, struct attribute **attrs, const unsigned long *caps, unsigned int nbits);
+void razer_cache_value(struct razer_cached_value *cached, const char *fmt, ...) __printf(2, 3);
+void razer_fill_settings_cache(struct device *dev, struct attribute **attrs, const unsigned long *caps, const unsigned int *cached_caps, unsigned int n_cached);
+ssize_t razer_build_state_snapshot(struct device *dev, struct attribute **attrs, const unsigned long *caps, const unsigned long *cheap_caps, const struct razer_cached_value *cached, unsigned int nbits, char *buf, size_t count);
 
 // Convenience functions
 unsigned char clamp_u8(unsigned char value, unsigned char min, unsigned char max);
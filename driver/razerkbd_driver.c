@@ -10,6 +10,8 @@
 #include <linux/usb/input.h>
 #include <linux/hid.h>
 #include <linux/dmi.h>
+#include <linux/ktime.h>
+#include <linux/workqueue.h>
 
 #include "usb_hid_keys.h"
 
@@ -2417,6 +2419,7 @@ static ssize_t razer_attr_read_test(struct device *dev, struct device_attribute
  */
 static ssize_t razer_attr_write_matrix_brightness(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
 {
+    struct razer_kbd_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned char brightness = (unsigned char)simple_strtoul(buf, NULL, 10);
@@ -2489,7 +2492,9 @@ static ssize_t razer_attr_write_matrix_brightness(struct device *dev, struct dev
         }
         break;
     }
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_KBD_CAP_MATRIX_BRIGHTNESS, "%d", brightness);
+    }
 
     return count;
 }
@@ -2501,6 +2506,7 @@ static ssize_t razer_attr_write_matrix_brightness(struct device *dev, struct dev
  */
 static ssize_t razer_attr_read_matrix_brightness(struct device *dev, struct device_attribute *attr, char *buf)
 {
+    struct razer_kbd_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned char brightness = 0;
@@ -2572,7 +2578,9 @@ static ssize_t razer_attr_read_matrix_brightness(struct device *dev, struct devi
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(razer_send_payload(usb_dev, &request, &response)) {
+        return sprintf(buf, "%d\n", 0);
+    }
 
     // Brightness is stored elsewhere for the stealth cmds
     if (is_blade_laptop(usb_dev)) {
@@ -2581,6 +2589,7 @@ static ssize_t razer_attr_read_matrix_brightness(struct device *dev, struct devi
         brightness = response.arguments[2];
     }
 
+    razer_cache_setting(device, RAZER_KBD_CAP_MATRIX_BRIGHTNESS, "%d", brightness);
 
     return sprintf(buf, "%d\n", brightness);
 }
@@ -2592,6 +2601,7 @@ static ssize_t razer_attr_write_device_mode(struct device *dev, struct device_at
 {
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
+    struct razer_kbd_device *device = dev_get_drvdata(dev);
     struct razer_report request = {0};
     struct razer_report response = {0};
 
@@ -2600,6 +2610,9 @@ static ssize_t razer_attr_write_device_mode(struct device *dev, struct device_at
         return -EINVAL;
     }
 
+    // Don't let the mode switch done after probe override this one
+    flush_work(&device->init_work);
+
     // No-op on Blades
     if (is_blade_laptop(usb_dev)) {
         return count;
@@ -2776,6 +2789,7 @@ static ssize_t razer_attr_write_matrix_custom_frame(struct device *dev, struct d
  */
 static ssize_t razer_attr_read_poll_rate(struct device *dev, struct device_attribute *attr, char *buf)
 {
+    struct razer_kbd_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     struct razer_report request = razer_chroma_misc_get_polling_rate();
@@ -2790,7 +2804,9 @@ static ssize_t razer_attr_read_poll_rate(struct device *dev, struct device_attri
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(razer_send_payload(usb_dev, &request, &response)) {
+        return sprintf(buf, "%d\n", 0);
+    }
 
     switch(response.arguments[1]) {
     case 0x01:
@@ -2816,6 +2832,8 @@ static ssize_t razer_attr_read_poll_rate(struct device *dev, struct device_attri
         break;
     }
 
+    razer_cache_setting(device, RAZER_KBD_CAP_POLL_RATE, "%d", polling_rate);
+
     return sprintf(buf, "%d\n", polling_rate);
 }
 
@@ -2826,6 +2844,7 @@ static ssize_t razer_attr_read_poll_rate(struct device *dev, struct device_attri
  */
 static ssize_t razer_attr_write_poll_rate(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
 {
+    struct razer_kbd_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned short polling_rate = (unsigned short)simple_strtoul(buf, NULL, 10);
@@ -2840,7 +2859,9 @@ static ssize_t razer_attr_write_poll_rate(struct device *dev, struct device_attr
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_KBD_CAP_POLL_RATE, "%d", polling_rate);
+    }
 
     return count;
 }
@@ -2986,6 +3007,152 @@ static DEVICE_ATTR(charge_effect,           0220, NULL,
 static DEVICE_ATTR(charge_colour,           0220, NULL,                                       razer_attr_write_charge_colour);
 static DEVICE_ATTR(charge_low_threshold,    0660, razer_attr_read_charge_low_threshold,       razer_attr_write_charge_low_threshold);
 
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf);
+static DEVICE_ATTR(capabilities,            0440, razer_attr_read_capabilities,               NULL);
+
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count);
+static BIN_ATTR(state_snapshot, 0440, razer_attr_read_state_snapshot, NULL, RAZER_STATE_SNAPSHOT_SIZE);
+
+/**
+ * Every attribute the driver knows about, indexed by capability bit
+ */
+static struct attribute *razer_kbd_attrs[] = {
+    [RAZER_KBD_CAP_VERSION] = &dev_attr_version.attr,
+    [RAZER_KBD_CAP_FIRMWARE_VERSION] = &dev_attr_firmware_version.attr,                  // Get the firmware version
+    [RAZER_KBD_CAP_DEVICE_SERIAL] = &dev_attr_device_serial.attr,                        // Get serial number
+    [RAZER_KBD_CAP_MATRIX_BRIGHTNESS] = &dev_attr_matrix_brightness.attr,                // Gets and sets the brightness
+    [RAZER_KBD_CAP_TEST] = &dev_attr_test.attr,                                          // Test mode
+    [RAZER_KBD_CAP_DEVICE_TYPE] = &dev_attr_device_type.attr,                            // Get string of device type
+    [RAZER_KBD_CAP_DEVICE_MODE] = &dev_attr_device_mode.attr,                            // Get device mode
+    [RAZER_KBD_CAP_KBD_LAYOUT] = &dev_attr_kbd_layout.attr,                              // Gets the physical layout
+    [RAZER_KBD_CAP_CAPABILITIES] = &dev_attr_capabilities.attr,                          // Get the list of supported attributes
+    [RAZER_KBD_CAP_KEY_SUPER] = &dev_attr_key_super.attr,                                // Super Key
+    [RAZER_KBD_CAP_KEY_ALT_TAB] = &dev_attr_key_alt_tab.attr,                            // Alt + Tab
+    [RAZER_KBD_CAP_KEY_ALT_F4] = &dev_attr_key_alt_f4.attr,                              // Alt + F4
+    [RAZER_KBD_CAP_PROFILE_LED_RED] = &dev_attr_profile_led_red.attr,                    // Profile/Macro LED Red
+    [RAZER_KBD_CAP_PROFILE_LED_GREEN] = &dev_attr_profile_led_green.attr,                // Profile/Macro LED Green
+    [RAZER_KBD_CAP_PROFILE_LED_BLUE] = &dev_attr_profile_led_blue.attr,                  // Profile/Macro LED Blue
+    [RAZER_KBD_CAP_MATRIX_EFFECT_STATIC] = &dev_attr_matrix_effect_static.attr,          // Static effect
+    [RAZER_KBD_CAP_MATRIX_EFFECT_PULSATE] = &dev_attr_matrix_effect_pulsate.attr,        // Pulsate effect, like breathing
+    [RAZER_KBD_CAP_MATRIX_EFFECT_NONE] = &dev_attr_matrix_effect_none.attr,              // No effect
+    [RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM] = &dev_attr_matrix_effect_spectrum.attr,      // Spectrum effect
+    [RAZER_KBD_CAP_MATRIX_EFFECT_BREATH] = &dev_attr_matrix_effect_breath.attr,          // Breathing effect
+    [RAZER_KBD_CAP_MATRIX_EFFECT_WAVE] = &dev_attr_matrix_effect_wave.attr,              // Wave effect
+    [RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM] = &dev_attr_matrix_effect_custom.attr,          // Custom effect
+    [RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME] = &dev_attr_matrix_custom_frame.attr,            // Set LED matrix
+    [RAZER_KBD_CAP_GAME_LED_STATE] = &dev_attr_game_led_state.attr,                      // Enable game mode & LED
+    [RAZER_KBD_CAP_MACRO_LED_STATE] = &dev_attr_macro_led_state.attr,                    // Enable macro LED
+    [RAZER_KBD_CAP_MACRO_LED_EFFECT] = &dev_attr_macro_led_effect.attr,                  // Change macro LED effect (static, flashing)
+    [RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE] = &dev_attr_matrix_effect_reactive.attr,      // Reactive effect
+    [RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT] = &dev_attr_matrix_effect_starlight.attr,    // Starlight effect
+    [RAZER_KBD_CAP_CHARGE_LEVEL] = &dev_attr_charge_level.attr,                          // Charge level
+    [RAZER_KBD_CAP_CHARGE_STATUS] = &dev_attr_charge_status.attr,                        // Charge status
+    [RAZER_KBD_CAP_POLL_RATE] = &dev_attr_poll_rate.attr,                                // Poll Rate
+    [RAZER_KBD_CAP_KEYSWITCH_OPTIMIZATION] = &dev_attr_keyswitch_optimization.attr,      // Keyswitch Optimization
+    [RAZER_KBD_CAP_CHARGE_EFFECT] = &dev_attr_charge_effect.attr,                        // Charge effect
+    [RAZER_KBD_CAP_CHARGE_COLOUR] = &dev_attr_charge_colour.attr,                        // Charge colour
+    [RAZER_KBD_CAP_CHARGE_LOW_THRESHOLD] = &dev_attr_charge_low_threshold.attr,          // Charge low threshold
+    [RAZER_KBD_CAP_FN_TOGGLE] = &dev_attr_fn_toggle.attr,                                // Sets whether FN is requires for F-Keys
+    [RAZER_KBD_CAP_LOGO_LED_STATE] = &dev_attr_logo_led_state.attr,                      // Enable/Disable the logo
+    [RAZER_KBD_CAP_COUNT] = NULL
+};
+
+/**
+ * Only show the attributes the bound device has a capability bit for
+ */
+static umode_t razer_kbd_attr_is_visible(struct kobject *kobj, struct attribute *attr, int n)
+{
+    struct razer_kbd_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(n, device->caps)) {
+        return 0;
+    }
+
+    return attr->mode;
+}
+
+/**
+ * Read device file "capabilities"
+ *
+ * Returns the names of the attributes supported by the device, space separated
+ */
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct razer_kbd_device *device = dev_get_drvdata(dev);
+
+    return razer_print_caps(buf, razer_kbd_attrs, device->caps, RAZER_KBD_CAP_COUNT);
+}
+
+/**
+ * Settings whose show functions cache what they read from the device
+ */
+static const unsigned int razer_kbd_cached_caps[] = {
+    RAZER_KBD_CAP_POLL_RATE,
+    RAZER_KBD_CAP_MATRIX_BRIGHTNESS,
+};
+
+/**
+ * Read device file "state_snapshot"
+ *
+ * Returns the driver version, device type, capabilities and the cached settings in one packed
+ * blob, see razercommon.h for the layout. The first read after probe or resume reads the cached
+ * settings from the device, later reads don't talk to the device. It has to be read in one go,
+ * reads at an offset return nothing.
+ */
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count)
+{
+    struct device *dev = kobj_to_dev(kobj);
+    struct razer_kbd_device *device = dev_get_drvdata(dev);
+    DECLARE_BITMAP(cheap_caps, RAZER_KBD_CAP_COUNT) = {0};
+    ssize_t len;
+
+    if(off) {
+        return 0;
+    }
+
+    set_bit(RAZER_KBD_CAP_VERSION, cheap_caps);
+    set_bit(RAZER_KBD_CAP_DEVICE_TYPE, cheap_caps);
+    set_bit(RAZER_KBD_CAP_CAPABILITIES, cheap_caps);
+
+    if(!READ_ONCE(device->settings_cached)) {
+        razer_fill_settings_cache(dev, razer_kbd_attrs, device->caps, razer_kbd_cached_caps, ARRAY_SIZE(razer_kbd_cached_caps));
+        WRITE_ONCE(device->settings_cached, true);
+    }
+
+    mutex_lock(&device->lock);
+    len = razer_build_state_snapshot(dev, razer_kbd_attrs, device->caps, cheap_caps, device->cached, RAZER_KBD_CAP_COUNT, buf, count);
+    mutex_unlock(&device->lock);
+
+    return len;
+}
+
+static struct bin_attribute *razer_kbd_bin_attrs[] = {
+    &bin_attr_state_snapshot,
+    NULL
+};
+
+/**
+ * The snapshot is available wherever the capability list is
+ */
+static umode_t razer_kbd_bin_attr_is_visible(struct kobject *kobj, struct bin_attribute *attr, int n)
+{
+    struct razer_kbd_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(RAZER_KBD_CAP_CAPABILITIES, device->caps)) {
+        return 0;
+    }
+
+    return attr->attr.mode;
+}
+
+static const struct attribute_group razer_kbd_group = {
+    .attrs = razer_kbd_attrs,
+    .bin_attrs = razer_kbd_bin_attrs,
+    .is_visible = razer_kbd_attr_is_visible,
+    .is_bin_visible = razer_kbd_bin_attr_is_visible,
+};
+
+__ATTRIBUTE_GROUPS(razer_kbd);
 
 
 /**
@@ -3385,6 +3552,26 @@ static int razer_kbd_input_mapping(struct hid_device *hdev, struct hid_input *hi
     }
 }
 
+/**
+ * Deferred part of the probe
+ *
+ * Does the USB round trips that aren't needed to register the device so probe doesn't
+ * stall on them, especially when several devices are plugged in at once.
+ */
+static void razer_kbd_init_work(struct work_struct *work)
+{
+    struct razer_kbd_device *dev = container_of(work, struct razer_kbd_device, init_work);
+
+    // Set device to regular mode, not driver mode
+    // When the daemon discovers the device it will instruct it to enter driver mode
+    // Probe is asynchronous, so the sysfs files can already be in use
+    mutex_lock(&dev->lock);
+    razer_set_device_mode(dev->usb_dev, 0x00, 0x00);
+    mutex_unlock(&dev->lock);
+
+    hid_dbg(dev->hdev, "initialised in %lld us\n", ktime_us_delta(ktime_get(), dev->probe_start));
+}
+
 /**
  * Probe method is ran whenever a device is binded to the driver
  */
@@ -3402,82 +3589,89 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         goto exit;
     }
 
+    dev->probe_start = ktime_get();
+    dev->usb_dev = usb_dev;
+    dev->hdev = hdev;
+    mutex_init(&dev->lock);
+    INIT_WORK(&dev->init_work, razer_kbd_init_work);
+
     // Other interfaces are actual key-emitting devices
     if(intf->cur_altsetting->desc.bInterfaceProtocol == USB_INTERFACE_PROTOCOL_MOUSE) {
         // If the currently bound device is the control (mouse) interface
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_version);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_firmware_version);                      // Get the firmware version
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_serial);                         // Get serial number
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);                     // Gets and sets the brightness
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_test);                                  // Test mode
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_type);                           // Get string of device type
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_mode);                           // Get device mode
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_kbd_layout);                            // Gets the physical layout
+        set_bit(RAZER_KBD_CAP_VERSION, dev->caps);
+        set_bit(RAZER_KBD_CAP_FIRMWARE_VERSION, dev->caps);
+        set_bit(RAZER_KBD_CAP_DEVICE_SERIAL, dev->caps);
+        set_bit(RAZER_KBD_CAP_MATRIX_BRIGHTNESS, dev->caps);
+        set_bit(RAZER_KBD_CAP_TEST, dev->caps);
+        set_bit(RAZER_KBD_CAP_DEVICE_TYPE, dev->caps);
+        set_bit(RAZER_KBD_CAP_DEVICE_MODE, dev->caps);
+        set_bit(RAZER_KBD_CAP_KBD_LAYOUT, dev->caps);
+        set_bit(RAZER_KBD_CAP_CAPABILITIES, dev->caps);
 
         switch(usb_dev->descriptor.idProduct) {
 
         case USB_DEVICE_ID_RAZER_NOSTROMO:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_RED, dev->caps);                       // Profile/Macro LED Red
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_GREEN, dev->caps);                     // Profile/Macro LED Green
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_BLUE, dev->caps);                      // Profile/Macro LED Blue
             break;
 
         case USB_DEVICE_ID_RAZER_TARTARUS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_pulsate);         // Pulsate effect, like breathing
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_RED, dev->caps);                       // Profile/Macro LED Red
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_GREEN, dev->caps);                     // Profile/Macro LED Green
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_BLUE, dev->caps);                      // Profile/Macro LED Blue
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_PULSATE, dev->caps);                 // Pulsate effect, like breathing
             break;
 
         case USB_DEVICE_ID_RAZER_ORBWEAVER:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_pulsate);         // Pulsate effect, like breathing
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_RED, dev->caps);                       // Profile/Macro LED Red
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_GREEN, dev->caps);                     // Profile/Macro LED Green
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_BLUE, dev->caps);                      // Profile/Macro LED Blue
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_PULSATE, dev->caps);                 // Pulsate effect, like breathing
             break;
 
         case USB_DEVICE_ID_RAZER_TARTARUS_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_RED, dev->caps);                       // Profile/Macro LED Red
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_GREEN, dev->caps);                     // Profile/Macro LED Green
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_BLUE, dev->caps);                      // Profile/Macro LED Blue
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
             break;
 
         case USB_DEVICE_ID_RAZER_ORBWEAVER_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_RED, dev->caps);                       // Profile/Macro LED Red
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_GREEN, dev->caps);                     // Profile/Macro LED Green
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_BLUE, dev->caps);                      // Profile/Macro LED Blue
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
             break;
 
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_LITE:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_ANANSI:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_STEALTH:
@@ -3486,11 +3680,11 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_ULTIMATE_2013:
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_TE_2014:
         case USB_DEVICE_ID_RAZER_DEATHSTALKER_EXPERT:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_pulsate);         // Pulsate effect, like breathing
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_PULSATE, dev->caps);                 // Pulsate effect, like breathing
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_BLADE_2018_BASE:
@@ -3503,75 +3697,75 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         case USB_DEVICE_ID_RAZER_BLADE_EARLY_2020_BASE:
         case USB_DEVICE_ID_RAZER_BLADE_15_BASE_EARLY_2021:
         case USB_DEVICE_ID_RAZER_BLADE_15_BASE_2022:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
             break;
 
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_ULTIMATE_2016:
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_X_ULTIMATE:
         case USB_DEVICE_ID_RAZER_ORNATA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHSTALKER_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_WIRED:
         case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_WIRELESS:
         case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_TKL_WIRED:
         case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_TKL_WIRELESS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_super);                     // Super Key
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_alt_tab);                   // Alt + Tab
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_alt_f4);                    // Alt + F4
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);                  // Charge level
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);                 // Charge status
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_KEY_SUPER, dev->caps);                             // Super Key
+            set_bit(RAZER_KBD_CAP_KEY_ALT_TAB, dev->caps);                           // Alt + Tab
+            set_bit(RAZER_KBD_CAP_KEY_ALT_F4, dev->caps);                            // Alt + F4
+            set_bit(RAZER_KBD_CAP_CHARGE_LEVEL, dev->caps);                          // Charge level
+            set_bit(RAZER_KBD_CAP_CHARGE_STATUS, dev->caps);                         // Charge status
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_HUNTSMAN_V2_TENKEYLESS:
         case USB_DEVICE_ID_RAZER_HUNTSMAN_V2:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);                     // Poll Rate
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_keyswitch_optimization);        // Keyswitch Optimization
+            set_bit(RAZER_KBD_CAP_POLL_RATE, dev->caps);                             // Poll Rate
+            set_bit(RAZER_KBD_CAP_KEYSWITCH_OPTIMIZATION, dev->caps);                // Keyswitch Optimization
             fallthrough;
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3:
         case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_super);                     // Super Key
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_alt_tab);                   // Alt + Tab
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_alt_f4);                    // Alt + F4
+            set_bit(RAZER_KBD_CAP_KEY_SUPER, dev->caps);                             // Super Key
+            set_bit(RAZER_KBD_CAP_KEY_ALT_TAB, dev->caps);                           // Alt + Tab
+            set_bit(RAZER_KBD_CAP_KEY_ALT_F4, dev->caps);                            // Alt + F4
             fallthrough;
         case USB_DEVICE_ID_RAZER_ORNATA_CHROMA:
         case USB_DEVICE_ID_RAZER_ORNATA_V2:
@@ -3588,123 +3782,123 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_CHROMA_V2:
         case USB_DEVICE_ID_RAZER_CYNOSA_V2:
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_TK:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_MINI:
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_MINI_WIRELESS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);                  // Battery charge level
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);                 // Battery charge status
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_CHARGE_LEVEL, dev->caps);                          // Battery charge level
+            set_bit(RAZER_KBD_CAP_CHARGE_STATUS, dev->caps);                         // Battery charge status
             break;
 
         case USB_DEVICE_ID_RAZER_CYNOSA_LITE:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_ORNATA_V3_X:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
 
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_PRO_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);                  // Charge level
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);                 // Charge status
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_effect);                 // Charge effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_colour);                 // Charge colour
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);          // Charge low threshold
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_CHARGE_LEVEL, dev->caps);                          // Charge level
+            set_bit(RAZER_KBD_CAP_CHARGE_STATUS, dev->caps);                         // Charge status
+            set_bit(RAZER_KBD_CAP_CHARGE_EFFECT, dev->caps);                         // Charge effect
+            set_bit(RAZER_KBD_CAP_CHARGE_COLOUR, dev->caps);                         // Charge colour
+            set_bit(RAZER_KBD_CAP_CHARGE_LOW_THRESHOLD, dev->caps);                  // Charge low threshold
             break;
 
         case USB_DEVICE_ID_RAZER_TARTARUS_V2:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_RED, dev->caps);                       // Profile/Macro LED Red
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_GREEN, dev->caps);                     // Profile/Macro LED Green
+            set_bit(RAZER_KBD_CAP_PROFILE_LED_BLUE, dev->caps);                      // Profile/Macro LED Blue
             break;
 
         case USB_DEVICE_ID_RAZER_BLADE_2018_MERCURY:
         case USB_DEVICE_ID_RAZER_BLADE_2019_ADV:
         case USB_DEVICE_ID_RAZER_BLADE_STUDIO_EDITION_2019:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
             break;
 
         case USB_DEVICE_ID_RAZER_BLADE_LATE_2016:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fn_toggle);                     // Sets whether FN is requires for F-Keys
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_FN_TOGGLE, dev->caps);                             // Sets whether FN is requires for F-Keys
             break;
 
         case USB_DEVICE_ID_RAZER_BLADE_QHD:
@@ -3712,17 +3906,17 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         case USB_DEVICE_ID_RAZER_BLADE_STEALTH_LATE_2016:
         case USB_DEVICE_ID_RAZER_BLADE_STEALTH_MID_2017:
         case USB_DEVICE_ID_RAZER_BLADE_STEALTH_LATE_2017:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_fn_toggle);                     // Sets whether FN is requires for F-Keys
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);                // Enable/Disable the logo
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_FN_TOGGLE, dev->caps);                             // Sets whether FN is requires for F-Keys
+            set_bit(RAZER_KBD_CAP_LOGO_LED_STATE, dev->caps);                        // Enable/Disable the logo
             break;
 
         case USB_DEVICE_ID_RAZER_BLADE_PRO_LATE_2016:
@@ -3741,26 +3935,26 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         case USB_DEVICE_ID_RAZER_BLADE_17_2022:
         case USB_DEVICE_ID_RAZER_BLADE_14_2022:
         case USB_DEVICE_ID_RAZER_BLADE_15_ADV_EARLY_2022:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);                // Enable/Disable the logo
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT, dev->caps);               // Starlight effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_LOGO_LED_STATE, dev->caps);                        // Enable/Disable the logo
             break;
 
         case USB_DEVICE_ID_RAZER_BLADE_PRO_EARLY_2020:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
             break;
 
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_CHROMA:
@@ -3770,40 +3964,37 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         case USB_DEVICE_ID_RAZER_BLACKWIDOW_X_CHROMA_TE:
         case USB_DEVICE_ID_RAZER_HUNTSMAN_V2_ANALOG:
         case USB_DEVICE_ID_RAZER_HUNTSMAN_MINI_ANALOG:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_WAVE, dev->caps);                    // Wave effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);                // Spectrum effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_NONE, dev->caps);                    // No effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);                // Reactive effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_BREATH, dev->caps);                  // Breathing effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_STATIC, dev->caps);                  // Static effect
+            set_bit(RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);                  // Custom effect
+            set_bit(RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME, dev->caps);                   // Set LED matrix
+            set_bit(RAZER_KBD_CAP_GAME_LED_STATE, dev->caps);                        // Enable game mode & LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_STATE, dev->caps);                       // Enable macro LED
+            set_bit(RAZER_KBD_CAP_MACRO_LED_EFFECT, dev->caps);                      // Change macro LED effect (static, flashing)
             break;
         }
-
-        // Set device to regular mode, not driver mode
-        // When the daemon discovers the device it will instruct it to enter driver mode
-        razer_set_device_mode(usb_dev, 0x00, 0x00);
     } else if(intf->cur_altsetting->desc.bInterfaceProtocol == USB_INTERFACE_PROTOCOL_KEYBOARD) {
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_super);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_alt_tab);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_key_alt_f4);
+        set_bit(RAZER_KBD_CAP_KEY_SUPER, dev->caps);
+        set_bit(RAZER_KBD_CAP_KEY_ALT_TAB, dev->caps);
+        set_bit(RAZER_KBD_CAP_KEY_ALT_F4, dev->caps);
+        set_bit(RAZER_KBD_CAP_CAPABILITIES, dev->caps);
     }
 
-
-
     hid_set_drvdata(hdev, dev);
     dev_set_drvdata(&hdev->dev, dev);
 
-    if(hid_parse(hdev)) {
+    retval = hid_parse(hdev);
+    if(retval) {
         hid_err(hdev, "parse failed\n");
         goto exit_free;
     }
 
-    if (hid_hw_start(hdev, HID_CONNECT_DEFAULT)) {
+    retval = hid_hw_start(hdev, HID_CONNECT_DEFAULT);
+    if(retval) {
         hid_err(hdev, "hw start failed\n");
         goto exit_free;
     }
@@ -3813,6 +4004,12 @@ static int razer_kbd_probe(struct hid_device *hdev, const struct hid_device_id *
         usb_disable_autosuspend(usb_dev);
     }
 
+    if(intf->cur_altsetting->desc.bInterfaceProtocol == USB_INTERFACE_PROTOCOL_MOUSE) {
+        schedule_work(&dev->init_work);
+    }
+
+    hid_dbg(hdev, "probe took %lld us\n", ktime_us_delta(ktime_get(), dev->probe_start));
+
     //razer_activate_macro_keys(usb_dev);
     //msleep(3000);
     return 0;
@@ -3830,402 +4027,33 @@ static void razer_kbd_disconnect(struct hid_device *hdev)
 {
     struct razer_kbd_device *dev;
     struct usb_interface *intf = to_usb_interface(hdev->dev.parent);
-    struct usb_device *usb_dev = interface_to_usbdev(intf);
 
     dev = hid_get_drvdata(hdev);
 
-    // Other interfaces are actual key-emitting devices
-    if(intf->cur_altsetting->desc.bInterfaceProtocol == USB_INTERFACE_PROTOCOL_MOUSE) {
-        // If the currently bound device is the control (mouse) interface
-        device_remove_file(&hdev->dev, &dev_attr_version);
-        device_remove_file(&hdev->dev, &dev_attr_firmware_version);                      // Get the firmware version
-        device_remove_file(&hdev->dev, &dev_attr_device_serial);                         // Get serial number
-        device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);                     // Gets and sets the brightness
-        device_remove_file(&hdev->dev, &dev_attr_test);                                  // Test mode
-        device_remove_file(&hdev->dev, &dev_attr_device_type);                           // Get string of device type
-        device_remove_file(&hdev->dev, &dev_attr_device_mode);                           // Get device mode
-        device_remove_file(&hdev->dev, &dev_attr_kbd_layout);                            // Gets the physical layout
-
-        switch(usb_dev->descriptor.idProduct) {
-
-        case USB_DEVICE_ID_RAZER_NOSTROMO:
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            break;
-
-        case USB_DEVICE_ID_RAZER_TARTARUS:
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_pulsate);         // Pulsate effect, like breathing
-            break;
-
-        case USB_DEVICE_ID_RAZER_ORBWEAVER:
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_pulsate);         // Pulsate effect, like breathing
-            break;
-
-        case USB_DEVICE_ID_RAZER_TARTARUS_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            break;
-
-        case USB_DEVICE_ID_RAZER_ORBWEAVER_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_LITE:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_ANANSI:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_STEALTH:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_STEALTH_EDITION:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_ULTIMATE_2012:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_ULTIMATE_2013:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_TE_2014:
-        case USB_DEVICE_ID_RAZER_DEATHSTALKER_EXPERT:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_pulsate);         // Pulsate effect, like breathing
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLADE_2018_BASE:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH_2019:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH_LATE_2019:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH_EARLY_2020:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH_LATE_2020:
-        case USB_DEVICE_ID_RAZER_BOOK_2020:
-        case USB_DEVICE_ID_RAZER_BLADE_2019_BASE:
-        case USB_DEVICE_ID_RAZER_BLADE_EARLY_2020_BASE:
-        case USB_DEVICE_ID_RAZER_BLADE_15_BASE_EARLY_2021:
-        case USB_DEVICE_ID_RAZER_BLADE_15_BASE_2022:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_ULTIMATE_2016:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_X_ULTIMATE:
-        case USB_DEVICE_ID_RAZER_ORNATA:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHSTALKER_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_WIRED:
-        case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_WIRELESS:
-        case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_TKL_WIRED:
-        case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2_PRO_TKL_WIRELESS:
-            device_remove_file(&hdev->dev, &dev_attr_key_super);                     // Super Key
-            device_remove_file(&hdev->dev, &dev_attr_key_alt_tab);                   // Alt + Tab
-            device_remove_file(&hdev->dev, &dev_attr_key_alt_f4);                    // Alt + F4
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);                  // Charge level
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);                 // Charge status
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_V2_TENKEYLESS:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_V2:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);                     // Poll Rate
-            device_remove_file(&hdev->dev, &dev_attr_keyswitch_optimization);        // Keyswitch Optimization
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3:
-        case USB_DEVICE_ID_RAZER_DEATHSTALKER_V2:
-            device_remove_file(&hdev->dev, &dev_attr_key_super);                     // Super Key
-            device_remove_file(&hdev->dev, &dev_attr_key_alt_tab);                   // Alt + Tab
-            device_remove_file(&hdev->dev, &dev_attr_key_alt_f4);                    // Alt + F4
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_ORNATA_CHROMA:
-        case USB_DEVICE_ID_RAZER_ORNATA_V2:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_ELITE:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_TE:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_MINI:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_MINI_JP:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_2019:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN:
-        case USB_DEVICE_ID_RAZER_CYNOSA_CHROMA:
-        case USB_DEVICE_ID_RAZER_CYNOSA_CHROMA_PRO:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_ELITE:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_ESSENTIAL:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_CHROMA_V2:
-        case USB_DEVICE_ID_RAZER_CYNOSA_V2:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_TK:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_MINI:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_MINI_WIRELESS:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);                  // Battery charge level
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);                 // Battery charge status
-            break;
-
-        case USB_DEVICE_ID_RAZER_CYNOSA_LITE:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_ORNATA_V3_X:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_V3_PRO_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);                  // Charge level
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);                 // Charge status
-            device_remove_file(&hdev->dev, &dev_attr_charge_effect);                 // Charge effect
-            device_remove_file(&hdev->dev, &dev_attr_charge_colour);                 // Charge colour
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);          // Charge low threshold
-            break;
-
-        case USB_DEVICE_ID_RAZER_TARTARUS_V2:
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_red);               // Profile/Macro LED Red
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_green);             // Profile/Macro LED Green
-            device_remove_file(&hdev->dev, &dev_attr_profile_led_blue);              // Profile/Macro LED Blue
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLADE_2018_MERCURY:
-        case USB_DEVICE_ID_RAZER_BLADE_2019_ADV:
-        case USB_DEVICE_ID_RAZER_BLADE_STUDIO_EDITION_2019:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLADE_LATE_2016:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_fn_toggle);                     // Sets whether FN is requires for F-Keys
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLADE_QHD:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH_LATE_2016:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH_MID_2017:
-        case USB_DEVICE_ID_RAZER_BLADE_STEALTH_LATE_2017:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_fn_toggle);                     // Sets whether FN is requires for F-Keys
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);                // Enable/Disable the logo
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLADE_PRO_LATE_2016:
-        case USB_DEVICE_ID_RAZER_BLADE_2018:
-        case USB_DEVICE_ID_RAZER_BLADE_PRO_2017:
-        case USB_DEVICE_ID_RAZER_BLADE_PRO_2017_FULLHD:
-        case USB_DEVICE_ID_RAZER_BLADE_MID_2019_MERCURY:
-        case USB_DEVICE_ID_RAZER_BLADE_PRO_2019:
-        case USB_DEVICE_ID_RAZER_BLADE_PRO_LATE_2019:
-        case USB_DEVICE_ID_RAZER_BLADE_15_ADV_2020:
-        case USB_DEVICE_ID_RAZER_BLADE_15_ADV_MID_2021:
-        case USB_DEVICE_ID_RAZER_BLADE_17_PRO_EARLY_2021:
-        case USB_DEVICE_ID_RAZER_BLADE_17_PRO_MID_2021:
-        case USB_DEVICE_ID_RAZER_BLADE_15_ADV_EARLY_2021:
-        case USB_DEVICE_ID_RAZER_BLADE_14_2021:
-        case USB_DEVICE_ID_RAZER_BLADE_17_2022:
-        case USB_DEVICE_ID_RAZER_BLADE_14_2022:
-        case USB_DEVICE_ID_RAZER_BLADE_15_ADV_EARLY_2022:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_starlight);       // Starlight effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);                // Enable/Disable the logo
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLADE_PRO_EARLY_2020:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            break;
-
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_CHROMA:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_CHROMA_TE:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_OVERWATCH:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_X_CHROMA:
-        case USB_DEVICE_ID_RAZER_BLACKWIDOW_X_CHROMA_TE:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_V2_ANALOG:
-        case USB_DEVICE_ID_RAZER_HUNTSMAN_MINI_ANALOG:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);            // Wave effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);        // Reactive effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);           // Set LED matrix
-            device_remove_file(&hdev->dev, &dev_attr_game_led_state);                // Enable game mode & LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_state);               // Enable macro LED
-            device_remove_file(&hdev->dev, &dev_attr_macro_led_effect);              // Change macro LED effect (static, flashing)
-            break;
-        }
-    } else if(intf->cur_altsetting->desc.bInterfaceProtocol == USB_INTERFACE_PROTOCOL_KEYBOARD) {
-        device_remove_file(&hdev->dev, &dev_attr_key_super);
-        device_remove_file(&hdev->dev, &dev_attr_key_alt_tab);
-        device_remove_file(&hdev->dev, &dev_attr_key_alt_f4);
-    }
+    cancel_work_sync(&dev->init_work);
 
     hid_hw_stop(hdev);
     kfree(dev);
     dev_info(&intf->dev, "Razer Device disconnected\n");
 }
 
+#ifdef CONFIG_PM
+/**
+ * Forget the cached settings, the device may have lost them over suspend
+ */
+static int razer_kbd_resume(struct hid_device *hdev)
+{
+    struct razer_kbd_device *dev = hid_get_drvdata(hdev);
+
+    mutex_lock(&dev->lock);
+    memset(dev->cached, 0, sizeof(dev->cached));
+    WRITE_ONCE(dev->settings_cached, false);
+    mutex_unlock(&dev->lock);
+
+    return 0;
+}
+#endif
+
 /**
  * Device ID mapping table
  */
@@ -4335,6 +4163,14 @@ static struct hid_driver razer_kbd_driver = {
     .remove = razer_kbd_disconnect,
     .event = razer_event,
     .raw_event = razer_raw_event,
+#ifdef CONFIG_PM
+    .resume = razer_kbd_resume,
+    .reset_resume = razer_kbd_resume,
+#endif
+    .driver = {
+        .dev_groups = razer_kbd_groups,
+        .probe_type = PROBE_PREFER_ASYNCHRONOUS,
+    },
 };
 
 module_hid_driver(razer_kbd_driver);
@@ -7,6 +7,10 @@
 #ifndef __HID_RAZER_KBD_H
 #define __HID_RAZER_KBD_H
 
+#include <linux/bitmap.h>
+
+#include "razercommon.h"
+
 #define USB_DEVICE_ID_RAZER_BLACKWIDOW_ULTIMATE_2012 0x010D
 // 2011 or so edition, see https://web.archive.org/web/20111113132427/http://store.razerzone.com:80/store/razerusa/en_US/pd/productID.235228400/categoryId.49136200/parentCategoryId.35156900
 #define USB_DEVICE_ID_RAZER_BLACKWIDOW_STEALTH_EDITION 0x010E
@@ -149,12 +153,71 @@
 #define RAZER_FIREFLY_WAIT_MAX_US 1000
 
 
+/*
+ * One bit per sysfs attribute, set in probe for the attributes the device supports
+ */
+enum razer_kbd_cap {
+    RAZER_KBD_CAP_VERSION,
+    RAZER_KBD_CAP_FIRMWARE_VERSION,
+    RAZER_KBD_CAP_DEVICE_SERIAL,
+    RAZER_KBD_CAP_MATRIX_BRIGHTNESS,
+    RAZER_KBD_CAP_TEST,
+    RAZER_KBD_CAP_DEVICE_TYPE,
+    RAZER_KBD_CAP_DEVICE_MODE,
+    RAZER_KBD_CAP_KBD_LAYOUT,
+    RAZER_KBD_CAP_CAPABILITIES,
+    RAZER_KBD_CAP_KEY_SUPER,
+    RAZER_KBD_CAP_KEY_ALT_TAB,
+    RAZER_KBD_CAP_KEY_ALT_F4,
+    RAZER_KBD_CAP_PROFILE_LED_RED,
+    RAZER_KBD_CAP_PROFILE_LED_GREEN,
+    RAZER_KBD_CAP_PROFILE_LED_BLUE,
+    RAZER_KBD_CAP_MATRIX_EFFECT_STATIC,
+    RAZER_KBD_CAP_MATRIX_EFFECT_PULSATE,
+    RAZER_KBD_CAP_MATRIX_EFFECT_NONE,
+    RAZER_KBD_CAP_MATRIX_EFFECT_SPECTRUM,
+    RAZER_KBD_CAP_MATRIX_EFFECT_BREATH,
+    RAZER_KBD_CAP_MATRIX_EFFECT_WAVE,
+    RAZER_KBD_CAP_MATRIX_EFFECT_CUSTOM,
+    RAZER_KBD_CAP_MATRIX_CUSTOM_FRAME,
+    RAZER_KBD_CAP_GAME_LED_STATE,
+    RAZER_KBD_CAP_MACRO_LED_STATE,
+    RAZER_KBD_CAP_MACRO_LED_EFFECT,
+    RAZER_KBD_CAP_MATRIX_EFFECT_REACTIVE,
+    RAZER_KBD_CAP_MATRIX_EFFECT_STARLIGHT,
+    RAZER_KBD_CAP_CHARGE_LEVEL,
+    RAZER_KBD_CAP_CHARGE_STATUS,
+    RAZER_KBD_CAP_POLL_RATE,
+    RAZER_KBD_CAP_KEYSWITCH_OPTIMIZATION,
+    RAZER_KBD_CAP_CHARGE_EFFECT,
+    RAZER_KBD_CAP_CHARGE_COLOUR,
+    RAZER_KBD_CAP_CHARGE_LOW_THRESHOLD,
+    RAZER_KBD_CAP_FN_TOGGLE,
+    RAZER_KBD_CAP_LOGO_LED_STATE,
+    RAZER_KBD_CAP_COUNT
+};
+
 struct razer_kbd_device {
+    struct usb_device *usb_dev;
+    struct hid_device *hdev;
+
+    // USB round trips done after probe returned, see razer_kbd_init_work()
+    struct work_struct init_work;
+    ktime_t probe_start;
+
     unsigned int fn_on;
     DECLARE_BITMAP(pressed_fn, KEY_CNT);
 
     unsigned char block_keys[3];
     unsigned char left_alt_on;
+
+    DECLARE_BITMAP(caps, RAZER_KBD_CAP_COUNT);
+
+    // Protects cached
+    struct mutex lock;
+    struct razer_cached_value cached[RAZER_KBD_CAP_COUNT];
+    // Whether cached was read from the device since probe or resume
+    bool settings_cached;
 };
 
 
@@ -10,6 +10,7 @@
 #include <linux/usb/input.h>
 #include <linux/hid.h>
 #include <linux/random.h>
+#include <linux/ktime.h>
 
 #include "razerkraken_driver.h"
 #include "razercommon.h"
@@ -683,6 +684,115 @@ static DEVICE_ATTR(matrix_effect_static,    0660, razer_attr_read_matrix_effect_
 static DEVICE_ATTR(matrix_effect_custom,    0660, razer_attr_read_matrix_effect_custom,       razer_attr_write_matrix_effect_custom);
 static DEVICE_ATTR(matrix_effect_breath,    0660, razer_attr_read_matrix_effect_breath,       razer_attr_write_matrix_effect_breath);
 
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf);
+static DEVICE_ATTR(capabilities,            0440, razer_attr_read_capabilities,               NULL);
+
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count);
+static BIN_ATTR(state_snapshot, 0440, razer_attr_read_state_snapshot, NULL, RAZER_STATE_SNAPSHOT_SIZE);
+
+/**
+ * Every attribute the driver knows about, indexed by capability bit
+ */
+static struct attribute *razer_kraken_attrs[] = {
+    [RAZER_KRAKEN_CAP_VERSION] = &dev_attr_version.attr,                                 // Get driver version
+    [RAZER_KRAKEN_CAP_TEST] = &dev_attr_test.attr,                                       // Test mode
+    [RAZER_KRAKEN_CAP_DEVICE_TYPE] = &dev_attr_device_type.attr,                         // Get string of device type
+    [RAZER_KRAKEN_CAP_DEVICE_SERIAL] = &dev_attr_device_serial.attr,                     // Get string of device serial
+    [RAZER_KRAKEN_CAP_FIRMWARE_VERSION] = &dev_attr_firmware_version.attr,               // Get string of device fw version
+    [RAZER_KRAKEN_CAP_DEVICE_MODE] = &dev_attr_device_mode.attr,                         // Get device mode
+    [RAZER_KRAKEN_CAP_CAPABILITIES] = &dev_attr_capabilities.attr,                       // Get the list of supported attributes
+    [RAZER_KRAKEN_CAP_MATRIX_EFFECT_NONE] = &dev_attr_matrix_effect_none.attr,           // No effect
+    [RAZER_KRAKEN_CAP_MATRIX_EFFECT_STATIC] = &dev_attr_matrix_effect_static.attr,       // Static effect
+    [RAZER_KRAKEN_CAP_MATRIX_CURRENT_EFFECT] = &dev_attr_matrix_current_effect.attr,     // Get current effect
+    [RAZER_KRAKEN_CAP_MATRIX_EFFECT_SPECTRUM] = &dev_attr_matrix_effect_spectrum.attr,   // Spectrum effect
+    [RAZER_KRAKEN_CAP_MATRIX_EFFECT_CUSTOM] = &dev_attr_matrix_effect_custom.attr,       // Custom effect
+    [RAZER_KRAKEN_CAP_MATRIX_EFFECT_BREATH] = &dev_attr_matrix_effect_breath.attr,       // Breathing effect
+    [RAZER_KRAKEN_CAP_COUNT] = NULL
+};
+
+/**
+ * Only show the attributes the bound device has a capability bit for
+ */
+static umode_t razer_kraken_attr_is_visible(struct kobject *kobj, struct attribute *attr, int n)
+{
+    struct razer_kraken_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(n, device->caps)) {
+        return 0;
+    }
+
+    return attr->mode;
+}
+
+/**
+ * Read device file "capabilities"
+ *
+ * Returns the names of the attributes supported by the device, space separated
+ */
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct razer_kraken_device *device = dev_get_drvdata(dev);
+
+    return razer_print_caps(buf, razer_kraken_attrs, device->caps, RAZER_KRAKEN_CAP_COUNT);
+}
+
+/**
+ * Read device file "state_snapshot"
+ *
+ * Returns the driver version, device type and capabilities in one packed blob, see razercommon.h
+ * for the layout. Nothing is read from the device. It has to be read in one go, reads at an
+ * offset return nothing.
+ */
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count)
+{
+    struct device *dev = kobj_to_dev(kobj);
+    struct razer_kraken_device *device = dev_get_drvdata(dev);
+    DECLARE_BITMAP(cheap_caps, RAZER_KRAKEN_CAP_COUNT) = {0};
+    ssize_t len;
+
+    if(off) {
+        return 0;
+    }
+
+    set_bit(RAZER_KRAKEN_CAP_VERSION, cheap_caps);
+    set_bit(RAZER_KRAKEN_CAP_DEVICE_TYPE, cheap_caps);
+    set_bit(RAZER_KRAKEN_CAP_CAPABILITIES, cheap_caps);
+
+    mutex_lock(&device->lock);
+    len = razer_build_state_snapshot(dev, razer_kraken_attrs, device->caps, cheap_caps, NULL, RAZER_KRAKEN_CAP_COUNT, buf, count);
+    mutex_unlock(&device->lock);
+
+    return len;
+}
+
+static struct bin_attribute *razer_kraken_bin_attrs[] = {
+    &bin_attr_state_snapshot,
+    NULL
+};
+
+/**
+ * The snapshot is available wherever the capability list is
+ */
+static umode_t razer_kraken_bin_attr_is_visible(struct kobject *kobj, struct bin_attribute *attr, int n)
+{
+    struct razer_kraken_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(RAZER_KRAKEN_CAP_CAPABILITIES, device->caps)) {
+        return 0;
+    }
+
+    return attr->attr.mode;
+}
+
+static const struct attribute_group razer_kraken_group = {
+    .attrs = razer_kraken_attrs,
+    .bin_attrs = razer_kraken_bin_attrs,
+    .is_visible = razer_kraken_attr_is_visible,
+    .is_bin_visible = razer_kraken_bin_attr_is_visible,
+};
+
+__ATTRIBUTE_GROUPS(razer_kraken);
+
 static void razer_kraken_init(struct razer_kraken_device *dev, struct usb_interface *intf)
 {
     struct usb_device *usb_dev = interface_to_usbdev(intf);
@@ -728,6 +838,7 @@ static int razer_kraken_probe(struct hid_device *hdev, const struct hid_device_i
     struct usb_interface *intf = to_usb_interface(hdev->dev.parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     struct razer_kraken_device *dev = NULL;
+    ktime_t probe_start = ktime_get();
 
     dev = kzalloc(sizeof(struct razer_kraken_device), GFP_KERNEL);
     if(dev == NULL) {
@@ -740,47 +851,53 @@ static int razer_kraken_probe(struct hid_device *hdev, const struct hid_device_i
     razer_kraken_init(dev, intf);
 
     if(dev->usb_interface_protocol == USB_INTERFACE_PROTOCOL_NONE) {
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_version);                               // Get driver version
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_test);                                  // Test mode
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_type);                           // Get string of device type
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_serial);                         // Get string of device serial
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_firmware_version);                      // Get string of device fw version
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_mode);                           // Get device mode
+        set_bit(RAZER_KRAKEN_CAP_VERSION, dev->caps);
+        set_bit(RAZER_KRAKEN_CAP_TEST, dev->caps);
+        set_bit(RAZER_KRAKEN_CAP_DEVICE_TYPE, dev->caps);
+        set_bit(RAZER_KRAKEN_CAP_DEVICE_SERIAL, dev->caps);
+        set_bit(RAZER_KRAKEN_CAP_FIRMWARE_VERSION, dev->caps);
+        set_bit(RAZER_KRAKEN_CAP_DEVICE_MODE, dev->caps);
+        set_bit(RAZER_KRAKEN_CAP_CAPABILITIES, dev->caps);
 
         switch(dev->usb_pid) {
         case USB_DEVICE_ID_RAZER_KRAKEN_CLASSIC:
         case USB_DEVICE_ID_RAZER_KRAKEN_CLASSIC_ALT:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_current_effect);         // Get current effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_EFFECT_NONE, dev->caps);                 // No effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_EFFECT_STATIC, dev->caps);               // Static effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_CURRENT_EFFECT, dev->caps);              // Get current effect
             break;
         case USB_DEVICE_ID_RAZER_KRAKEN:
         case USB_DEVICE_ID_RAZER_KRAKEN_V2:
         case USB_DEVICE_ID_RAZER_KRAKEN_ULTIMATE:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_current_effect);         // Get current effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_EFFECT_NONE, dev->caps);                 // No effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);             // Spectrum effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_EFFECT_STATIC, dev->caps);               // Static effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);               // Custom effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_EFFECT_BREATH, dev->caps);               // Breathing effect
+            set_bit(RAZER_KRAKEN_CAP_MATRIX_CURRENT_EFFECT, dev->caps);              // Get current effect
             break;
         }
     }
 
     dev_set_drvdata(&hdev->dev, dev);
 
-    if(hid_parse(hdev)) {
+    retval = hid_parse(hdev);
+    if(retval) {
         hid_err(hdev, "parse failed\n");
         goto exit_free;
     }
 
-    if (hid_hw_start(hdev, HID_CONNECT_DEFAULT)) {
+    retval = hid_hw_start(hdev, HID_CONNECT_DEFAULT);
+    if(retval) {
         hid_err(hdev, "hw start failed\n");
         goto exit_free;
     }
 
     usb_disable_autosuspend(usb_dev);
 
+    // Nothing is sent to the device during probe so there is no deferred part like in razerkbd
+    hid_dbg(hdev, "initialised in %lld us\n", ktime_us_delta(ktime_get(), probe_start));
+
     return 0;
 exit:
     return retval;
@@ -799,35 +916,6 @@ static void razer_kraken_disconnect(struct hid_device *hdev)
 
     dev = hid_get_drvdata(hdev);
 
-    if(dev->usb_interface_protocol == USB_INTERFACE_PROTOCOL_NONE) {
-        device_remove_file(&hdev->dev, &dev_attr_version);                               // Get driver version
-        device_remove_file(&hdev->dev, &dev_attr_test);                                  // Test mode
-        device_remove_file(&hdev->dev, &dev_attr_device_type);                           // Get string of device type
-        device_remove_file(&hdev->dev, &dev_attr_device_serial);                         // Get string of device serial
-        device_remove_file(&hdev->dev, &dev_attr_firmware_version);                      // Get string of device fw version
-        device_remove_file(&hdev->dev, &dev_attr_device_mode);                           // Get device mode
-
-        switch(dev->usb_pid) {
-        case USB_DEVICE_ID_RAZER_KRAKEN_CLASSIC:
-        case USB_DEVICE_ID_RAZER_KRAKEN_CLASSIC_ALT:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_current_effect);         // Get current effect
-            break;
-
-        case USB_DEVICE_ID_RAZER_KRAKEN:
-        case USB_DEVICE_ID_RAZER_KRAKEN_V2:
-        case USB_DEVICE_ID_RAZER_KRAKEN_ULTIMATE:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);            // No effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);        // Spectrum effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);          // Static effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);          // Custom effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);          // Breathing effect
-            device_remove_file(&hdev->dev, &dev_attr_matrix_current_effect);         // Get current effect
-            break;
-        }
-    }
-
     hid_hw_stop(hdev);
     kfree(dev);
     dev_info(&intf->dev, "Razer Device disconnected\n");
@@ -871,7 +959,11 @@ static struct hid_driver razer_kraken_driver = {
     .id_table = razer_devices,
     .probe = razer_kraken_probe,
     .remove = razer_kraken_disconnect,
-    .raw_event = razer_raw_event
+    .raw_event = razer_raw_event,
+    .driver = {
+        .dev_groups = razer_kraken_groups,
+        .probe_type = PROBE_PREFER_ASYNCHRONOUS,
+    },
 };
 
 module_hid_driver(razer_kraken_driver);
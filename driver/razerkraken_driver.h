@@ -6,6 +6,8 @@
 #ifndef __HID_RAZER_KRAKEN_H
 #define __HID_RAZER_KRAKEN_H
 
+#include <linux/bitmap.h>
+
 // Codename Unknown
 #define USB_DEVICE_ID_RAZER_KRAKEN_CLASSIC 0x0501
 // Codename Rainie
@@ -21,6 +23,26 @@
 
 // #define RAZER_KRAKEN_V2_REPORT_LEN ?
 
+/*
+ * One bit per sysfs attribute, set in probe for the attributes the device supports
+ */
+enum razer_kraken_cap {
+    RAZER_KRAKEN_CAP_VERSION,
+    RAZER_KRAKEN_CAP_TEST,
+    RAZER_KRAKEN_CAP_DEVICE_TYPE,
+    RAZER_KRAKEN_CAP_DEVICE_SERIAL,
+    RAZER_KRAKEN_CAP_FIRMWARE_VERSION,
+    RAZER_KRAKEN_CAP_DEVICE_MODE,
+    RAZER_KRAKEN_CAP_CAPABILITIES,
+    RAZER_KRAKEN_CAP_MATRIX_EFFECT_NONE,
+    RAZER_KRAKEN_CAP_MATRIX_EFFECT_STATIC,
+    RAZER_KRAKEN_CAP_MATRIX_CURRENT_EFFECT,
+    RAZER_KRAKEN_CAP_MATRIX_EFFECT_SPECTRUM,
+    RAZER_KRAKEN_CAP_MATRIX_EFFECT_CUSTOM,
+    RAZER_KRAKEN_CAP_MATRIX_EFFECT_BREATH,
+    RAZER_KRAKEN_CAP_COUNT
+};
+
 struct razer_kraken_device {
     struct usb_device *usb_dev;
     struct mutex lock;
@@ -39,6 +61,7 @@ struct razer_kraken_device {
 
     u8 data[33];
 
+    DECLARE_BITMAP(caps, RAZER_KRAKEN_CAP_COUNT);
 };
 
 union razer_kraken_effect_byte {
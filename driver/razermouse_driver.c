@@ -11,6 +11,7 @@
 #include <linux/hid.h>
 #include <linux/hrtimer.h>
 #include <linux/random.h>
+#include <linux/ktime.h>
 
 #include "razermouse_driver.h"
 #include "razercommon.h"
@@ -1267,6 +1268,7 @@ static ssize_t razer_attr_read_poll_rate(struct device *dev, struct device_attri
     struct razer_report request = razer_chroma_misc_get_polling_rate();
     struct razer_report response = {0};
     unsigned short polling_rate = 0;
+    int err = 0;
 
     switch(device->usb_pid) {
     case USB_DEVICE_ID_RAZER_DEATHADDER_3_5G:
@@ -1363,7 +1365,7 @@ static ssize_t razer_attr_read_poll_rate(struct device *dev, struct device_attri
         response.arguments[0] = device->orochi2011.poll;
     } else {
         mutex_lock(&device->lock);
-        razer_send_payload(device->usb_dev, &request, &response);
+        err = razer_send_payload(device->usb_dev, &request, &response);
         mutex_unlock(&device->lock);
     }
 
@@ -1379,6 +1381,10 @@ static ssize_t razer_attr_read_poll_rate(struct device *dev, struct device_attri
         break;
     }
 
+    if(!err) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_POLL_RATE, "%d", polling_rate);
+    }
+
     return sprintf(buf, "%d\n", polling_rate);
 }
 
@@ -1393,6 +1399,7 @@ static ssize_t razer_attr_write_poll_rate(struct device *dev, struct device_attr
     unsigned short polling_rate = (unsigned short)simple_strtoul(buf, NULL, 10);
     struct razer_report request = razer_chroma_misc_set_polling_rate(polling_rate);
     struct razer_report response = {0};
+    int err;
 
     switch(device->usb_pid) {
     case USB_DEVICE_ID_RAZER_DEATHADDER_3_5G:
@@ -1458,17 +1465,22 @@ static ssize_t razer_attr_write_poll_rate(struct device *dev, struct device_attr
     }
 
     mutex_lock(&device->lock);
-    razer_send_payload(device->usb_dev, &request, &response);
+    err = razer_send_payload(device->usb_dev, &request, &response);
 
     // For certain devices, Razer sends each request once with 0x00 and once with 0x01
     switch(device->usb_pid) {
     case USB_DEVICE_ID_RAZER_VIPER_8K:
     case USB_DEVICE_ID_RAZER_HYPERPOLLING_WIRELESS_DONGLE:
         request = razer_chroma_misc_set_polling_rate2(polling_rate, 0x01);
-        razer_send_payload(device->usb_dev, &request, &response);
+        if(razer_send_payload(device->usb_dev, &request, &response)) {
+            err = -EIO;
+        }
         break;
     }
 
+    if(!err) {
+        razer_cache_value(&device->cached[RAZER_MOUSE_CAP_POLL_RATE], "%d", polling_rate);
+    }
     mutex_unlock(&device->lock);
 
     return count;
@@ -1482,6 +1494,7 @@ static ssize_t razer_attr_write_poll_rate(struct device *dev, struct device_attr
 
 static ssize_t razer_attr_write_matrix_brightness(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned char brightness = (unsigned char)simple_strtoul(buf, NULL, 10);
@@ -1524,7 +1537,9 @@ static ssize_t razer_attr_write_matrix_brightness(struct device *dev, struct dev
         request = razer_chroma_standard_set_led_brightness(VARSTORE, BACKLIGHT_LED, brightness);
         break;
     }
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, "%d", brightness);
+    }
 
     return count;
 }
@@ -1536,6 +1551,7 @@ static ssize_t razer_attr_write_matrix_brightness(struct device *dev, struct dev
  */
 static ssize_t razer_attr_read_matrix_brightness(struct device *dev, struct device_attribute *attr, char *buf)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     struct razer_report request = {0};
@@ -1585,6 +1601,8 @@ static ssize_t razer_attr_read_matrix_brightness(struct device *dev, struct devi
     if (response.status != RAZER_CMD_SUCCESSFUL) {
         return 0;
     }
+    razer_cache_setting(device, RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, "%d", response.arguments[brightness_index]);
+
     // Brightness is at arg[0] for dock and arg[1] for led_brightness
     return sprintf(buf, "%d\n", response.arguments[brightness_index]);
 }
@@ -1639,7 +1657,9 @@ static ssize_t razer_attr_write_dpi(struct device *dev, struct device_attribute
         }
 
         request = razer_chroma_misc_set_dpi_xy_byte(dpi_x_byte, dpi_y_byte);
-        razer_send_payload(device->usb_dev, &request, &response);
+        if(!razer_send_payload(device->usb_dev, &request, &response)) {
+            razer_cache_setting(device, RAZER_MOUSE_CAP_DPI, "%u:%u", dpi_x_byte, dpi_y_byte);
+        }
         return count;
         break;
 
@@ -1684,7 +1704,8 @@ static ssize_t razer_attr_write_dpi(struct device *dev, struct device_attribute
 
     if (count == 2) {
         dpi_x = (buf[0] << 8) | (buf[1] & 0xFF); // TODO make convenience function
-        request = razer_chroma_misc_set_dpi_xy(varstore, dpi_x, dpi_x);
+        dpi_y = dpi_x;
+        request = razer_chroma_misc_set_dpi_xy(varstore, dpi_x, dpi_y);
 
     } else if(count == 4) {
         dpi_x = (buf[0] << 8) | (buf[1] & 0xFF); // Apparently the char buffer is rubbish, as buf[1] somehow can equal FFFFFF80????
@@ -1740,7 +1761,9 @@ static ssize_t razer_attr_write_dpi(struct device *dev, struct device_attribute
         break;
     }
 
-    razer_send_payload(device->usb_dev, &request, &response);
+    if(!razer_send_payload(device->usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_DPI, "%u:%u", dpi_x, dpi_y);
+    }
 
     return count;
 }
@@ -1850,7 +1873,9 @@ static ssize_t razer_attr_read_dpi(struct device *dev, struct device_attribute *
         break;
     }
 
-    razer_send_payload(device->usb_dev, &request, &response);
+    if(razer_send_payload(device->usb_dev, &request, &response)) {
+        return sprintf(buf, "%u:%u\n", 0, 0);
+    }
 
     // Byte, Byte for DPI not Short, Short
     if (device->usb_pid == USB_DEVICE_ID_RAZER_NAGA_HEX ||
@@ -1865,6 +1890,8 @@ static ssize_t razer_attr_read_dpi(struct device *dev, struct device_attribute *
         dpi_y = (response.arguments[3] << 8) | (response.arguments[4] & 0xFF);
     }
 
+    razer_cache_setting(device, RAZER_MOUSE_CAP_DPI, "%u:%u", dpi_x, dpi_y);
+
     return sprintf(buf, "%u:%u\n", dpi_x, dpi_y);
 }
 
@@ -2624,6 +2651,7 @@ static ssize_t razer_attr_read_device_mode(struct device *dev, struct device_att
  */
 static ssize_t razer_attr_read_scroll_led_brightness(struct device *dev, struct device_attribute *attr, char *buf)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     struct razer_report request = razer_chroma_standard_get_led_brightness(VARSTORE, SCROLL_WHEEL_LED);
@@ -2670,7 +2698,9 @@ static ssize_t razer_attr_read_scroll_led_brightness(struct device *dev, struct
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, "%d", response.arguments[2]);
+    }
 
     return sprintf(buf, "%d\n", response.arguments[2]);
 }
@@ -2680,6 +2710,7 @@ static ssize_t razer_attr_read_scroll_led_brightness(struct device *dev, struct
  */
 static ssize_t razer_attr_write_scroll_led_brightness(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned char brightness = (unsigned char)simple_strtoul(buf, NULL, 10);
@@ -2727,7 +2758,9 @@ static ssize_t razer_attr_write_scroll_led_brightness(struct device *dev, struct
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, "%d", brightness);
+    }
 
     return count;
 }
@@ -2737,6 +2770,7 @@ static ssize_t razer_attr_write_scroll_led_brightness(struct device *dev, struct
  */
 static ssize_t razer_attr_read_logo_led_brightness(struct device *dev, struct device_attribute *attr, char *buf)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     struct razer_report request = {0};
@@ -2796,7 +2830,9 @@ static ssize_t razer_attr_read_logo_led_brightness(struct device *dev, struct de
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, "%d", response.arguments[2]);
+    }
 
     return sprintf(buf, "%d\n", response.arguments[2]);
 }
@@ -2806,6 +2842,7 @@ static ssize_t razer_attr_read_logo_led_brightness(struct device *dev, struct de
  */
 static ssize_t razer_attr_write_logo_led_brightness(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned char brightness = (unsigned char)simple_strtoul(buf, NULL, 10);
@@ -2866,13 +2903,16 @@ static ssize_t razer_attr_write_logo_led_brightness(struct device *dev, struct d
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, "%d", brightness);
+    }
 
     return count;
 }
 
 static ssize_t razer_attr_read_side_led_brightness(struct device *dev, struct device_attribute *attr, char *buf, int side)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     struct razer_report request = {0};
@@ -2903,13 +2943,16 @@ static ssize_t razer_attr_read_side_led_brightness(struct device *dev, struct de
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, side == LEFT_SIDE_LED ? RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS : RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS, "%d", response.arguments[2]);
+    }
 
     return sprintf(buf, "%d\n", response.arguments[2]);
 }
 
 static ssize_t razer_attr_write_side_led_brightness(struct device *dev, struct device_attribute *attr, const char *buf, size_t count, int side)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned char brightness = (unsigned char)simple_strtoul(buf, NULL, 10);
@@ -2941,7 +2984,9 @@ static ssize_t razer_attr_write_side_led_brightness(struct device *dev, struct d
         break;
     }
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, side == LEFT_SIDE_LED ? RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS : RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS, "%d", brightness);
+    }
 
     return count;
 }
@@ -2983,6 +3028,7 @@ static ssize_t razer_attr_write_right_led_brightness(struct device *dev, struct
  */
 static ssize_t razer_attr_read_backlight_led_brightness(struct device *dev, struct device_attribute *attr, char *buf)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     struct razer_report request = {0};
@@ -2990,7 +3036,9 @@ static ssize_t razer_attr_read_backlight_led_brightness(struct device *dev, stru
 
     request = razer_chroma_standard_get_led_brightness(VARSTORE, BACKLIGHT_LED);
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_BACKLIGHT_LED_BRIGHTNESS, "%d", response.arguments[2]);
+    }
 
     return sprintf(buf, "%d\n", response.arguments[2]);
 }
@@ -3000,6 +3048,7 @@ static ssize_t razer_attr_read_backlight_led_brightness(struct device *dev, stru
  */
 static ssize_t razer_attr_write_backlight_led_brightness(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
 {
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
     struct usb_interface *intf = to_usb_interface(dev->parent);
     struct usb_device *usb_dev = interface_to_usbdev(intf);
     unsigned char brightness = (unsigned char)simple_strtoul(buf, NULL, 10);
@@ -3008,7 +3057,9 @@ static ssize_t razer_attr_write_backlight_led_brightness(struct device *dev, str
 
     request = razer_chroma_standard_set_led_brightness(VARSTORE, BACKLIGHT_LED, brightness);
 
-    razer_send_payload(usb_dev, &request, &response);
+    if(!razer_send_payload(usb_dev, &request, &response)) {
+        razer_cache_setting(device, RAZER_MOUSE_CAP_BACKLIGHT_LED_BRIGHTNESS, "%d", brightness);
+    }
 
     return count;
 }
@@ -4727,6 +4778,194 @@ static DEVICE_ATTR(hyperpolling_wireless_dongle_indicator_led_mode,
 static DEVICE_ATTR(hyperpolling_wireless_dongle_pair,                           0220, NULL, razer_attr_write_hyperpolling_wireless_dongle_pair);
 static DEVICE_ATTR(hyperpolling_wireless_dongle_unpair,                         0220, NULL, razer_attr_write_hyperpolling_wireless_dongle_unpair);
 
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf);
+static DEVICE_ATTR(capabilities,            0440, razer_attr_read_capabilities,               NULL);
+
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count);
+static BIN_ATTR(state_snapshot, 0440, razer_attr_read_state_snapshot, NULL, RAZER_STATE_SNAPSHOT_SIZE);
+
+/**
+ * Every attribute the driver knows about, indexed by capability bit
+ */
+static struct attribute *razer_mouse_attrs[] = {
+    [RAZER_MOUSE_CAP_VERSION] = &dev_attr_version.attr,
+    [RAZER_MOUSE_CAP_TEST] = &dev_attr_test.attr,
+    [RAZER_MOUSE_CAP_FIRMWARE_VERSION] = &dev_attr_firmware_version.attr,
+    [RAZER_MOUSE_CAP_DEVICE_TYPE] = &dev_attr_device_type.attr,
+    [RAZER_MOUSE_CAP_DEVICE_SERIAL] = &dev_attr_device_serial.attr,
+    [RAZER_MOUSE_CAP_DEVICE_MODE] = &dev_attr_device_mode.attr,
+    [RAZER_MOUSE_CAP_CAPABILITIES] = &dev_attr_capabilities.attr,
+    [RAZER_MOUSE_CAP_POLL_RATE] = &dev_attr_poll_rate.attr,
+    [RAZER_MOUSE_CAP_DPI] = &dev_attr_dpi.attr,
+    [RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS] = &dev_attr_logo_led_brightness.attr,
+    [RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM] = &dev_attr_logo_matrix_effect_spectrum.attr,
+    [RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE] = &dev_attr_logo_matrix_effect_reactive.attr,
+    [RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH] = &dev_attr_logo_matrix_effect_breath.attr,
+    [RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC] = &dev_attr_logo_matrix_effect_static.attr,
+    [RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE] = &dev_attr_logo_matrix_effect_none.attr,
+    [RAZER_MOUSE_CAP_CHARGE_EFFECT] = &dev_attr_charge_effect.attr,
+    [RAZER_MOUSE_CAP_CHARGE_COLOUR] = &dev_attr_charge_colour.attr,
+    [RAZER_MOUSE_CAP_CHARGE_LEVEL] = &dev_attr_charge_level.attr,
+    [RAZER_MOUSE_CAP_CHARGE_STATUS] = &dev_attr_charge_status.attr,
+    [RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD] = &dev_attr_charge_low_threshold.attr,
+    [RAZER_MOUSE_CAP_DEVICE_IDLE_TIME] = &dev_attr_device_idle_time.attr,
+    [RAZER_MOUSE_CAP_DPI_STAGES] = &dev_attr_dpi_stages.attr,
+    [RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE] = &dev_attr_logo_matrix_effect_wave.attr,
+    [RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS] = &dev_attr_scroll_led_brightness.attr,
+    [RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE] = &dev_attr_scroll_matrix_effect_wave.attr,
+    [RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM] = &dev_attr_scroll_matrix_effect_spectrum.attr,
+    [RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE] = &dev_attr_scroll_matrix_effect_reactive.attr,
+    [RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH] = &dev_attr_scroll_matrix_effect_breath.attr,
+    [RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC] = &dev_attr_scroll_matrix_effect_static.attr,
+    [RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE] = &dev_attr_scroll_matrix_effect_none.attr,
+    [RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS] = &dev_attr_left_led_brightness.attr,
+    [RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_WAVE] = &dev_attr_left_matrix_effect_wave.attr,
+    [RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_SPECTRUM] = &dev_attr_left_matrix_effect_spectrum.attr,
+    [RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_REACTIVE] = &dev_attr_left_matrix_effect_reactive.attr,
+    [RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_BREATH] = &dev_attr_left_matrix_effect_breath.attr,
+    [RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_STATIC] = &dev_attr_left_matrix_effect_static.attr,
+    [RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_NONE] = &dev_attr_left_matrix_effect_none.attr,
+    [RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS] = &dev_attr_right_led_brightness.attr,
+    [RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_WAVE] = &dev_attr_right_matrix_effect_wave.attr,
+    [RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_SPECTRUM] = &dev_attr_right_matrix_effect_spectrum.attr,
+    [RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_REACTIVE] = &dev_attr_right_matrix_effect_reactive.attr,
+    [RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_BREATH] = &dev_attr_right_matrix_effect_breath.attr,
+    [RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_STATIC] = &dev_attr_right_matrix_effect_static.attr,
+    [RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_NONE] = &dev_attr_right_matrix_effect_none.attr,
+    [RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM] = &dev_attr_matrix_effect_custom.attr,
+    [RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME] = &dev_attr_matrix_custom_frame.attr,
+    [RAZER_MOUSE_CAP_TILT_HWHEEL] = &dev_attr_tilt_hwheel.attr,
+    [RAZER_MOUSE_CAP_TILT_REPEAT_DELAY] = &dev_attr_tilt_repeat_delay.attr,
+    [RAZER_MOUSE_CAP_TILT_REPEAT] = &dev_attr_tilt_repeat.attr,
+    [RAZER_MOUSE_CAP_SCROLL_MODE] = &dev_attr_scroll_mode.attr,
+    [RAZER_MOUSE_CAP_SCROLL_ACCELERATION] = &dev_attr_scroll_acceleration.attr,
+    [RAZER_MOUSE_CAP_SCROLL_SMART_REEL] = &dev_attr_scroll_smart_reel.attr,
+    [RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS] = &dev_attr_matrix_brightness.attr,
+    [RAZER_MOUSE_CAP_MATRIX_EFFECT_WAVE] = &dev_attr_matrix_effect_wave.attr,
+    [RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM] = &dev_attr_matrix_effect_spectrum.attr,
+    [RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC] = &dev_attr_matrix_effect_static.attr,
+    [RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE] = &dev_attr_matrix_effect_none.attr,
+    [RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE] = &dev_attr_matrix_effect_reactive.attr,
+    [RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH] = &dev_attr_matrix_effect_breath.attr,
+    [RAZER_MOUSE_CAP_SCROLL_LED_STATE] = &dev_attr_scroll_led_state.attr,
+    [RAZER_MOUSE_CAP_SCROLL_LED_RGB] = &dev_attr_scroll_led_rgb.attr,
+    [RAZER_MOUSE_CAP_SCROLL_LED_EFFECT] = &dev_attr_scroll_led_effect.attr,
+    [RAZER_MOUSE_CAP_LOGO_LED_STATE] = &dev_attr_logo_led_state.attr,
+    [RAZER_MOUSE_CAP_LOGO_LED_RGB] = &dev_attr_logo_led_rgb.attr,
+    [RAZER_MOUSE_CAP_LOGO_LED_EFFECT] = &dev_attr_logo_led_effect.attr,
+    [RAZER_MOUSE_CAP_BACKLIGHT_LED_STATE] = &dev_attr_backlight_led_state.attr,
+    [RAZER_MOUSE_CAP_BACKLIGHT_LED_BRIGHTNESS] = &dev_attr_backlight_led_brightness.attr,
+    [RAZER_MOUSE_CAP_BACKLIGHT_LED_RGB] = &dev_attr_backlight_led_rgb.attr,
+    [RAZER_MOUSE_CAP_BACKLIGHT_LED_EFFECT] = &dev_attr_backlight_led_effect.attr,
+    [RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_INDICATOR_LED_MODE] = &dev_attr_hyperpolling_wireless_dongle_indicator_led_mode.attr,
+    [RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_PAIR] = &dev_attr_hyperpolling_wireless_dongle_pair.attr,
+    [RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_UNPAIR] = &dev_attr_hyperpolling_wireless_dongle_unpair.attr,
+    [RAZER_MOUSE_CAP_COUNT] = NULL
+};
+
+/**
+ * Only show the attributes the bound device has a capability bit for
+ */
+static umode_t razer_mouse_attr_is_visible(struct kobject *kobj, struct attribute *attr, int n)
+{
+    struct razer_mouse_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(n, device->caps)) {
+        return 0;
+    }
+
+    return attr->mode;
+}
+
+/**
+ * Read device file "capabilities"
+ *
+ * Returns the names of the attributes supported by the device, space separated
+ */
+static ssize_t razer_attr_read_capabilities(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
+
+    return razer_print_caps(buf, razer_mouse_attrs, device->caps, RAZER_MOUSE_CAP_COUNT);
+}
+
+/**
+ * Settings whose show functions cache what they read from the device
+ */
+static const unsigned int razer_mouse_cached_caps[] = {
+    RAZER_MOUSE_CAP_POLL_RATE,
+    RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS,
+    RAZER_MOUSE_CAP_DPI,
+    RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_BACKLIGHT_LED_BRIGHTNESS,
+};
+
+/**
+ * Read device file "state_snapshot"
+ *
+ * Returns the driver version, device type, capabilities and the cached settings in one packed
+ * blob, see razercommon.h for the layout. The first read after probe or resume reads the cached
+ * settings from the device, later reads don't talk to the device. It has to be read in one go,
+ * reads at an offset return nothing.
+ */
+static ssize_t razer_attr_read_state_snapshot(struct file *filp, struct kobject *kobj, struct bin_attribute *attr, char *buf, loff_t off, size_t count)
+{
+    struct device *dev = kobj_to_dev(kobj);
+    struct razer_mouse_device *device = dev_get_drvdata(dev);
+    DECLARE_BITMAP(cheap_caps, RAZER_MOUSE_CAP_COUNT) = {0};
+    ssize_t len;
+
+    if(off) {
+        return 0;
+    }
+
+    set_bit(RAZER_MOUSE_CAP_VERSION, cheap_caps);
+    set_bit(RAZER_MOUSE_CAP_DEVICE_TYPE, cheap_caps);
+    set_bit(RAZER_MOUSE_CAP_CAPABILITIES, cheap_caps);
+
+    if(!READ_ONCE(device->settings_cached)) {
+        razer_fill_settings_cache(dev, razer_mouse_attrs, device->caps, razer_mouse_cached_caps, ARRAY_SIZE(razer_mouse_cached_caps));
+        WRITE_ONCE(device->settings_cached, true);
+    }
+
+    mutex_lock(&device->lock);
+    len = razer_build_state_snapshot(dev, razer_mouse_attrs, device->caps, cheap_caps, device->cached, RAZER_MOUSE_CAP_COUNT, buf, count);
+    mutex_unlock(&device->lock);
+
+    return len;
+}
+
+static struct bin_attribute *razer_mouse_bin_attrs[] = {
+    &bin_attr_state_snapshot,
+    NULL
+};
+
+/**
+ * The snapshot is available wherever the capability list is
+ */
+static umode_t razer_mouse_bin_attr_is_visible(struct kobject *kobj, struct bin_attribute *attr, int n)
+{
+    struct razer_mouse_device *device = dev_get_drvdata(kobj_to_dev(kobj));
+
+    if(device == NULL || !test_bit(RAZER_MOUSE_CAP_CAPABILITIES, device->caps)) {
+        return 0;
+    }
+
+    return attr->attr.mode;
+}
+
+static const struct attribute_group razer_mouse_group = {
+    .attrs = razer_mouse_attrs,
+    .bin_attrs = razer_mouse_bin_attrs,
+    .is_visible = razer_mouse_attr_is_visible,
+    .is_bin_visible = razer_mouse_bin_attr_is_visible,
+};
+
+__ATTRIBUTE_GROUPS(razer_mouse);
+
 #define REP4_DPI_UP  0x20
 #define REP4_DPI_DN  0x21
 #define REP4_TILT_L  0x22
@@ -5138,6 +5377,7 @@ static int razer_mouse_probe(struct hid_device *hdev, const struct hid_device_id
     struct usb_interface *intf = to_usb_interface(hdev->dev.parent);
     struct razer_mouse_device *dev = NULL;
     unsigned char expected_subclass = 0xFF;
+    ktime_t probe_start = ktime_get();
 
     dev = kzalloc(sizeof(struct razer_mouse_device), GFP_KERNEL);
 
@@ -5162,708 +5402,709 @@ static int razer_mouse_probe(struct hid_device *hdev, const struct hid_device_id
 
     if(dev->usb_interface_protocol == USB_INTERFACE_PROTOCOL_MOUSE
        && (expected_subclass == 0xFF || dev->usb_interface_subclass == expected_subclass)) {
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_version);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_test);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_firmware_version);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_type);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_serial);
-        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_mode);
+        set_bit(RAZER_MOUSE_CAP_VERSION, dev->caps);
+        set_bit(RAZER_MOUSE_CAP_TEST, dev->caps);
+        set_bit(RAZER_MOUSE_CAP_FIRMWARE_VERSION, dev->caps);
+        set_bit(RAZER_MOUSE_CAP_DEVICE_TYPE, dev->caps);
+        set_bit(RAZER_MOUSE_CAP_DEVICE_SERIAL, dev->caps);
+        set_bit(RAZER_MOUSE_CAP_DEVICE_MODE, dev->caps);
+        set_bit(RAZER_MOUSE_CAP_CAPABILITIES, dev->caps);
 
         switch(dev->usb_pid) {
         case USB_DEVICE_ID_RAZER_ABYSSUS_ELITE_DVA_EDITION:
         case USB_DEVICE_ID_RAZER_ABYSSUS_ESSENTIAL:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRELESS:
         case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRELESS_RECEIVER:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_colour);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_COLOUR, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRED:
         case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRELESS_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_LANCEHEAD_TE_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_BASILISK_ULTIMATE_RECEIVER:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_colour);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_COLOUR, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_BASILISK_ULTIMATE_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_hwheel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_HWHEEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT_DELAY, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_BASILISK_V2:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_hwheel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat);
+            set_bit(RAZER_MOUSE_CAP_TILT_HWHEEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT_DELAY, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_DEATHADDER_ELITE:
         case USB_DEVICE_ID_RAZER_BASILISK:
         case USB_DEVICE_ID_RAZER_DEATHADDER_V2:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_BASILISK_V3:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_mode);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_acceleration);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_smart_reel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_hwheel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MODE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_ACCELERATION, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_SMART_REEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_HWHEEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT_DELAY, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_BASILISK_V3_PRO_WIRED:
         case USB_DEVICE_ID_RAZER_BASILISK_V3_PRO_WIRELESS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_mode);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_acceleration);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_smart_reel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_hwheel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MODE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_ACCELERATION, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_SMART_REEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_HWHEEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT_DELAY, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_BASILISK_ESSENTIAL:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_V2_MINI:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_HEX_V2:
         case USB_DEVICE_ID_RAZER_NAGA_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_MAMBA_2012_WIRELESS:
         case USB_DEVICE_ID_RAZER_MAMBA_2012_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_rgb);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_effect);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_RGB, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_EFFECT, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_MAMBA_WIRELESS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_colour);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_COLOUR, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_MAMBA_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_MAMBA_TE_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_OROCHI_2011:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_ABYSSUS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_IMPERATOR:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_OUROBOROS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_2013:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_rgb);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_rgb);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_effect);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_RGB, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_RGB, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_EFFECT, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_OROCHI_2013:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_OROCHI_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_HEX_RED:
         case USB_DEVICE_ID_RAZER_NAGA_HEX:
         case USB_DEVICE_ID_RAZER_TAIPAN:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_2014:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_hwheel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat);
+            set_bit(RAZER_MOUSE_CAP_TILT_HWHEEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT_DELAY, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_NAGA_2012:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_backlight_led_state);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_BACKLIGHT_LED_STATE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_3_5G:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_EPIC_CHROMA:
         case USB_DEVICE_ID_RAZER_NAGA_EPIC_CHROMA_DOCK:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_rgb);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_backlight_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_backlight_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_backlight_led_rgb);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_backlight_led_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_RGB, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_BACKLIGHT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_BACKLIGHT_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_BACKLIGHT_LED_RGB, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_BACKLIGHT_LED_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_3_5G_BLACK:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_ABYSSUS_V2:
         case USB_DEVICE_ID_RAZER_DEATHADDER_3500:
         case USB_DEVICE_ID_RAZER_DEATHADDER_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_rgb);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_rgb);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_effect);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_RGB, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_RGB, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_EFFECT, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_2000:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_effect);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_EFFECT, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DIAMONDBACK_CHROMA:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_ABYSSUS_1800:
         case USB_DEVICE_ID_RAZER_DEATHADDER_1800:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_ABYSSUS_2000:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_state);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_STATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_X:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_LEFT_HANDED_2020:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_PRO_WIRELESS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_colour);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_COLOUR, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_NAGA_PRO_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_MAMBA_ELITE:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_left_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_right_matrix_effect_none);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
-
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_hwheel);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_tilt_repeat);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_WAVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_NONE, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
+
+            set_bit(RAZER_MOUSE_CAP_TILT_HWHEEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT_DELAY, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_TILT_REPEAT, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_ESSENTIAL:
         case USB_DEVICE_ID_RAZER_DEATHADDER_ESSENTIAL_WHITE_EDITION:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_ESSENTIAL_2021:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_NAGA_TRINITY:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_static);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_MAMBA_WIRELESS_RECEIVER:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_colour);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_COLOUR, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_MAMBA_WIRELESS_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_VIPER_ULTIMATE_WIRELESS:
         case USB_DEVICE_ID_RAZER_DEATHADDER_V2_PRO_WIRELESS:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_effect);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_colour);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_EFFECT, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_COLOUR, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_VIPER_ULTIMATE_WIRED:
         case USB_DEVICE_ID_RAZER_DEATHADDER_V2_PRO_WIRED:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
             fallthrough;
         case USB_DEVICE_ID_RAZER_VIPER:
         case USB_DEVICE_ID_RAZER_VIPER_MINI:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_ATHERIS_RECEIVER:
@@ -5878,52 +6119,52 @@ static int razer_mouse_probe(struct hid_device *hdev, const struct hid_device_id
         case USB_DEVICE_ID_RAZER_DEATHADDER_V3_PRO_WIRED:
         case USB_DEVICE_ID_RAZER_DEATHADDER_V3_PRO_WIRELESS:
         case USB_DEVICE_ID_RAZER_PRO_CLICK_MINI_RECEIVER:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_HYPERPOLLING_WIRELESS_DONGLE:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_level);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_status);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_charge_low_threshold);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_idle_time);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_hyperpolling_wireless_dongle_indicator_led_mode);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_hyperpolling_wireless_dongle_pair);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_hyperpolling_wireless_dongle_unpair);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LEVEL, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_STATUS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DEVICE_IDLE_TIME, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_INDICATOR_LED_MODE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_PAIR, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_UNPAIR, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_VIPER_8K:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
             break;
 
         case USB_DEVICE_ID_RAZER_DEATHADDER_V2_LITE:
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_poll_rate);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_dpi_stages);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_led_brightness);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_effect_custom);
-            CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_matrix_custom_frame);
+            set_bit(RAZER_MOUSE_CAP_POLL_RATE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_DPI_STAGES, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM, dev->caps);
+            set_bit(RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME, dev->caps);
             break;
         }
 
@@ -5943,6 +6184,9 @@ static int razer_mouse_probe(struct hid_device *hdev, const struct hid_device_id
         goto exit_free;
     }
 
+    // Nothing is sent to the device during probe so there is no deferred part like in razerkbd
+    hid_dbg(hdev, "initialised in %lld us\n", ktime_us_delta(ktime_get(), probe_start));
+
     //razer_reset(usb_dev);
     //razer_activate_macro_keys(usb_dev);
     //msleep(3000);
@@ -5962,758 +6206,9 @@ static void razer_mouse_disconnect(struct hid_device *hdev)
 {
     struct razer_mouse_device *dev;
     struct usb_interface *intf = to_usb_interface(hdev->dev.parent);
-    struct usb_device *usb_dev = interface_to_usbdev(intf);
 
     dev = hid_get_drvdata(hdev);
 
-    if(intf->cur_altsetting->desc.bInterfaceProtocol == USB_INTERFACE_PROTOCOL_MOUSE) {
-        device_remove_file(&hdev->dev, &dev_attr_version);
-        device_remove_file(&hdev->dev, &dev_attr_test);
-        device_remove_file(&hdev->dev, &dev_attr_firmware_version);
-        device_remove_file(&hdev->dev, &dev_attr_device_type);
-        device_remove_file(&hdev->dev, &dev_attr_device_serial);
-        device_remove_file(&hdev->dev, &dev_attr_device_mode);
-
-        switch(usb_dev->descriptor.idProduct) {
-        case USB_DEVICE_ID_RAZER_ABYSSUS_ELITE_DVA_EDITION:
-        case USB_DEVICE_ID_RAZER_ABYSSUS_ESSENTIAL:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            break;
-
-        case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRELESS:
-        case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRELESS_RECEIVER:
-            device_remove_file(&hdev->dev, &dev_attr_charge_effect);
-            device_remove_file(&hdev->dev, &dev_attr_charge_colour);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRED:
-        case USB_DEVICE_ID_RAZER_LANCEHEAD_WIRELESS_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_LANCEHEAD_TE_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_left_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_right_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_BASILISK_ULTIMATE_RECEIVER:
-            device_remove_file(&hdev->dev, &dev_attr_charge_effect);
-            device_remove_file(&hdev->dev, &dev_attr_charge_colour);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_BASILISK_ULTIMATE_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_hwheel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat);
-            device_remove_file(&hdev->dev, &dev_attr_left_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_right_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_BASILISK_V2:
-            device_remove_file(&hdev->dev, &dev_attr_tilt_hwheel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_DEATHADDER_ELITE:
-        case USB_DEVICE_ID_RAZER_BASILISK:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V2:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_BASILISK_V3:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_mode);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_acceleration);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_smart_reel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_hwheel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat);
-
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_BASILISK_V3_PRO_WIRED:
-        case USB_DEVICE_ID_RAZER_BASILISK_V3_PRO_WIRELESS:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_mode);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_acceleration);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_smart_reel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_hwheel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat);
-
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            break;
-
-        case USB_DEVICE_ID_RAZER_BASILISK_ESSENTIAL:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V2_MINI:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_HEX_V2:
-        case USB_DEVICE_ID_RAZER_NAGA_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_MAMBA_2012_WIRELESS:
-        case USB_DEVICE_ID_RAZER_MAMBA_2012_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_rgb);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_effect);
-            break;
-
-        case USB_DEVICE_ID_RAZER_MAMBA_WIRELESS:
-            device_remove_file(&hdev->dev, &dev_attr_charge_effect);
-            device_remove_file(&hdev->dev, &dev_attr_charge_colour);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_MAMBA_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-            break;
-
-        case USB_DEVICE_ID_RAZER_MAMBA_TE_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-            break;
-
-        case USB_DEVICE_ID_RAZER_OROCHI_2011:
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            break;
-
-        case USB_DEVICE_ID_RAZER_ABYSSUS:
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            break;
-
-        case USB_DEVICE_ID_RAZER_IMPERATOR:
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            break;
-
-        case USB_DEVICE_ID_RAZER_OUROBOROS:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            break;
-
-        case USB_DEVICE_ID_RAZER_OROCHI_2013:
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            break;
-
-        case USB_DEVICE_ID_RAZER_OROCHI_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_HEX:
-        case USB_DEVICE_ID_RAZER_NAGA_HEX_RED:
-        case USB_DEVICE_ID_RAZER_TAIPAN:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_2014:
-            device_remove_file(&hdev->dev, &dev_attr_tilt_hwheel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_NAGA_2012:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_backlight_led_state);
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHADDER_3_5G:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_EPIC_CHROMA:
-        case USB_DEVICE_ID_RAZER_NAGA_EPIC_CHROMA_DOCK:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_rgb);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_effect);
-            device_remove_file(&hdev->dev, &dev_attr_backlight_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_backlight_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_backlight_led_rgb);
-            device_remove_file(&hdev->dev, &dev_attr_backlight_led_effect);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHADDER_3_5G_BLACK:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            break;
-
-        case USB_DEVICE_ID_RAZER_ABYSSUS_V2:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_3500:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_rgb);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_effect);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_rgb);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_effect);
-            break;
-
-        case USB_DEVICE_ID_RAZER_DIAMONDBACK_CHROMA:
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-            break;
-
-        case USB_DEVICE_ID_RAZER_ABYSSUS_1800:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_1800:
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            break;
-
-        case USB_DEVICE_ID_RAZER_ABYSSUS_2000:
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_state);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_X:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_left_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_LEFT_HANDED_2020:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_right_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_PRO_WIRELESS:
-            device_remove_file(&hdev->dev, &dev_attr_charge_effect);
-            device_remove_file(&hdev->dev, &dev_attr_charge_colour);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_NAGA_PRO_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_MAMBA_ELITE:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_left_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_left_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_right_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_wave);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_right_matrix_effect_none);
-
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-
-            device_remove_file(&hdev->dev, &dev_attr_tilt_hwheel);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat_delay);
-            device_remove_file(&hdev->dev, &dev_attr_tilt_repeat);
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHADDER_ESSENTIAL:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_ESSENTIAL_WHITE_EDITION:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHADDER_ESSENTIAL_2021:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            break;
-
-        case USB_DEVICE_ID_RAZER_NAGA_TRINITY:
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_static);
-            break;
-
-        case USB_DEVICE_ID_RAZER_MAMBA_WIRELESS_RECEIVER:
-            device_remove_file(&hdev->dev, &dev_attr_charge_effect);
-            device_remove_file(&hdev->dev, &dev_attr_charge_colour);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_MAMBA_WIRELESS_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_scroll_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_VIPER_ULTIMATE_WIRELESS:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V2_PRO_WIRELESS:
-            device_remove_file(&hdev->dev, &dev_attr_charge_effect);
-            device_remove_file(&hdev->dev, &dev_attr_charge_colour);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_VIPER_ULTIMATE_WIRED:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V2_PRO_WIRED:
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            fallthrough;
-        case USB_DEVICE_ID_RAZER_VIPER:
-        case USB_DEVICE_ID_RAZER_VIPER_MINI:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-
-        case USB_DEVICE_ID_RAZER_ATHERIS_RECEIVER:
-        case USB_DEVICE_ID_RAZER_BASILISK_X_HYPERSPEED:
-        case USB_DEVICE_ID_RAZER_OROCHI_V2_RECEIVER:
-        case USB_DEVICE_ID_RAZER_OROCHI_V2_BLUETOOTH:
-        case USB_DEVICE_ID_RAZER_PRO_CLICK_RECEIVER:
-        case USB_DEVICE_ID_RAZER_PRO_CLICK_WIRED:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V2_X_HYPERSPEED:
-        case USB_DEVICE_ID_RAZER_VIPER_V2_PRO_WIRED:
-        case USB_DEVICE_ID_RAZER_VIPER_V2_PRO_WIRELESS:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V3_PRO_WIRED:
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V3_PRO_WIRELESS:
-        case USB_DEVICE_ID_RAZER_PRO_CLICK_MINI_RECEIVER:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            break;
-
-        case USB_DEVICE_ID_RAZER_HYPERPOLLING_WIRELESS_DONGLE:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_charge_level);
-            device_remove_file(&hdev->dev, &dev_attr_charge_status);
-            device_remove_file(&hdev->dev, &dev_attr_charge_low_threshold);
-            device_remove_file(&hdev->dev, &dev_attr_device_idle_time);
-            device_remove_file(&hdev->dev, &dev_attr_hyperpolling_wireless_dongle_indicator_led_mode);
-            device_remove_file(&hdev->dev, &dev_attr_hyperpolling_wireless_dongle_pair);
-            device_remove_file(&hdev->dev, &dev_attr_hyperpolling_wireless_dongle_unpair);
-            break;
-
-        case USB_DEVICE_ID_RAZER_VIPER_8K:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            break;
-
-        case USB_DEVICE_ID_RAZER_DEATHADDER_V2_LITE:
-            device_remove_file(&hdev->dev, &dev_attr_poll_rate);
-            device_remove_file(&hdev->dev, &dev_attr_dpi);
-            device_remove_file(&hdev->dev, &dev_attr_dpi_stages);
-            device_remove_file(&hdev->dev, &dev_attr_logo_led_brightness);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_spectrum);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_reactive);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_breath);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_static);
-            device_remove_file(&hdev->dev, &dev_attr_logo_matrix_effect_none);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_effect_custom);
-            device_remove_file(&hdev->dev, &dev_attr_matrix_custom_frame);
-            break;
-        }
-
-    }
-
-
     hid_hw_stop(hdev);
     hrtimer_cancel(&dev->repeat_timer);
 
@@ -6721,6 +6216,23 @@ static void razer_mouse_disconnect(struct hid_device *hdev)
     dev_info(&intf->dev, "Razer Device disconnected\n");
 }
 
+#ifdef CONFIG_PM
+/**
+ * Forget the cached settings, the device may have lost them over suspend
+ */
+static int razer_mouse_resume(struct hid_device *hdev)
+{
+    struct razer_mouse_device *dev = hid_get_drvdata(hdev);
+
+    mutex_lock(&dev->lock);
+    memset(dev->cached, 0, sizeof(dev->cached));
+    WRITE_ONCE(dev->settings_cached, false);
+    mutex_unlock(&dev->lock);
+
+    return 0;
+}
+#endif
+
 
 /**
  * Device ID mapping table
@@ -6825,6 +6337,14 @@ static struct hid_driver razer_mouse_driver = {
     .raw_event = razer_raw_event,
     .input_mapping = razer_input_mapping,
     .input_configured = razer_input_configured,
+#ifdef CONFIG_PM
+    .resume = razer_mouse_resume,
+    .reset_resume = razer_mouse_resume,
+#endif
+    .driver = {
+        .dev_groups = razer_mouse_groups,
+        .probe_type = PROBE_PREFER_ASYNCHRONOUS,
+    },
 };
 
 module_hid_driver(razer_mouse_driver);
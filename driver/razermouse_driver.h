@@ -6,6 +6,10 @@
 #ifndef __HID_RAZER_MOUSE_H
 #define __HID_RAZER_MOUSE_H
 
+#include <linux/bitmap.h>
+
+#include "razercommon.h"
+
 #define USB_DEVICE_ID_RAZER_OROCHI_2011 0x0013
 #define USB_DEVICE_ID_RAZER_DEATHADDER_3_5G 0x0016
 #define USB_DEVICE_ID_RAZER_ABYSSUS_1800 0x0020
@@ -109,6 +113,85 @@
 
 #define RAZER_MOUSE_MAX_DPI_STAGES 5
 
+/*
+ * One bit per sysfs attribute, set in probe for the attributes the device supports
+ */
+enum razer_mouse_cap {
+    RAZER_MOUSE_CAP_VERSION,
+    RAZER_MOUSE_CAP_TEST,
+    RAZER_MOUSE_CAP_FIRMWARE_VERSION,
+    RAZER_MOUSE_CAP_DEVICE_TYPE,
+    RAZER_MOUSE_CAP_DEVICE_SERIAL,
+    RAZER_MOUSE_CAP_DEVICE_MODE,
+    RAZER_MOUSE_CAP_CAPABILITIES,
+    RAZER_MOUSE_CAP_POLL_RATE,
+    RAZER_MOUSE_CAP_DPI,
+    RAZER_MOUSE_CAP_LOGO_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_SPECTRUM,
+    RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_REACTIVE,
+    RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_BREATH,
+    RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_STATIC,
+    RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_NONE,
+    RAZER_MOUSE_CAP_CHARGE_EFFECT,
+    RAZER_MOUSE_CAP_CHARGE_COLOUR,
+    RAZER_MOUSE_CAP_CHARGE_LEVEL,
+    RAZER_MOUSE_CAP_CHARGE_STATUS,
+    RAZER_MOUSE_CAP_CHARGE_LOW_THRESHOLD,
+    RAZER_MOUSE_CAP_DEVICE_IDLE_TIME,
+    RAZER_MOUSE_CAP_DPI_STAGES,
+    RAZER_MOUSE_CAP_LOGO_MATRIX_EFFECT_WAVE,
+    RAZER_MOUSE_CAP_SCROLL_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_WAVE,
+    RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_SPECTRUM,
+    RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_REACTIVE,
+    RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_BREATH,
+    RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_STATIC,
+    RAZER_MOUSE_CAP_SCROLL_MATRIX_EFFECT_NONE,
+    RAZER_MOUSE_CAP_LEFT_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_WAVE,
+    RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_SPECTRUM,
+    RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_REACTIVE,
+    RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_BREATH,
+    RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_STATIC,
+    RAZER_MOUSE_CAP_LEFT_MATRIX_EFFECT_NONE,
+    RAZER_MOUSE_CAP_RIGHT_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_WAVE,
+    RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_SPECTRUM,
+    RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_REACTIVE,
+    RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_BREATH,
+    RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_STATIC,
+    RAZER_MOUSE_CAP_RIGHT_MATRIX_EFFECT_NONE,
+    RAZER_MOUSE_CAP_MATRIX_EFFECT_CUSTOM,
+    RAZER_MOUSE_CAP_MATRIX_CUSTOM_FRAME,
+    RAZER_MOUSE_CAP_TILT_HWHEEL,
+    RAZER_MOUSE_CAP_TILT_REPEAT_DELAY,
+    RAZER_MOUSE_CAP_TILT_REPEAT,
+    RAZER_MOUSE_CAP_SCROLL_MODE,
+    RAZER_MOUSE_CAP_SCROLL_ACCELERATION,
+    RAZER_MOUSE_CAP_SCROLL_SMART_REEL,
+    RAZER_MOUSE_CAP_MATRIX_BRIGHTNESS,
+    RAZER_MOUSE_CAP_MATRIX_EFFECT_WAVE,
+    RAZER_MOUSE_CAP_MATRIX_EFFECT_SPECTRUM,
+    RAZER_MOUSE_CAP_MATRIX_EFFECT_STATIC,
+    RAZER_MOUSE_CAP_MATRIX_EFFECT_NONE,
+    RAZER_MOUSE_CAP_MATRIX_EFFECT_REACTIVE,
+    RAZER_MOUSE_CAP_MATRIX_EFFECT_BREATH,
+    RAZER_MOUSE_CAP_SCROLL_LED_STATE,
+    RAZER_MOUSE_CAP_SCROLL_LED_RGB,
+    RAZER_MOUSE_CAP_SCROLL_LED_EFFECT,
+    RAZER_MOUSE_CAP_LOGO_LED_STATE,
+    RAZER_MOUSE_CAP_LOGO_LED_RGB,
+    RAZER_MOUSE_CAP_LOGO_LED_EFFECT,
+    RAZER_MOUSE_CAP_BACKLIGHT_LED_STATE,
+    RAZER_MOUSE_CAP_BACKLIGHT_LED_BRIGHTNESS,
+    RAZER_MOUSE_CAP_BACKLIGHT_LED_RGB,
+    RAZER_MOUSE_CAP_BACKLIGHT_LED_EFFECT,
+    RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_INDICATOR_LED_MODE,
+    RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_PAIR,
+    RAZER_MOUSE_CAP_HYPERPOLLING_WIRELESS_DONGLE_UNPAIR,
+    RAZER_MOUSE_CAP_COUNT
+};
+
 struct razer_mouse_device {
     struct usb_device *usb_dev;
     struct mutex lock;
@@ -143,6 +226,11 @@ struct razer_mouse_device {
         unsigned char profile;
         unsigned char leds;
     } da3_5g;
+
+    DECLARE_BITMAP(caps, RAZER_MOUSE_CAP_COUNT);
+    struct razer_cached_value cached[RAZER_MOUSE_CAP_COUNT];
+    // Whether cached was read from the device since probe or resume
+    bool settings_cached;
 };
 
 // Mamba Key Location
@@ -1,8 +1,10 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 
+import contextlib as _contextlib
 import json
 import dbus as _dbus
 from openrazer.client.device import RazerDeviceFactory as _RazerDeviceFactory
+from openrazer.client import batch as _batch
 from openrazer.client import constants
 
 __version__ = '3.6.1'
@@ -19,9 +21,9 @@ class DeviceManager(object):
 
     def __init__(self):
         # Load up the DBus
-        session_bus = _dbus.SessionBus()
+        self._session_bus = _dbus.SessionBus()
         try:
-            self._dbus = session_bus.get_object("org.razer", "/org/razer")
+            self._dbus = self._session_bus.get_object("org.razer", "/org/razer")
         except _dbus.DBusException:
             raise DaemonNotFound("Could not connect to daemon")
 
@@ -31,14 +33,32 @@ class DeviceManager(object):
         # Get interface for devices methods
         self._dbus_devices = _dbus.Interface(self._dbus, "razer.devices")
 
-        self._device_serials = self._dbus_devices.getDevices()
-        self._devices = []
+        # Everything the devices are built from comes in this one call
+        try:
+            self._descriptors = self._dbus_devices.getDeviceDescriptors()
+        except _dbus.DBusException:
+            # Older daemons, the devices are asked one by one
+            self._descriptors = {serial: {} for serial in self._dbus_devices.getDevices()}
+
+        self._device_serials = list(self._descriptors.keys())
+        self._devices = None
+
+        self._daemon_version = None
+
+    def _make_device(self, serial):
+        """
+        Build a device from its descriptor
+
+        :param serial: Device serial
+        :type serial: str
 
-        self._daemon_version = self._dbus_daemon.version()
+        :return: Device
+        :rtype: razer.client.devices.RazerDevice
+        """
+        # The proxy connects on the device's first call, and lets calls be batched
+        device_dbus = _batch.BatchProxy(self._session_bus, "/org/razer/device/{0}".format(serial), serial)
 
-        for serial in self._device_serials:
-            device = _RazerDeviceFactory.get_device(serial)
-            self._devices.append(device)
+        return _RazerDeviceFactory.get_device(serial, daemon_dbus=device_dbus, descriptor=self._descriptors[serial] or None)
 
     def stop_daemon(self):
         """
@@ -46,6 +66,42 @@ class DeviceManager(object):
         """
         self._dbus_daemon.stop()
 
+    @_contextlib.contextmanager
+    def batch(self):
+        """
+        Send the calls made to devices inside the block to the daemon in one go
+
+        The daemon runs the calls to each device in order, and different devices at the same time.
+        Only setters are batched. They return None inside the block as they haven't happened yet,
+        so it's meant for setting things, like applying a scene. Getters are sent straight away
+        and see the values from before the block. The results are in the batch once the block ends.
+
+        Batches don't nest, a batch inside another adds to the outer one. If the block raises
+        nothing is sent.
+
+        >>> with device_manager.batch():
+        ...     for device in device_manager.devices:
+        ...         device.fx.static(255, 0, 0)
+
+        :return: Batch
+        :rtype: openrazer.client.batch.Batch
+
+        :raises openrazer.client.batch.BatchError: If any of the calls failed
+        """
+        outer = _batch.current_batch()
+        if outer is not None:
+            yield outer
+            return
+
+        batch = _batch.Batch(self._dbus_devices)
+        _batch.open_batch(batch)
+        try:
+            yield batch
+        finally:
+            _batch.close_batch()
+
+        batch.send()
+
     @property
     def turn_off_on_screensaver(self):
         return self._dbus_devices.getOffOnScreensaver()
@@ -102,6 +158,8 @@ class DeviceManager(object):
         :return: List of devices
         :rtype: list[razer.client.devices.RazerDevice]
         """
+        if self._devices is None:
+            self._devices = [self._make_device(serial) for serial in self._device_serials]
 
         return self._devices
 
@@ -123,6 +181,9 @@ class DeviceManager(object):
         :return: Daemon version
         :rtype: str
         """
+        if self._daemon_version is None:
+            self._daemon_version = self._dbus_daemon.version()
+
         return str(self._daemon_version)
 
 
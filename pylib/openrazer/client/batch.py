@@ -0,0 +1,177 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Sending calls to several devices as one message
+
+Devices made by DeviceManager talk to the daemon through a BatchProxy. While a batch is open on
+the calling thread, calls to the setters of razer.* interfaces are recorded instead of being
+sent, and when the batch closes they go to the daemon's applyBatch together. Everything else,
+like the getters the client uses to check a value before setting it, is sent straight away.
+"""
+import threading as _threading
+
+_local = _threading.local()
+
+
+class BatchError(Exception):
+    """
+    Some of the operations of a batch failed
+
+    :ivar failures: (operation, error) for every operation that failed
+    :vartype failures: list of tuple
+    """
+
+    def __init__(self, failures):
+        super().__init__("{0} batch operations failed, first: {1}".format(len(failures), failures[0][1]))
+        self.failures = failures
+
+
+class Batch(object):
+    """
+    Operations recorded for the daemon
+
+    :ivar operations: (serial, interface, method, arguments) of every call recorded
+    :vartype operations: list of tuple
+
+    :ivar results: (success, error, return values) for every operation once sent, None before
+    :vartype results: list of tuple or None
+    """
+
+    def __init__(self, daemon_devices_dbus):
+        """
+        :param daemon_devices_dbus: Daemon's razer.devices interface
+        :type daemon_devices_dbus: dbus.Interface
+        """
+        self._daemon_devices_dbus = daemon_devices_dbus
+        self.operations = []
+        self.results = None
+
+    def record(self, serial, interface, method, args):
+        """
+        Add a call to the batch
+
+        :param serial: Device serial
+        :type serial: str
+
+        :param interface: DBus interface
+        :type interface: str
+
+        :param method: DBus method
+        :type method: str
+
+        :param args: Arguments
+        :type args: tuple
+        """
+        self.operations.append((serial, interface, method, list(args)))
+
+    def send(self):
+        """
+        Send the recorded calls in one go
+
+        :raises BatchError: If any operation failed, after all of them were tried
+        """
+        if not self.operations:
+            self.results = []
+            return
+
+        results = self._daemon_devices_dbus.applyBatch(self.operations)
+        self.results = [(bool(success), str(error), list(values)) for success, error, values in results]
+
+        failures = [(operation, result[1]) for operation, result in zip(self.operations, self.results) if not result[0]]
+        if failures:
+            raise BatchError(failures)
+
+
+def current_batch():
+    """
+    Batch open on the calling thread
+
+    :return: Batch or None
+    :rtype: Batch or None
+    """
+    return getattr(_local, 'batch', None)
+
+
+def open_batch(batch):
+    """
+    Start recording calls made on the calling thread into a batch
+
+    :param batch: Batch
+    :type batch: Batch
+    """
+    _local.batch = batch
+
+
+def close_batch():
+    """
+    Stop recording calls made on the calling thread
+    """
+    _local.batch = None
+
+
+class BatchProxy(object):
+    """
+    Stands in for a device's DBus proxy object and records calls while a batch is open
+
+    The proxy object is only made on the first call, so devices built from descriptors don't
+    talk to the daemon until they're used.
+    """
+
+    def __init__(self, bus, object_path, serial):
+        """
+        :param bus: Session bus
+        :type bus: dbus.Bus
+
+        :param object_path: Device's object path
+        :type object_path: str
+
+        :param serial: Device serial
+        :type serial: str
+        """
+        self._bus = bus
+        self._object_path = object_path
+        self._serial = serial
+        self._proxy_object = None
+
+    @property
+    def proxy_object(self):
+        """
+        Device's DBus object, made on first use
+
+        :return: Proxy object
+        :rtype: dbus.proxies.ProxyObject
+        """
+        if self._proxy_object is None:
+            self._proxy_object = self._bus.get_object("org.razer", self._object_path)
+
+        return self._proxy_object
+
+    def get_dbus_method(self, member, dbus_interface=None):
+        """
+        DBus method which is recorded if it's a setter and a batch is open when it's called
+
+        :param member: DBus method
+        :type member: str
+
+        :param dbus_interface: DBus interface
+        :type dbus_interface: str
+
+        :return: Method
+        :rtype: callable
+        """
+        # Only setters can wait, the caller needs what anything else returns
+        recordable = member.startswith('set') and dbus_interface is not None and dbus_interface.startswith('razer.')
+
+        # pylint: disable=missing-docstring
+        def call(*args, **kwargs):
+            batch = current_batch()
+            if batch is None or kwargs or not recordable:
+                return self.proxy_object.get_dbus_method(member, dbus_interface)(*args, **kwargs)
+
+            batch.record(self._serial, dbus_interface, member, args)
+            return None
+
+        return call
+
+    def __getattr__(self, name):
+        return getattr(self.proxy_object, name)
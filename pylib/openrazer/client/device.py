@@ -22,7 +22,7 @@ class RazerDeviceFactory(__BaseDeviceFactory):
 
     """
     @staticmethod
-    def get_device(serial, vid_pid=None, daemon_dbus=None):
+    def get_device(serial, vid_pid=None, daemon_dbus=None, descriptor=None):
         """
         Factory for turning a serial into a class
 
@@ -41,6 +41,9 @@ class RazerDeviceFactory(__BaseDeviceFactory):
         :param daemon_dbus: Daemon DBus object
         :type daemon_dbus: object or None
 
+        :param descriptor: Device descriptor from getDeviceDescriptors, the device is asked if None
+        :type descriptor: dict or None
+
         :return: RazerDevice object (or subclass)
         :rtype: RazerDevice
         """
@@ -48,22 +51,26 @@ class RazerDeviceFactory(__BaseDeviceFactory):
             session_bus = _dbus.SessionBus()
             daemon_dbus = session_bus.get_object("org.razer", "/org/razer/device/{0}".format(serial))
 
-        device_dbus = _dbus.Interface(daemon_dbus, "razer.device.misc")
+        if descriptor is not None and 'type' in descriptor and 'vid_pid' in descriptor:
+            device_type = descriptor['type']
+            device_vid_pid = descriptor['vid_pid']
+        else:
+            device_dbus = _dbus.Interface(daemon_dbus, "razer.device.misc")
 
-        device_type = device_dbus.getDeviceType()
-        device_vid_pid = device_dbus.getVidPid()
+            device_type = device_dbus.getDeviceType()
+            device_vid_pid = device_dbus.getVidPid()
 
         if device_type in DEVICE_MAP:
             # Have device mapping
             device_class = DEVICE_MAP[device_type]
             if hasattr(device_class, 'get_device'):
                 # DeviceFactory
-                device = device_class.get_device(serial, vid_pid=device_vid_pid, daemon_dbus=daemon_dbus)
+                device = device_class.get_device(serial, vid_pid=device_vid_pid, daemon_dbus=daemon_dbus, descriptor=descriptor)
             else:
                 # DeviceClass
-                device = device_class(serial, vid_pid=device_vid_pid, daemon_dbus=daemon_dbus)
+                device = device_class(serial, vid_pid=device_vid_pid, daemon_dbus=daemon_dbus, descriptor=descriptor)
         else:
             # No mapping, default to RazerDevice
-            device = DEVICE_MAP['default'](serial, vid_pid=device_vid_pid, daemon_dbus=daemon_dbus)
+            device = DEVICE_MAP['default'](serial, vid_pid=device_vid_pid, daemon_dbus=daemon_dbus, descriptor=descriptor)
 
         return device
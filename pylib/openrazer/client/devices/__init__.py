@@ -15,7 +15,7 @@ class RazerDevice(object):
     _FX = _RazerFX
     _MACRO_CLASS = _RazerMacro
 
-    def __init__(self, serial, vid_pid=None, daemon_dbus=None):
+    def __init__(self, serial, vid_pid=None, daemon_dbus=None, descriptor=None):
         # Load up the DBus
         if daemon_dbus is None:
             session_bus = _dbus.SessionBus()
@@ -23,6 +23,9 @@ class RazerDevice(object):
 
         self._dbus = daemon_dbus
 
+        # What the daemon already told us about the device, the rest is asked for
+        self._descriptor = descriptor if descriptor is not None else {}
+
         self._available_features = self._get_available_features()
 
         self._dbus_interfaces = {
@@ -30,10 +33,10 @@ class RazerDevice(object):
             'brightness': _dbus.Interface(self._dbus, "razer.device.lighting.brightness")
         }
 
-        self._name = str(self._dbus_interfaces['device'].getDeviceName())
-        self._type = str(self._dbus_interfaces['device'].getDeviceType())
-        self._fw = str(self._dbus_interfaces['device'].getFirmware())
-        self._drv_version = str(self._dbus_interfaces['device'].getDriverVersion())
+        self._name = str(self._describe('name', 'getDeviceName'))
+        self._type = str(self._describe('type', 'getDeviceType'))
+        self._fw = str(self._describe('firmware', 'getFirmware'))
+        self._drv_version = str(self._describe('driver_version', 'getDriverVersion'))
         self._has_dedicated_macro = None
         self._device_image = None
 
@@ -41,7 +44,7 @@ class RazerDevice(object):
         self._urls = None
 
         if vid_pid is None:
-            self._vid, self._pid = self._dbus_interfaces['device'].getVidPid()
+            self._vid, self._pid = self._describe('vid_pid', 'getVidPid')
         else:
             self._vid, self._pid = vid_pid
 
@@ -101,7 +104,7 @@ class RazerDevice(object):
             'lighting_pulsate': self._has_feature('razer.device.lighting.bw2013', 'setPulsate'),
 
             # Get if the device has an LED Matrix, == True as its a DBus boolean otherwise, so for consistency sake we coerce it into a native bool
-            'lighting_led_matrix': self._dbus_interfaces['device'].hasMatrix() == True,
+            'lighting_led_matrix': self._describe('has_matrix', 'hasMatrix') == True,
             'lighting_led_single': self._has_feature('razer.device.lighting.chroma', 'setKey'),
 
             # Mouse lighting attrs
@@ -201,12 +204,12 @@ class RazerDevice(object):
 
         # Nasty hack to convert dbus.Int32 into native
         if self.has('lighting_led_matrix'):
-            self._matrix_dimensions = tuple([int(dim) for dim in self._dbus_interfaces['device'].getMatrixDimensions()])
+            self._matrix_dimensions = tuple([int(dim) for dim in self._describe('matrix_dimensions', 'getMatrixDimensions')])
         else:
             self._matrix_dimensions = None
 
         if self.has('keyboard_layout'):
-            self._kbd_layout = str(self._dbus_interfaces['device'].getKeyboardLayout())
+            self._kbd_layout = str(self._describe('keyboard_layout', 'getKeyboardLayout'))
         else:
             self._kbd_layout = None
 
@@ -241,7 +244,28 @@ class RazerDevice(object):
         if self.has('scroll_mode') or self.has('scroll_acceleration') or self.has('scroll_smart_reel'):
             self._dbus_interfaces['scroll'] = _dbus.Interface(self._dbus, "razer.device.scroll")
 
+    def _describe(self, key, method_name):
+        """
+        Get a value from the device's descriptor, or from the device if it isn't in there
+
+        :param key: Descriptor key
+        :type key: str
+
+        :param method_name: razer.device.misc method that returns the value
+        :type method_name: str
+
+        :return: Value
+        :rtype: object
+        """
+        if key in self._descriptor:
+            return self._descriptor[key]
+
+        return getattr(self._dbus_interfaces['device'], method_name)()
+
     def _get_available_features(self):
+        if 'features' in self._descriptor:
+            return {str(interface): [str(method) for method in methods] for interface, methods in self._descriptor['features'].items()}
+
         introspect_interface = _dbus.Interface(self._dbus, 'org.freedesktop.DBus.Introspectable')
         xml_spec = introspect_interface.Introspect()
         root = _ET.fromstring(xml_spec)
@@ -414,14 +438,14 @@ class RazerDevice(object):
         :rtype: bool
         """
         if self._has_dedicated_macro is None:
-            self._has_dedicated_macro = self._dbus_interfaces['device'].hasDedicatedMacroKeys()
+            self._has_dedicated_macro = self._describe('dedicated_macro_keys', 'hasDedicatedMacroKeys')
 
         return self._has_dedicated_macro
 
     @property
     def device_image(self) -> str:
         if self._device_image is None:
-            self._device_image = str(self._dbus_interfaces['device'].getDeviceImage())
+            self._device_image = str(self._describe('device_image', 'getDeviceImage'))
 
         return self._device_image
 
@@ -553,5 +577,5 @@ class RazerDevice(object):
 
 class BaseDeviceFactory(object):
     @staticmethod
-    def get_device(serial: str, daemon_dbus=None) -> RazerDevice:
+    def get_device(serial: str, daemon_dbus=None, descriptor=None) -> RazerDevice:
         raise NotImplementedError()
@@ -0,0 +1,111 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Client end of the daemon's shared memory frame channel
+
+The memfd layout and the publishing protocol are described in the daemon's
+openrazer_daemon/misc/frame_channel.py.
+"""
+import fcntl as _fcntl
+import mmap as _mmap
+import os as _os
+import struct as _struct
+
+FRAME_CHANNEL_MAGIC = b'RZFB'
+FRAME_CHANNEL_VERSION = 1
+FRAME_CHANNEL_HEADER_FORMAT = '<4sHHIHH'
+
+FRONT_OFFSET = 16
+SEQUENCE_OFFSET = 20
+CONSUMED_OFFSET = 28
+
+
+class FrameChannel(object):
+    """
+    Publishes frames to the daemon through shared memory
+    """
+
+    def __init__(self, memfd: int, signal_fd: int):
+        """
+        Takes ownership of both fds
+
+        :param memfd: Frame memfd from getFrameChannel
+        :type memfd: int
+
+        :param signal_fd: Signal fd from getFrameChannel
+        :type signal_fd: int
+
+        :raises ValueError: If the daemon speaks a different version of the protocol
+        """
+        try:
+            self._mmap = _mmap.mmap(memfd, 0)
+        finally:
+            _os.close(memfd)
+
+        magic, version, header_size, frame_size, rows, cols = _struct.unpack_from(FRAME_CHANNEL_HEADER_FORMAT, self._mmap, 0)
+        if magic != FRAME_CHANNEL_MAGIC or version != FRAME_CHANNEL_VERSION:
+            self._mmap.close()
+            _os.close(signal_fd)
+            raise ValueError("Unsupported frame channel version {0}".format(version))
+
+        self._header_size = header_size
+        self.frame_size = frame_size
+        self.rows = rows
+        self.cols = cols
+
+        # Never block drawing on a full pipe, the daemon is getting woken anyway
+        self._signal_fd = signal_fd
+        flags = _fcntl.fcntl(signal_fd, _fcntl.F_GETFL)
+        _fcntl.fcntl(signal_fd, _fcntl.F_SETFL, flags | _os.O_NONBLOCK)
+
+        self._front = _struct.unpack_from('<I', self._mmap, FRONT_OFFSET)[0] & 1
+
+    @property
+    def frames_consumed(self) -> int:
+        """
+        Number of frames the daemon has picked up
+
+        :return: Frame count
+        :rtype: int
+        """
+        return _struct.unpack_from('<I', self._mmap, CONSUMED_OFFSET)[0]
+
+    def submit(self, payload: bytes):
+        """
+        Publish a frame
+
+        :param payload: Binary payload for the whole matrix, as setKeyRow takes it
+        :type payload: bytes
+
+        :raises ValueError: If the payload isn't the size of a frame
+        :raises OSError: If the daemon closed the channel
+        """
+        if len(payload) != self.frame_size:
+            raise ValueError("Frame must be {0} bytes, got {1}".format(self.frame_size, len(payload)))
+
+        back = self._front ^ 1
+        sequence_offset = SEQUENCE_OFFSET + back * 4
+        sequence = _struct.unpack_from('<I', self._mmap, sequence_offset)[0]
+
+        # Odd sequence while writing so the daemon won't take a half written frame
+        _struct.pack_into('<I', self._mmap, sequence_offset, (sequence + 1) & 0xFFFFFFFF)
+        offset = self._header_size + back * self.frame_size
+        self._mmap[offset:offset + self.frame_size] = payload
+        _struct.pack_into('<I', self._mmap, sequence_offset, (sequence + 2) & 0xFFFFFFFF)
+
+        _struct.pack_into('<I', self._mmap, FRONT_OFFSET, back)
+        self._front = back
+
+        try:
+            _os.write(self._signal_fd, b'\x01')
+        except BlockingIOError:
+            pass
+
+    def close(self):
+        """
+        Close the channel, the daemon notices and closes its end
+        """
+        if self._signal_fd is not None:
+            _os.close(self._signal_fd)
+            self._signal_fd = None
+            self._mmap.close()
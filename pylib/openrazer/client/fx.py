@@ -4,6 +4,7 @@ import numpy as _np
 import dbus as _dbus
 # from openrazer.client.constants import WAVE_LEFT, WAVE_RIGHT, REACTIVE_500MS, REACTIVE_1000MS, REACTIVE_1500MS, REACTIVE_2000MS
 from openrazer.client import constants as c
+from openrazer.client.frame_channel import FrameChannel as _FrameChannel
 
 # TODO logging.debug if value out of range v1.1
 
@@ -608,6 +609,10 @@ class RazerAdvancedFX(BaseRazerFX):
         self._matrix_dims = matrix_dims
         self._lighting_dbus = _dbus.Interface(daemon_dbus, "razer.device.lighting.chroma")
 
+        # Opened on the first draw, None when the daemon doesn't offer one
+        self._frame_channel = None
+        self._frame_channel_tried = False
+
         self.matrix = Frame(matrix_dims)
 
     @property
@@ -630,7 +635,32 @@ class RazerAdvancedFX(BaseRazerFX):
         """
         return self._matrix_dims[0]
 
+    def _open_frame_channel(self):
+        try:
+            memfd, signal_fd = self._lighting_dbus.getFrameChannel()
+            return _FrameChannel(memfd.take(), signal_fd.take())
+        except (_dbus.exceptions.DBusException, OSError, ValueError):
+            return None
+
     def _draw(self, ba):
+        if not self._frame_channel_tried:
+            self._frame_channel_tried = True
+            self._frame_channel = self._open_frame_channel()
+
+        if self._frame_channel is not None:
+            try:
+                self._frame_channel.submit(ba)
+                return
+            except ValueError:
+                # Frames don't fit the channel, a new one wouldn't either so stick to setKeyRow
+                self._frame_channel.close()
+                self._frame_channel = None
+            except OSError:
+                # Most likely the daemon restarted, try a new channel on the next draw
+                self._frame_channel.close()
+                self._frame_channel = None
+                self._frame_channel_tried = False
+
         self._lighting_dbus.setKeyRow(ba)
 
         self._lighting_dbus.setCustom()
@@ -29,6 +29,10 @@ class DeviceManagerTest(unittest.TestCase):
         cls._bw_chroma = fake_driver.FakeDevice('razerblackwidowchroma', serial=cls._bw_serial, tmp_dir=cls._tmp_dir)
         print("Created BlackWidow Chroma endpoints")
 
+        cls._da_serial = 'IO0000000000002'
+        cls._da_chroma = fake_driver.FakeDevice('razerdeathadderchroma', serial=cls._da_serial, tmp_dir=cls._tmp_dir)
+        print("Created DeathAdder Chroma endpoints")
+
         cls._daemon_proc = multiprocessing.Process(target=run_daemon, args=(cls._daemon_dir, cls._tmp_dir))
         cls._daemon_proc.start()
         print("Started daemon")
@@ -49,6 +53,7 @@ class DeviceManagerTest(unittest.TestCase):
             print("Failed to kill daemon")
 
         cls._bw_chroma.close()
+        cls._da_chroma.close()
 
         shutil.rmtree(cls._tmp_dir)
         shutil.rmtree(cls._daemon_dir)
@@ -57,34 +62,38 @@ class DeviceManagerTest(unittest.TestCase):
 
     def setUp(self):
         self._bw_chroma.create_endpoints()
+        self._da_chroma.create_endpoints()
 
         self.device_manager = openrazer.client.DeviceManager()
 
+    def _device(self, serial):
+        return next(device for device in self.device_manager.devices if device.serial == serial)
+
     def test_device_list(self):
-        self.assertEqual(len(self.device_manager.devices), 1)
+        self.assertEqual(len(self.device_manager.devices), 2)
 
     def test_serial(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         self.assertEqual(device.serial, self._bw_chroma.get('device_serial'))
 
     def test_name(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         self.assertEqual(device.name, self._bw_chroma.get('device_type'))
 
     def test_type(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         self.assertEqual(device.type, 'keyboard')
 
     def test_fw_version(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         self.assertEqual(device.firmware_version, self._bw_chroma.get('firmware_version'))
 
     def test_brightness(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         # Test 100%
         device.brightness = 100.0
@@ -105,13 +114,19 @@ class DeviceManagerTest(unittest.TestCase):
 
         self.assertEqual(0, device.brightness)
 
+    def test_device_descriptors(self):
+        descriptor = self.device_manager._dbus_devices.getDeviceDescriptors()[self._bw_serial]
+
+        self.assertEqual(descriptor['firmware'], self._bw_chroma.get('firmware_version'))
+        self.assertIn('setStatic', descriptor['features']['razer.device.lighting.chroma'])
+
     def test_capabilities(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         self.assertEqual(device.capabilities, device._capabilities)
 
     def test_device_keyboard_game_mode(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         self._bw_chroma.set('mode_game', '1')
         self.assertTrue(device.game_mode_led)
@@ -121,7 +136,7 @@ class DeviceManagerTest(unittest.TestCase):
         self.assertEqual(self._bw_chroma.get('mode_game'), '1')
 
     def test_device_keyboard_macro_mode(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         self._bw_chroma.set('mode_macro', '1')
         self.assertTrue(device.macro_mode_led)
@@ -136,21 +151,21 @@ class DeviceManagerTest(unittest.TestCase):
         self.assertEqual(self._bw_chroma.get('mode_macro'), str(openrazer.client.constants.MACRO_LED_BLINK))
 
     def test_device_keyboard_effect_none(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.none()
 
         self.assertEqual(self._bw_chroma.get('matrix_effect_none'), '1')
 
     def test_device_keyboard_effect_spectrum(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.spectrum()
 
         self.assertEqual(self._bw_chroma.get('matrix_effect_spectrum'), '1')
 
     def test_device_keyboard_effect_wave(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.wave(openrazer.client.constants.WAVE_LEFT)
         self.assertEqual(self._bw_chroma.get('matrix_effect_wave'), str(openrazer.client.constants.WAVE_LEFT))
@@ -161,7 +176,7 @@ class DeviceManagerTest(unittest.TestCase):
             device.fx.wave('lalala')
 
     def test_device_keyboard_effect_static(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.static(255, 0, 255)
         self.assertEqual(b'\xFF\x00\xFF', self._bw_chroma.get('matrix_effect_static', binary=True))
@@ -173,8 +188,35 @@ class DeviceManagerTest(unittest.TestCase):
         device.fx.static(256, 0, 700)
         self.assertEqual(b'\xFF\x00\xFF', self._bw_chroma.get('matrix_effect_static', binary=True))
 
+    def test_device_keyboard_batch(self):
+        device = self._device(self._bw_serial)
+
+        with self.device_manager.batch() as batch:
+            device.fx.static(0, 255, 0)
+            device.brightness = 50.0
+
+            # Nothing is sent until the block ends
+            self.assertEqual(len(batch.operations), 2)
+
+        self.assertEqual(b'\x00\xFF\x00', self._bw_chroma.get('matrix_effect_static', binary=True))
+        self.assertEqual('127', self._bw_chroma.get('matrix_brightness'))
+        self.assertTrue(all(success for success, _, _ in batch.results))
+
+    def test_device_mouse_batch_dpi(self):
+        device = self._device(self._da_serial)
+
+        with self.device_manager.batch() as batch:
+            # The setter checks the value against max_dpi, which has to reach the daemon
+            device.dpi = (1800, 1800)
+
+            self.assertEqual(len(batch.operations), 1)
+            self.assertEqual('800:800', self._da_chroma.get('dpi'))
+
+        self.assertEqual('1800:1800', self._da_chroma.get('dpi'))
+        self.assertTrue(all(success for success, _, _ in batch.results))
+
     def test_device_keyboard_effect_reactive(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         time = openrazer.client.constants.REACTIVE_500MS
         device.fx.reactive(255, 0, 255, time)
@@ -191,7 +233,7 @@ class DeviceManagerTest(unittest.TestCase):
             device.fx.reactive(255, 0, 255, 'lalala')
 
     def test_device_keyboard_effect_breath_single(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.breath_single(255, 0, 255)
         self.assertEqual(b'\xFF\x00\xFF', self._bw_chroma.get('matrix_effect_breath', binary=True))
@@ -204,7 +246,7 @@ class DeviceManagerTest(unittest.TestCase):
         self.assertEqual(b'\xFF\x00\xFF', self._bw_chroma.get('matrix_effect_breath', binary=True))
 
     def test_device_keyboard_effect_breath_dual(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.breath_dual(255, 0, 255, 255, 0, 0)
         self.assertEqual(b'\xFF\x00\xFF\xFF\x00\x00', self._bw_chroma.get('matrix_effect_breath', binary=True))
@@ -218,14 +260,14 @@ class DeviceManagerTest(unittest.TestCase):
         self.assertEqual(b'\xFF\x00\xFF\xFF\x00\x00', self._bw_chroma.get('matrix_effect_breath', binary=True))
 
     def test_device_keyboard_effect_breath_random(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.breath_random()
 
         self.assertEqual(self._bw_chroma.get('matrix_effect_breath'), '1')
 
     def test_device_keyboard_effect_ripple(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         refresh_rate = 0.01
         device.fx.ripple(255, 0, 255, refresh_rate)
@@ -245,7 +287,7 @@ class DeviceManagerTest(unittest.TestCase):
         device.fx.none()
 
     def test_device_keyboard_effect_random_ripple(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         refresh_rate = 0.01
         device.fx.ripple_random(refresh_rate)
@@ -261,7 +303,7 @@ class DeviceManagerTest(unittest.TestCase):
         device.fx.none()
 
     def test_device_keyboard_effect_framebuffer(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.fx.advanced.matrix.set(0, 0, (255, 0, 255))
 
@@ -290,14 +332,14 @@ class DeviceManagerTest(unittest.TestCase):
         self.assertEqual(binary, custom_effect_payload)
 
     def test_device_keyboard_macro_enable(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         device.macro.enable_macros()
 
         self.assertEqual(self._bw_chroma.get('macro_keys'), '1')
 
     def test_device_keyboard_macro_add(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         url_macro = device.macro.create_url_macro_item('http://example.org')
         device.macro.add_macro('M1', [url_macro])
@@ -315,7 +357,7 @@ class DeviceManagerTest(unittest.TestCase):
             device.macro.add_macro('M1', ['lalala'])  # Bad element in sequence
 
     def test_device_keyboard_macro_del(self):
-        device = self.device_manager.devices[0]
+        device = self._device(self._bw_serial)
 
         url_macro = device.macro.create_url_macro_item('http://example.org')
         device.macro.add_macro('M2', [url_macro])
@@ -0,0 +1,612 @@
+#!/usr/bin/python3
+"""
+This script measures how long Razer devices take to answer commands.
+
+It reads USB captures, either a pcap/pcapng file recorded with wireshark/tcpdump on a usbmon
+interface or the usbmon text interface (/sys/kernel/debug/usb/usbmon/<bus>u, needs debugfs and
+the usbmon module), and pairs every SET_REPORT with the GET_REPORT answering it by looking at the
+transaction id, command class and command id.
+
+It prints per device, per command latency histograms, how often the device answered BUSY and how
+often the driver had to repeat a command, and an estimate of the frame rate that can be reached
+with custom frames given the measured latencies.
+
+Examples:
+  latency_analyzer.py capture.pcapng
+  latency_analyzer.py --live 3 --duration 10
+  cat /sys/kernel/debug/usb/usbmon/3u > trace.txt; latency_analyzer.py trace.txt
+"""
+import argparse
+import collections
+import math
+import os
+import select
+import statistics
+import struct
+import sys
+import time
+
+HID_REQ_GET_REPORT = 0x01
+HID_REQ_SET_REPORT = 0x09
+
+RAZER_USB_REPORT_LEN = 90
+
+STATUS_NAMES = {
+    0x00: 'NEW',
+    0x01: 'BUSY',
+    0x02: 'SUCCESS',
+    0x03: 'FAILURE',
+    0x04: 'TIMEOUT',
+    0x05: 'NOT_SUPPORTED',
+}
+
+# (class, command) of the commands that make up a custom frame, see razerchromacommon.c
+CUSTOM_FRAME_ROWS = {(0x03, 0x0B), (0x0F, 0x03)}
+CUSTOM_FRAME_COMMITS = {(0x03, 0x0A), (0x0F, 0x02)}
+
+# Seconds to wait before reading again when a non-blocking read has nothing to give
+READ_RETRY_INTERVAL = 0.05
+
+# Histogram bucket upper bounds in microseconds
+BUCKETS = (250, 500, 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000, 256000, math.inf)
+
+PCAP_MAGIC = {
+    b'\xd4\xc3\xb2\xa1': ('<', 1e-6),
+    b'\xa1\xb2\xc3\xd4': ('>', 1e-6),
+    b'\x4d\x3c\xb2\xa1': ('<', 1e-9),
+    b'\xa1\xb2\x3c\x4d': ('>', 1e-9),
+}
+PCAPNG_MAGIC = b'\x0a\x0d\x0d\x0a'
+
+LINKTYPE_USB_LINUX = 189
+LINKTYPE_USB_LINUX_MMAPPED = 220
+
+# struct usbmon_packet from Documentation/usb/usbmon.rst, always in host byte order
+USBMON_HEADER = struct.Struct('<QcBBBHccqiiII8s')
+USBMON_HEADER_LEN = {
+    LINKTYPE_USB_LINUX: 48,
+    LINKTYPE_USB_LINUX_MMAPPED: 64,
+}
+
+UsbEvent = collections.namedtuple('UsbEvent', ('urb', 'timestamp', 'event', 'device', 'is_in', 'setup', 'data'))
+
+
+class Transaction(object):
+    """
+    A SET_REPORT and the GET_REPORT(s) polling for its answer
+    """
+    def __init__(self, device, timestamp, report):
+        self.device = device
+        self.start = timestamp
+        self.end = None
+        self.report = report
+        self.status = None
+        self.busy_count = 0
+
+    @property
+    def command(self):
+        """
+        Command class and id
+
+        :return: Tuple of class, id
+        :rtype: tuple
+        """
+        return self.report[6], self.report[7]
+
+    @property
+    def transaction_id(self):
+        """
+        Transaction id, used to tell the answers apart
+
+        :rtype: int
+        """
+        return self.report[1]
+
+    @property
+    def latency(self):
+        """
+        Time from submitting the SET_REPORT to the completion of the answer in seconds
+
+        :rtype: float or None
+        """
+        if self.end is None:
+            return None
+        return self.end - self.start
+
+
+def read_pcap(file_obj):
+    """
+    Reads packets from a classic pcap file
+
+    :param file_obj: Binary file
+    :type file_obj: file
+
+    :return: Generator of (timestamp, linktype, packet)
+    :rtype: generator
+    """
+    header = file_obj.read(24)
+    endian, resolution = PCAP_MAGIC[header[:4]]
+    linktype = struct.unpack(endian + 'I', header[20:24])[0]
+
+    record = struct.Struct(endian + 'IIII')
+    while True:
+        record_header = file_obj.read(record.size)
+        if len(record_header) < record.size:
+            break
+        ts_sec, ts_frac, cap_len, _ = record.unpack(record_header)
+        yield ts_sec + ts_frac * resolution, linktype, file_obj.read(cap_len)
+
+
+def read_pcapng(file_obj):
+    """
+    Reads packets from a pcapng file
+
+    Only Enhanced Packet Blocks are used, timestamps assume the default microsecond resolution
+    unless the interface says otherwise.
+
+    :param file_obj: Binary file
+    :type file_obj: file
+
+    :return: Generator of (timestamp, linktype, packet)
+    :rtype: generator
+    """
+    endian = '<'
+    interfaces = []
+
+    while True:
+        block_header = file_obj.read(8)
+        if len(block_header) < 8:
+            break
+
+        if block_header[:4] == PCAPNG_MAGIC:
+            # Section header, byte order magic follows the block length
+            endian = '<' if file_obj.read(4) == b'\x4d\x3c\x2b\x1a' else '>'
+            block_len = struct.unpack(endian + 'I', block_header[4:8])[0]
+            file_obj.read(block_len - 12)
+            interfaces = []
+            continue
+
+        block_type, block_len = struct.unpack(endian + 'II', block_header)
+        body = file_obj.read(block_len - 8)
+
+        if block_type == 0x01:  # Interface Description Block
+            linktype = struct.unpack(endian + 'H', body[0:2])[0]
+            resolution = 1e-6
+            # Look for if_tsresol in the options
+            offset = 8
+            while offset + 4 <= len(body) - 4:
+                opt_code, opt_len = struct.unpack(endian + 'HH', body[offset:offset + 4])
+                if opt_code == 0:
+                    break
+                if opt_code == 9 and opt_len == 1:
+                    tsresol = body[offset + 4]
+                    resolution = 2 ** -(tsresol & 0x7F) if tsresol & 0x80 else 10 ** -tsresol
+                offset += 4 + ((opt_len + 3) & ~3)
+            interfaces.append((linktype, resolution))
+
+        elif block_type == 0x06:  # Enhanced Packet Block
+            interface_id, ts_high, ts_low, cap_len = struct.unpack(endian + 'IIII', body[0:16])
+            linktype, resolution = interfaces[interface_id]
+            yield ((ts_high << 32) | ts_low) * resolution, linktype, body[20:20 + cap_len]
+
+
+def parse_usbmon_packet(timestamp, linktype, packet):
+    """
+    Converts a usbmon pcap packet to an event
+
+    :param timestamp: Capture timestamp in seconds
+    :type timestamp: float
+
+    :param linktype: pcap link type
+    :type linktype: int
+
+    :param packet: Packet data including the usbmon header
+    :type packet: bytes
+
+    :return: Event or None if it's not a control transfer
+    :rtype: UsbEvent or None
+    """
+    header_len = USBMON_HEADER_LEN.get(linktype)
+    if header_len is None or len(packet) < header_len:
+        return None
+
+    urb, event, xfer_type, epnum, devnum, busnum, flag_setup, _, _, _, _, _, _, setup = USBMON_HEADER.unpack(packet[:USBMON_HEADER.size])
+    if xfer_type != 2:  # Control
+        return None
+
+    return UsbEvent(urb, timestamp, event.decode(), (busnum, devnum), bool(epnum & 0x80),
+                    setup if flag_setup == b'\x00' else None, packet[header_len:])
+
+
+def parse_usbmon_text_line(line):
+    """
+    Converts a line of the usbmon text interface to an event
+
+    The text interface only captures the first 32 bytes of data which is enough for the header
+    and the first arguments of a report.
+
+    :param line: Line from /sys/kernel/debug/usb/usbmon/<bus>u
+    :type line: str
+
+    :return: Event or None if it's not a control transfer
+    :rtype: UsbEvent or None
+    """
+    words = line.split()
+    if len(words) < 4:
+        return None
+
+    try:
+        urb = int(words[0], 16)
+        timestamp = int(words[1]) / 1e6
+        event = words[2]
+        address = words[3].split(':')
+        bus, dev = int(address[1]), int(address[2])
+    except (ValueError, IndexError):
+        return None
+
+    if address[0][0] != 'C':  # Control
+        return None
+
+    setup = None
+    rest = words[4:]
+    if rest and rest[0] == 's':
+        setup = bytes.fromhex(''.join(rest[1:3])) + \
+            bytes(reversed(bytes.fromhex(rest[3]))) + bytes(reversed(bytes.fromhex(rest[4]))) + bytes(reversed(bytes.fromhex(rest[5])))
+        rest = rest[6:]
+
+    data = b''
+    if '=' in rest:
+        data = bytes.fromhex(''.join(rest[rest.index('=') + 1:]))
+
+    return UsbEvent(urb, timestamp, event, (bus, dev), address[0][1] == 'i', setup, data)
+
+
+def read_usbmon_text(file_obj, duration=None):
+    """
+    Reads events from the usbmon text interface
+
+    With a duration the file is read without blocking, so the capture stops on time even when
+    the bus is idle and no more lines arrive. The usbmon text files don't implement poll, select
+    always reports them readable and a read returns EAGAIN when there's nothing to read.
+
+    :param file_obj: Text file
+    :type file_obj: file
+
+    :param duration: Stop after this many seconds, None to read until EOF
+    :type duration: float or None
+
+    :return: Generator of events
+    :rtype: generator
+    """
+    if duration is None:
+        for line in file_obj:
+            event = parse_usbmon_text_line(line)
+            if event is not None:
+                yield event
+        return
+
+    deadline = time.monotonic() + duration
+    fd = file_obj.fileno()
+    os.set_blocking(fd, False)
+    pending = b''
+
+    while True:
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            break
+
+        readable, _, _ = select.select([fd], [], [], remaining)
+        if not readable:
+            break
+
+        try:
+            data = os.read(fd, 65536)
+        except BlockingIOError:
+            time.sleep(min(remaining, READ_RETRY_INTERVAL))
+            continue
+
+        # At EOF the last line might not end with a newline, a line cut off by the deadline is dropped
+        *lines, pending = (pending + data).split(b'\n') if data else (pending, b'')
+        for line in lines:
+            event = parse_usbmon_text_line(line.decode(errors='replace'))
+            if event is not None:
+                yield event
+
+        if not data:
+            break
+
+
+def read_capture_file(path):
+    """
+    Reads events from a pcap, pcapng or usbmon text file
+
+    :param path: File path
+    :type path: str
+
+    :return: Generator of events
+    :rtype: generator
+    """
+    with open(path, 'rb') as file_obj:
+        magic = file_obj.read(4)
+        file_obj.seek(0)
+
+        if magic == PCAPNG_MAGIC:
+            packets = read_pcapng(file_obj)
+        elif magic in PCAP_MAGIC:
+            packets = read_pcap(file_obj)
+        else:
+            packets = None
+
+        if packets is not None:
+            for packet in packets:
+                event = parse_usbmon_packet(*packet)
+                if event is not None:
+                    yield event
+            return
+
+    with open(path, 'r') as file_obj:
+        yield from read_usbmon_text(file_obj)
+
+
+def pair_transactions(events):
+    """
+    Pairs SET_REPORT submissions with the GET_REPORT completions answering them
+
+    The driver sends the request with SET_REPORT and then polls the answer with GET_REPORT,
+    a BUSY answer means the driver (or daemon) has to ask again. The answer carries the
+    same transaction id, command class and command id as the request.
+
+    :param events: Iterable of UsbEvent
+    :type events: iterable
+
+    :return: List of transactions and count of repeated commands per (device, command)
+    :rtype: tuple
+    """
+    transactions = []
+    pending = {}  # device -> Transaction waiting for its answer
+    submitted_get = {}  # (device, urb) -> True for GET_REPORT submissions
+    submitted_set = {}  # (device, urb) -> (timestamp, data) for SET_REPORT submissions
+    last_report = {}  # (device, command) -> (status, report) of the last transaction
+    retries = collections.Counter()
+
+    for event in events:
+        key = (event.device, event.urb)
+
+        if event.event == 'S' and event.setup is not None:
+            request_type, request = event.setup[0], event.setup[1]
+
+            if request_type == 0x21 and request == HID_REQ_SET_REPORT and len(event.data) >= 8:
+                submitted_set[key] = (event.timestamp, event.data)
+            elif request_type == 0xA1 and request == HID_REQ_GET_REPORT:
+                submitted_get[key] = True
+
+        elif event.event == 'C':
+            if key in submitted_set:
+                timestamp, report = submitted_set.pop(key)
+                transaction = Transaction(event.device, timestamp, report)
+
+                previous = last_report.get((event.device, transaction.command))
+                if previous is not None and previous[0] != 0x02 and previous[1] == report[:RAZER_USB_REPORT_LEN]:
+                    retries[(event.device, transaction.command)] += 1
+
+                if event.device in pending and pending[event.device].end is None:
+                    # Never got an answer for the previous one
+                    transactions.append(pending[event.device])
+                pending[event.device] = transaction
+
+            elif submitted_get.pop(key, None) and len(event.data) >= 8:
+                transaction = pending.get(event.device)
+                if transaction is None:
+                    continue
+
+                response = event.data
+                if (response[1], response[6], response[7]) != (transaction.transaction_id,) + transaction.command:
+                    continue
+
+                if response[0] == 0x01:
+                    transaction.busy_count += 1
+                    continue
+
+                transaction.end = event.timestamp
+                transaction.status = response[0]
+                transactions.append(transaction)
+                last_report[(event.device, transaction.command)] = (transaction.status, transaction.report[:RAZER_USB_REPORT_LEN])
+                del pending[event.device]
+
+    transactions.extend(transaction for transaction in pending.values())
+
+    return transactions, retries
+
+
+def histogram(latencies_us):
+    """
+    Bucket latencies
+
+    :param latencies_us: Latencies in microseconds
+    :type latencies_us: list
+
+    :return: List of (upper bound, count)
+    :rtype: list
+    """
+    counts = [0] * len(BUCKETS)
+    for latency in latencies_us:
+        for index, bound in enumerate(BUCKETS):
+            if latency <= bound:
+                counts[index] += 1
+                break
+    return list(zip(BUCKETS, counts))
+
+
+def percentile(values, fraction):
+    """
+    Nearest rank percentile
+
+    :param values: Values
+    :type values: list
+
+    :param fraction: Percentile between 0 and 1
+    :type fraction: float
+
+    :return: Value
+    """
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+
+def estimate_frame_rate(transactions):
+    """
+    Estimates the custom frame rate a device can reach
+
+    A frame is made of row writes followed by one effect command committing it, so the frame
+    time is the number of rows per frame times the median row latency plus the median commit
+    latency.
+
+    :param transactions: Transactions of a single device in capture order
+    :type transactions: list
+
+    :return: Tuple of rows per frame, achievable FPS, observed FPS or None if no frames were seen
+    :rtype: tuple or None
+    """
+    rows = []
+    commits = []
+    rows_per_frame = []
+    commit_times = []
+    row_count = 0
+
+    for transaction in transactions:
+        if transaction.latency is None:
+            continue
+
+        if transaction.command in CUSTOM_FRAME_ROWS:
+            rows.append(transaction.latency)
+            row_count += 1
+        elif transaction.command in CUSTOM_FRAME_COMMITS and row_count > 0:
+            commits.append(transaction.latency)
+            rows_per_frame.append(row_count)
+            commit_times.append(transaction.start)
+            row_count = 0
+
+    if not commits:
+        return None
+
+    row_count = statistics.median(rows_per_frame)
+    frame_time = row_count * statistics.median(rows) + statistics.median(commits)
+
+    observed = None
+    if len(commit_times) > 1 and commit_times[-1] > commit_times[0]:
+        observed = (len(commit_times) - 1) / (commit_times[-1] - commit_times[0])
+
+    return row_count, 1 / frame_time, observed
+
+
+def print_report(transactions, retries):
+    """
+    Prints the per device, per command statistics
+
+    :param transactions: Transactions
+    :type transactions: list
+
+    :param retries: Repeated commands per (device, command)
+    :type retries: collections.Counter
+    """
+    by_device = collections.defaultdict(list)
+    for transaction in sorted(transactions, key=lambda t: t.start):
+        by_device[transaction.device].append(transaction)
+
+    if not by_device:
+        print("No Razer transactions found")
+        return
+
+    for device, device_transactions in sorted(by_device.items()):
+        print("Device {0:03d}:{1:03d}".format(*device))
+        print("=" * 16)
+
+        by_command = collections.defaultdict(list)
+        for transaction in device_transactions:
+            by_command[transaction.command].append(transaction)
+
+        format_string = "{0:<7}  {1:>6}  {2:>9}  {3:>9}  {4:>9}  {5:>6}  {6:>6}  {7:>7}  {8}"
+        print(format_string.format('Command', 'Count', 'p50 us', 'p99 us', 'max us', 'BUSY', 'Retry', 'No resp', 'Status'))
+
+        for command, command_transactions in sorted(by_command.items()):
+            latencies = [t.latency * 1e6 for t in command_transactions if t.latency is not None]
+            busy = sum(t.busy_count for t in command_transactions)
+            unanswered = sum(1 for t in command_transactions if t.latency is None)
+            statuses = collections.Counter(STATUS_NAMES.get(t.status, hex(t.status)) for t in command_transactions if t.status is not None)
+
+            print(format_string.format(
+                '{0:02x}:{1:02x}'.format(*command),
+                len(command_transactions),
+                '{0:.0f}'.format(percentile(latencies, 0.5)) if latencies else '-',
+                '{0:.0f}'.format(percentile(latencies, 0.99)) if latencies else '-',
+                '{0:.0f}'.format(max(latencies)) if latencies else '-',
+                '{0:.1%}'.format(busy / (busy + len(command_transactions))),
+                '{0:.1%}'.format(retries[(device, command)] / len(command_transactions)),
+                unanswered,
+                ', '.join('{0}={1}'.format(name, count) for name, count in sorted(statuses.items()))))
+
+            if latencies:
+                peak = max(count for _, count in histogram(latencies))
+                for bound, count in histogram(latencies):
+                    if count == 0:
+                        continue
+                    label = '<= {0} us'.format(bound) if bound != math.inf else '>  {0} us'.format(BUCKETS[-2])
+                    print("         {0:<13} {1:>6}  {2}".format(label, count, '#' * max(1, int(40 * count / peak))))
+
+        frame_rate = estimate_frame_rate(device_transactions)
+        if frame_rate is not None:
+            rows, achievable, observed = frame_rate
+            print("")
+            print("Custom frames: {0:g} rows per frame, achievable {1:.1f} FPS".format(rows, achievable), end='')
+            if observed is not None:
+                print(", observed {0:.1f} FPS".format(observed), end='')
+            print("")
+        print("")
+
+
+def parse_args():
+    """
+    Parses command line arguments
+
+    :return: Argparse arguments object
+    """
+    parser = argparse.ArgumentParser(description="Measures Razer command latencies from usbmon captures")
+    parser.add_argument("file", metavar='FILE', type=str, nargs='?', help="pcap, pcapng or usbmon text file")
+    parser.add_argument("--live", metavar='BUS', type=int, help="Read the usbmon text interface of the given USB bus (0 for all)")
+    parser.add_argument("--duration", type=float, default=10.0, help="Seconds to capture with --live (default 10)")
+    parser.add_argument("--device", metavar='BUS:DEV', type=str, help="Only show the given device")
+
+    args = parser.parse_args()
+    if (args.file is None) == (args.live is None):
+        parser.error("Either FILE or --live is required")
+
+    return args
+
+
+def run():
+    """
+    Main function
+    """
+    args = parse_args()
+
+    if args.live is not None:
+        path = '/sys/kernel/debug/usb/usbmon/{0}u'.format(args.live)
+        try:
+            with open(path, 'r') as usbmon_file:
+                print("Capturing from {0} for {1:g} seconds".format(path, args.duration), file=sys.stderr)
+                transactions, retries = pair_transactions(read_usbmon_text(usbmon_file, args.duration))
+        except (FileNotFoundError, PermissionError) as err:
+            print("Cannot open {0}: {1}. Is debugfs mounted, usbmon loaded and are you root?".format(path, err), file=sys.stderr)
+            sys.exit(1)
+    else:
+        transactions, retries = pair_transactions(read_capture_file(args.file))
+
+    if args.device is not None:
+        bus, dev = (int(value) for value in args.device.split(':'))
+        transactions = [transaction for transaction in transactions if transaction.device == (bus, dev)]
+
+    print_report(transactions, retries)
+
+
+if __name__ == '__main__':
+    run()
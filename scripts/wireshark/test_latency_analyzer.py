@@ -0,0 +1,72 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import io
+import os
+import time
+import unittest
+
+import latency_analyzer
+
+# SET_REPORT of "get firmware version" (class 0x00, command 0x81) to bus 3 device 2 and its answer
+SET_REPORT_LINE = "ffff9a0c4b1c6900 1000000 S Co:3:002:0 s 21 09 0300 0002 005a 90 = 00ff0000 00020081 00000000 00000000\n"
+SET_REPORT_DONE_LINE = "ffff9a0c4b1c6900 1000200 C Co:3:002:0 0 90 >\n"
+GET_REPORT_LINE = "ffff9a0c4b1c6900 1001000 S Ci:3:002:0 s a1 01 0300 0002 005a 90 <\n"
+GET_REPORT_DONE_LINE = "ffff9a0c4b1c6900 1001800 C Ci:3:002:0 0 90 = 02ff0000 00020081 01020000 00000000\n"
+TRACE = SET_REPORT_LINE + SET_REPORT_DONE_LINE + GET_REPORT_LINE + GET_REPORT_DONE_LINE
+
+
+class LatencyAnalyzerTest(unittest.TestCase):
+    def test_parse_usbmon_text_line(self):
+        event = latency_analyzer.parse_usbmon_text_line(SET_REPORT_LINE)
+
+        self.assertEqual(event.event, 'S')
+        self.assertEqual(event.device, (3, 2))
+        self.assertFalse(event.is_in)
+        self.assertEqual(event.setup, bytes((0x21, 0x09, 0x00, 0x03, 0x02, 0x00, 0x5a, 0x00)))
+        self.assertEqual(event.data[:8], bytes.fromhex('00ff000000020081'))
+
+    def test_parse_usbmon_text_line_ignores_other_transfers(self):
+        self.assertIsNone(latency_analyzer.parse_usbmon_text_line("ffff9a0c4b1c6900 1000000 S Ii:3:002:1 -115:8 8 <\n"))
+        self.assertIsNone(latency_analyzer.parse_usbmon_text_line("garbage\n"))
+
+    def test_read_usbmon_text_until_eof(self):
+        events = list(latency_analyzer.read_usbmon_text(io.StringIO(TRACE)))
+
+        self.assertEqual(len(events), 4)
+
+    def test_read_usbmon_text_with_duration_until_eof(self):
+        read_fd, write_fd = os.pipe()
+        os.write(write_fd, TRACE.rstrip('\n').encode())
+        os.close(write_fd)
+
+        with os.fdopen(read_fd, 'r') as file_obj:
+            events = list(latency_analyzer.read_usbmon_text(file_obj, 5))
+
+        self.assertEqual(len(events), 4)
+
+    def test_read_usbmon_text_stops_on_idle_bus(self):
+        read_fd, write_fd = os.pipe()
+        os.write(write_fd, TRACE.encode())
+
+        try:
+            with os.fdopen(read_fd, 'r') as file_obj:
+                start = time.monotonic()
+                events = list(latency_analyzer.read_usbmon_text(file_obj, 0.2))
+                elapsed = time.monotonic() - start
+        finally:
+            os.close(write_fd)
+
+        self.assertEqual(len(events), 4)
+        self.assertLess(elapsed, 2)
+
+    def test_pair_transactions(self):
+        transactions, retries = latency_analyzer.pair_transactions(latency_analyzer.read_usbmon_text(io.StringIO(TRACE)))
+
+        self.assertEqual(len(transactions), 1)
+        self.assertEqual(transactions[0].device, (3, 2))
+        self.assertEqual(transactions[0].command, (0x00, 0x81))
+        self.assertEqual(retries, {})
+
+
+if __name__ == '__main__':
+    unittest.main()